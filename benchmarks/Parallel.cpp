@@ -0,0 +1,62 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Support/Parallel.h"
+
+#include <vector>
+
+#if LLVM_ENABLE_THREADS
+using namespace llvm::parallel::detail;
+
+static void update(uint64_t &X) { X = X * 6364136223846793005ULL + 1; }
+
+// Spawns one task per element from the calling thread, like
+// parallel_for_each does for ranges of up to 1024 elements.
+static void BM_ParallelFlatSpawn(benchmark::State &State, ExecutorKind Kind) {
+  std::vector<uint64_t> Data(State.range(0));
+  for (auto _ : State) {
+    TaskGroup TG(Kind);
+    for (uint64_t &X : Data)
+      TG.spawn([&X] { update(X); });
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+
+// Halves the range recursively and spawns one half, like parallel_sort does,
+// so most tasks are spawned by the workers.
+static void splitRange(TaskGroup &TG, uint64_t *Begin, uint64_t *End) {
+  while (End - Begin > 16) {
+    uint64_t *Mid = Begin + (End - Begin) / 2;
+    TG.spawn([=, &TG] { splitRange(TG, Mid, End); });
+    End = Mid;
+  }
+  for (; Begin != End; ++Begin)
+    update(*Begin);
+}
+
+static void BM_ParallelNestedSpawn(benchmark::State &State,
+                                   ExecutorKind Kind) {
+  std::vector<uint64_t> Data(State.range(0));
+  for (auto _ : State) {
+    TaskGroup TG(Kind);
+    TG.spawn([&] { splitRange(TG, Data.data(), Data.data() + Data.size()); });
+  }
+  State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_ParallelFlatSpawn, SharedStack, ExecutorKind::SharedStack)
+    ->Range(1 << 6, 1 << 14)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ParallelFlatSpawn, WorkStealing,
+                  ExecutorKind::WorkStealing)
+    ->Range(1 << 6, 1 << 14)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ParallelNestedSpawn, SharedStack,
+                  ExecutorKind::SharedStack)
+    ->Range(1 << 10, 1 << 18)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_ParallelNestedSpawn, WorkStealing,
+                  ExecutorKind::WorkStealing)
+    ->Range(1 << 10, 1 << 18)
+    ->UseRealTime();
+#endif
+
+BENCHMARK_MAIN();
@@ -262,6 +262,11 @@ public:
 
   bool isLegalMaskedGather(Type *DataType) { return false; }
 
+  // By default, don't restrict vectorization of nontemporal accesses.
+  bool isLegalNTStore(Type *DataType, unsigned Alignment) { return true; }
+
+  bool isLegalNTLoad(Type *DataType, unsigned Alignment) { return true; }
+
   bool hasDivRemOp(Type *DataType, bool IsSigned) { return false; }
 
   bool hasVolatileVariant(Instruction *I, unsigned AddrSpace) { return false; }
@@ -80,7 +80,8 @@ class Module;
     Expected<std::unique_ptr<Module>> getModuleImpl(LLVMContext &Context,
                                                     bool MaterializeAll,
                                                     bool ShouldLazyLoadMetadata,
-                                                    bool IsImporting);
+                                                    bool IsImporting,
+                                                    bool LoadMetadataOnDemand);
 
   public:
     StringRef getBuffer() const {
@@ -94,10 +95,13 @@ class Module;
     /// Read the bitcode module and prepare for lazy deserialization of function
     /// bodies. If ShouldLazyLoadMetadata is true, lazily load metadata as well.
     /// If IsImporting is true, this module is being parsed for ThinLTO
-    /// importing into another module.
-    Expected<std::unique_ptr<Module>> getLazyModule(LLVMContext &Context,
-                                                    bool ShouldLazyLoadMetadata,
-                                                    bool IsImporting);
+    /// importing into another module. If LoadMetadataOnDemand is true, the
+    /// module-level metadata is loaded as it is referenced, like for
+    /// importing, so that the debug info of functions which are never
+    /// materialized is not read.
+    Expected<std::unique_ptr<Module>>
+    getLazyModule(LLVMContext &Context, bool ShouldLazyLoadMetadata,
+                  bool IsImporting, bool LoadMetadataOnDemand = false);
 
     /// Read the entire bitcode module and return it.
     Expected<std::unique_ptr<Module>> parseModule(LLVMContext &Context);
@@ -134,11 +138,14 @@ class Module;
   /// Read the header of the specified bitcode buffer and prepare for lazy
   /// deserialization of function bodies. If ShouldLazyLoadMetadata is true,
   /// lazily load metadata as well. If IsImporting is true, this module is
-  /// being parsed for ThinLTO importing into another module.
+  /// being parsed for ThinLTO importing into another module. If
+  /// LoadMetadataOnDemand is true, module-level metadata is only loaded as it
+  /// is referenced.
   Expected<std::unique_ptr<Module>>
   getLazyBitcodeModule(MemoryBufferRef Buffer, LLVMContext &Context,
                        bool ShouldLazyLoadMetadata = false,
-                       bool IsImporting = false);
+                       bool IsImporting = false,
+                       bool LoadMetadataOnDemand = false);
 
   /// Like getLazyBitcodeModule, except that the module takes ownership of
   /// the memory buffer if successful. If successful, this moves Buffer. On
@@ -146,7 +153,8 @@ class Module;
   /// being parsed for ThinLTO importing into another module.
   Expected<std::unique_ptr<Module>> getOwningLazyBitcodeModule(
       std::unique_ptr<MemoryBuffer> &&Buffer, LLVMContext &Context,
-      bool ShouldLazyLoadMetadata = false, bool IsImporting = false);
+      bool ShouldLazyLoadMetadata = false, bool IsImporting = false,
+      bool LoadMetadataOnDemand = false);
 
   /// Read the header of the specified bitcode buffer and extract just the
   /// triple information. If successful, this returns a string. On error, this
@@ -617,6 +617,8 @@ public:
   const TypeIdInfo *getTypeIdInfo() const { return TIdInfo.get(); };
 
   friend struct GraphTraits<ValueInfo>;
+
+  friend class ModuleSummaryIndex;
 };
 
 template <> struct DenseMapInfo<FunctionSummary::VFuncId> {
@@ -1129,6 +1131,13 @@ public:
     return nullptr;
   }
 
+  /// Move the modules, summaries and type ids of \p Other into this index,
+  /// as if the modules of \p Other had been read into this index in the
+  /// first place. Both indexes must be without GlobalValues. This allows
+  /// reading the summaries of several modules in parallel and combining
+  /// them in a deterministic order.
+  void mergeFrom(ModuleSummaryIndex &&Other);
+
   /// Collect for the given module the list of functions it defines
   /// (GUID -> Summary).
   void collectDefinedFunctionsForModule(StringRef ModulePath,
@@ -29,11 +29,13 @@ class LLVMContext;
 /// If the given file holds a bitcode image, return a Module
 /// for it which does lazy deserialization of function bodies.  Otherwise,
 /// attempt to parse it as LLVM Assembly and return a fully populated
-/// Module. The ShouldLazyLoadMetadata flag is passed down to the bitcode
-/// reader to optionally enable lazy metadata loading.
+/// Module. The ShouldLazyLoadMetadata and LoadMetadataOnDemand flags are
+/// passed down to the bitcode reader to optionally enable lazy metadata
+/// loading.
 std::unique_ptr<Module>
 getLazyIRFileModule(StringRef Filename, SMDiagnostic &Err, LLVMContext &Context,
-                    bool ShouldLazyLoadMetadata = false);
+                    bool ShouldLazyLoadMetadata = false,
+                    bool LoadMetadataOnDemand = false);
 
 /// If the given MemoryBuffer holds a bitcode image, return a Module
 /// for it.  Otherwise, attempt to parse it as LLVM Assembly and return
@@ -16,9 +16,14 @@
 #define LLVM_LTO_CACHING_H
 
 #include "llvm/LTO/LTO.h"
+#include "llvm/Support/CachePruning.h"
 #include <string>
 
 namespace llvm {
+namespace compression {
+class Codec;
+}
+
 namespace lto {
 
 /// This type defines the callback to add a pre-existing native object file
@@ -31,8 +36,17 @@ typedef std::function<void(unsigned Task, std::unique_ptr<MemoryBuffer> MB)>
 /// Create a local file system cache which uses the given cache directory and
 /// file callback. This function also creates the cache directory if it does not
 /// already exist.
-Expected<NativeObjectCache> localCache(StringRef CacheDirectoryPath,
-                                       AddBufferFn AddBuffer);
+///
+/// If \p Indexed is true, the cache uses the indexed layout described at
+/// getIndexedCacheEntryPath(), which pruneCache() can prune without scanning
+/// the directory. Hits and misses are counted in \p Stats if it is not null.
+///
+/// If \p Compressor is not null, new entries are stored compressed with it.
+/// Entries are uncompressed as they are read, whichever codec wrote them.
+Expected<NativeObjectCache>
+localCache(StringRef CacheDirectoryPath, AddBufferFn AddBuffer,
+           CacheStats *Stats = nullptr, bool Indexed = false,
+           const compression::Codec *Compressor = nullptr);
 
 } // namespace lto
 } // namespace llvm
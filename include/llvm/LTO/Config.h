@@ -56,6 +56,19 @@ struct Config {
   /// Disable entirely the optimizer, including importing for ThinLTO
   bool CodeGenOnly = false;
 
+  /// If this field is set, the partitions of a regular LTO module which is
+  /// split for parallel code generation are balanced by instruction count
+  /// while keeping as many references as possible within a partition.
+  bool BalancePartitions = false;
+
+  /// If this field is set and the regular LTO module is split for parallel
+  /// code generation, the function simplification passes which follow the
+  /// inliner run on each partition in parallel, instead of on the whole
+  /// module. These passes then see the local symbols of the module as hidden
+  /// externals, and the PostOptModuleHook sees the module before them. Only
+  /// applies to the default pipeline of the old pass manager.
+  bool SplitFunctionPasses = false;
+
   /// If this field is set, the set of passes run in the middle-end optimizer
   /// will be the one specified by the string. Only works with the new pass
   /// manager as the old one doesn't have this ability.
@@ -88,6 +101,11 @@ struct Config {
   /// all .dwo files will be written to the same path.
   std::string DwoPath;
 
+  /// If this field is set, the import and export lists of the thin link are
+  /// stored in this file. The next link reuses the lists of the modules whose
+  /// summaries, and the summaries they import from, didn't change.
+  std::string ThinLinkCacheFile;
+
   /// Optimization remarks file path.
   std::string RemarksFilename = "";
 
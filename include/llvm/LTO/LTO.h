@@ -56,6 +56,7 @@ void thinLTOResolvePrevailingInIndex(
 /// Update the linkages in the given \p Index to mark exported values
 /// as external and non-exported values as internal. The ThinLTO backends
 /// must apply the changes to the Module via thinLTOInternalizeModule.
+/// \p isExported is called concurrently from several threads.
 void thinLTOInternalizeAndPromoteInIndex(
     ModuleSummaryIndex &Index,
     function_ref<bool(StringRef, GlobalValue::GUID)> isExported);
@@ -210,8 +211,13 @@ typedef std::function<std::unique_ptr<ThinBackendProc>(
     AddStreamFn AddStream, NativeObjectCache Cache)>
     ThinBackend;
 
-/// This ThinBackend runs the individual backend jobs in-process.
-ThinBackend createInProcessThinBackend(unsigned ParallelismLevel);
+/// This ThinBackend runs the individual backend jobs in-process, starting
+/// with the ones with the most instructions to compile according to the
+/// combined summary. If \p MemoryBudget is not zero, fewer than
+/// \p ParallelismLevel jobs run at the same time when the sum of their
+/// estimated memory footprints would exceed \p MemoryBudget bytes.
+ThinBackend createInProcessThinBackend(unsigned ParallelismLevel,
+                                       uint64_t MemoryBudget = 0);
 
 /// This ThinBackend writes individual module indexes to files, instead of
 /// running the individual backend jobs. This backend is for distributed builds
@@ -318,6 +324,27 @@ private:
     ModuleSummaryIndex CombinedIndex;
     MapVector<StringRef, BitcodeModule> ModuleMap;
     DenseMap<GlobalValue::GUID, StringRef> PrevailingModuleForGUID;
+
+    // The summaries of the modules added to the link are read into the
+    // combined index at the start of run(). They are read in parallel into
+    // an index per module, which are merged in the order the modules were
+    // added, so that the combined index is the same as if the summaries were
+    // read one after the other.
+    struct PendingSummary {
+      // The module path and ID of the module in the combined index. Regular
+      // LTO modules are added to a dummy module with an empty path.
+      std::string ModulePath;
+      uint64_t ModuleId;
+      // The symbols whose summary needs to be updated with their resolution
+      // once read.
+      struct Update {
+        GlobalValue::GUID GUID;
+        bool LinkerRedefined;
+        bool FinalDefinitionInLinkageUnit;
+      };
+      std::vector<Update> Updates;
+    };
+    std::vector<std::pair<BitcodeModule, PendingSummary>> PendingSummaries;
   } ThinLTO;
 
   // The global resolution for a particular (mangled) symbol name. This is in
@@ -396,6 +423,8 @@ private:
   Error addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
                    const SymbolResolution *&ResI, const SymbolResolution *ResE);
 
+  Error readPendingSummaries();
+
   Error runRegularLTO(AddStreamFn AddStream);
   Error runThinLTO(AddStreamFn AddStream, NativeObjectCache Cache);
 
@@ -16,11 +16,13 @@
 #define LLVM_SUPPORT_CACHE_PRUNING_H
 
 #include "llvm/ADT/StringRef.h"
+#include <atomic>
 #include <chrono>
 
 namespace llvm {
 
 template <typename T> class Expected;
+class raw_ostream;
 
 /// Policy for the pruneCache() function. A default constructed
 /// CachePruningPolicy provides a reasonable default policy.
@@ -67,13 +69,48 @@ struct CachePruningPolicy {
 /// and maximum cache size of 50% of available disk space.
 Expected<CachePruningPolicy> parseCachePruningPolicy(StringRef PolicyStr);
 
+/// Statistics of the use of a cache directory by one process, collected by
+/// the cache itself (see lto::localCache()) and by pruneCache().
+struct CacheStats {
+  std::atomic<uint64_t> Hits{0};
+  std::atomic<uint64_t> Misses{0};
+  /// The size of the cached files which were used instead of being rebuilt.
+  std::atomic<uint64_t> BytesSaved{0};
+  uint64_t Evictions = 0;
+  uint64_t BytesEvicted = 0;
+
+  void print(raw_ostream &OS) const;
+};
+
 /// Peform pruning using the supplied policy, returns true if pruning
-/// occurred, i.e. if Policy.Interval was expired.
+/// occurred, i.e. if Policy.Interval was expired. Evicted files are counted in
+/// \p Stats if it is not null.
+///
+/// If the directory holds an indexed cache (see getIndexedCacheEntryPath()),
+/// the files are pruned based on the index instead of scanning the directory.
 ///
 /// As a safeguard against data loss if the user specifies the wrong directory
 /// as their cache directory, this function will ignore files not matching the
 /// pattern "llvmcache-*".
-bool pruneCache(StringRef Path, CachePruningPolicy Policy);
+bool pruneCache(StringRef Path, CachePruningPolicy Policy,
+                CacheStats *Stats = nullptr);
+
+/// Returns the path of the entry for \p Key in the indexed cache directory
+/// \p Path.
+///
+/// An indexed cache spreads its "llvmcache-<key>" files over subdirectories
+/// named after the first two characters of the key, so that no directory gets
+/// too large. The file "llvmcache.index" lists all entries with their size and
+/// time of last use, and the cache appends the entries it adds or uses to the
+/// file "llvmcache.journal". pruneCache() folds the journal into the index and
+/// evicts the least recently used entries without scanning the directories.
+/// Pruners lock the index, and once a day one of them scans the directories
+/// for entries missing from the index.
+std::string getIndexedCacheEntryPath(StringRef Path, StringRef Key);
+
+/// Records in the journal of the indexed cache directory \p Path that the
+/// entry for \p Key, of \p Size bytes, was added or used just now.
+void recordIndexedCacheEntry(StringRef Path, StringRef Key, uint64_t Size);
 
 } // namespace llvm
 
@@ -44,6 +44,65 @@ uint32_t crc32(StringRef Buffer);
 
 }  // End of namespace zlib
 
+namespace lz4 {
+
+/// A fast codec producing the LZ4 block format. It is built into LLVM, so it
+/// is always available.
+///
+/// It compresses several times faster than zlib at its fastest level, at the
+/// cost of a lower compression ratio, which suits data written on the
+/// critical path of a build.
+Error compress(StringRef InputBuffer, SmallVectorImpl<char> &CompressedBuffer);
+
+Error uncompress(StringRef InputBuffer, char *UncompressedBuffer,
+                 size_t &UncompressedSize);
+
+Error uncompress(StringRef InputBuffer,
+                 SmallVectorImpl<char> &UncompressedBuffer,
+                 size_t UncompressedSize);
+
+}  // End of namespace lz4
+
+namespace compression {
+
+enum class Format : uint8_t {
+  Zlib = 1,
+  LZ4 = 2,
+};
+
+/// A compression algorithm. Like the zlib and lz4 functions, codecs don't
+/// store the size of the uncompressed data; the user has to record it along
+/// with the compressed data.
+class Codec {
+public:
+  virtual ~Codec();
+
+  virtual Format getFormat() const = 0;
+  virtual StringRef getName() const = 0;
+  virtual bool isAvailable() const = 0;
+
+  virtual Error compress(StringRef InputBuffer,
+                         SmallVectorImpl<char> &CompressedBuffer) const = 0;
+
+  /// Uncompress InputBuffer into the UncompressedSize bytes at
+  /// UncompressedBuffer, and set UncompressedSize to the number of bytes
+  /// produced.
+  virtual Error uncompress(StringRef InputBuffer, char *UncompressedBuffer,
+                           size_t &UncompressedSize) const = 0;
+
+  Error uncompress(StringRef InputBuffer,
+                   SmallVectorImpl<char> &UncompressedBuffer,
+                   size_t UncompressedSize) const;
+};
+
+/// Returns the built-in codec for F.
+const Codec &getCodec(Format F);
+
+/// Returns the codec named Name ("zlib" or "lz4"), or null if there is none.
+const Codec *getCodec(StringRef Name);
+
+}  // End of namespace compression
+
 } // End of namespace llvm
 
 #endif
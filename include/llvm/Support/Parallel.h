@@ -72,10 +72,18 @@ public:
   }
 };
 
+/// The executors a TaskGroup can run its tasks on.  Default is ConcRT on
+/// Windows and WorkStealing elsewhere.  SharedStack is the thread pool with a
+/// single task stack that WorkStealing replaced, kept for comparison.
+enum class ExecutorKind { Default, WorkStealing, SharedStack };
+
 class TaskGroup {
   Latch L;
+  ExecutorKind Kind;
 
 public:
+  explicit TaskGroup(ExecutorKind Kind = ExecutorKind::Default) : Kind(Kind) {}
+
   void spawn(std::function<void()> f);
 
   void sync() const { L.sync(); }
@@ -24,21 +24,37 @@
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
+class ThreadPoolTaskGroup;
+
 /// A ThreadPool for asynchronous parallel execution on a defined number of
 /// threads.
 ///
 /// The pool keeps a vector of threads alive, waiting on a condition variable
-/// for some work to become available.
+/// for some work to become available.  Tasks can be given a priority, can
+/// depend on other tasks of the pool, and can be collected in a
+/// ThreadPoolTaskGroup to wait for only some of the tasks.
 class ThreadPool {
 public:
   using TaskTy = std::function<void()>;
   using PackagedTaskTy = std::packaged_task<void()>;
 
+  /// Scheduling options for a task submitted with asyncWithOptions().
+  struct TaskOptions {
+    /// The group the task belongs to, if any.
+    ThreadPoolTaskGroup *Group = nullptr;
+    /// Ready tasks with a higher priority are started first.  Tasks of equal
+    /// priority are started in submission order.
+    int Priority = 0;
+    /// The task is not started before all of these have finished.  They must
+    /// be futures returned by this pool.
+    std::vector<std::shared_future<void>> DependsOn;
+  };
+
   /// Construct a pool with the number of threads found by
   /// hardware_concurrency().
   ThreadPool();
@@ -55,37 +71,83 @@ public:
   inline std::shared_future<void> async(Function &&F, Args &&... ArgList) {
     auto Task =
         std::bind(std::forward<Function>(F), std::forward<Args>(ArgList)...);
-    return asyncImpl(std::move(Task));
+    return asyncImpl(std::move(Task), TaskOptions());
   }
 
   /// Asynchronous submission of a task to the pool. The returned future can be
   /// used to wait for the task to finish and is *non-blocking* on destruction.
   template <typename Function>
   inline std::shared_future<void> async(Function &&F) {
-    return asyncImpl(std::forward<Function>(F));
+    return asyncImpl(std::forward<Function>(F), TaskOptions());
+  }
+
+  /// Asynchronous submission of a task to the pool with the scheduling
+  /// options \p Opts. The returned future can be used to wait for the task to
+  /// finish, or be passed as a dependency of later tasks.
+  template <typename Function>
+  inline std::shared_future<void> asyncWithOptions(TaskOptions Opts,
+                                                   Function &&F) {
+    return asyncImpl(std::forward<Function>(F), std::move(Opts));
   }
 
   /// Blocking wait for all the threads to complete and the queue to be empty.
   /// It is an error to try to add new tasks while blocking on this call.
   void wait();
 
+  /// Blocking wait for all the tasks of \p Group to complete. Other tasks may
+  /// still be queued or running when this returns. It must not be called from
+  /// a task of this pool.
+  void wait(ThreadPoolTaskGroup &Group);
+
 private:
+  /// A task with its scheduling options.
+  struct QueuedTask {
+    PackagedTaskTy Task;
+    ThreadPoolTaskGroup *Group = nullptr;
+    int Priority = 0;
+    /// The submission number, to run tasks of equal priority in FIFO order.
+    uint64_t Seq = 0;
+
+    /// Orders the heap of ready tasks: the top has the highest priority and
+    /// was submitted first among those.
+    bool operator<(const QueuedTask &RHS) const {
+      if (Priority != RHS.Priority)
+        return Priority < RHS.Priority;
+      return Seq > RHS.Seq;
+    }
+  };
+
   /// Asynchronous submission of a task to the pool. The returned future can be
   /// used to wait for the task to finish and is *non-blocking* on destruction.
-  std::shared_future<void> asyncImpl(TaskTy F);
+  std::shared_future<void> asyncImpl(TaskTy F, TaskOptions Opts);
+
+  /// Push \p Task to the heap of ready tasks, or pop the next one to run.
+  void pushReadyTask(QueuedTask Task);
+  QueuedTask popReadyTask();
+
+  /// Move the blocked tasks whose dependencies have finished to the ready
+  /// tasks, and return how many were moved.
+  unsigned releaseBlockedTasks();
 
   /// Threads in flight
   std::vector<llvm::thread> Threads;
 
-  /// Tasks waiting for execution in the pool.
-  std::queue<PackagedTaskTy> Tasks;
+  /// Tasks ready for execution, as a heap ordered by priority and then by
+  /// submission order.
+  std::vector<QueuedTask> ReadyTasks;
+
+  /// Tasks waiting for their dependencies to finish.
+  std::vector<std::pair<QueuedTask, std::vector<std::shared_future<void>>>>
+      BlockedTasks;
 
-  /// Locking and signaling for accessing the Tasks queue.
+  /// The number of tasks submitted so far.
+  uint64_t NumSubmitted = 0;
+
+  /// Locking and signaling for accessing the task queues.
   std::mutex QueueLock;
   std::condition_variable QueueCondition;
 
-  /// Locking and signaling for job completion
-  std::mutex CompletionLock;
+  /// Signaling for job completion, using QueueLock.
   std::condition_variable CompletionCondition;
 
   /// Keep track of the number of thread actually busy
@@ -96,6 +158,40 @@ private:
   bool EnableFlag;
 #endif
 };
+
+/// A group of tasks of a ThreadPool which can be waited for independently of
+/// the other tasks of the pool.
+class ThreadPoolTaskGroup {
+public:
+  explicit ThreadPoolTaskGroup(ThreadPool &Pool) : Pool(Pool) {}
+
+  /// Blocking destructor: waits for all the tasks of the group to complete.
+  ~ThreadPoolTaskGroup() { wait(); }
+
+  /// Asynchronous submission of a task of this group to the pool.
+  template <typename Function, typename... Args>
+  inline std::shared_future<void> async(Function &&F, Args &&... ArgList) {
+    ThreadPool::TaskOptions Opts;
+    Opts.Group = this;
+    return Pool.asyncWithOptions(
+        std::move(Opts),
+        std::bind(std::forward<Function>(F), std::forward<Args>(ArgList)...));
+  }
+
+  /// Blocking wait for all the tasks of the group to complete.
+  void wait() { Pool.wait(*this); }
+
+  ThreadPool &getPool() const { return Pool; }
+
+private:
+  friend class ThreadPool;
+
+  ThreadPool &Pool;
+
+  /// The number of queued, blocked and running tasks of the group, guarded
+  /// by the QueueLock of the pool.
+  unsigned NumTasks = 0;
+};
 }
 
 #endif // LLVM_SUPPORT_THREAD_POOL_H
@@ -24,6 +24,7 @@
 #include <system_error>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
@@ -126,6 +127,47 @@ public:
   PreservedAnalyses run(Module &M, ModuleAnalysisManager &AM);
 };
 
+/// The import and export lists computed by a previous thin link.
+///
+/// The import list of a module only depends on the summaries of the module
+/// itself and of the GUIDs its import computation consulted: the callees and
+/// references of its functions and of the functions it imports. For every
+/// module the cache records those GUIDs, together with a hash of the
+/// summaries of every module defining one of them. A later link reuses the
+/// lists of a module as long as none of these modules changed and no changed
+/// module defines one of the consulted GUIDs.
+struct ThinLinkImportCache {
+  struct ModuleEntry {
+    /// The modules the import computation read summaries from, and the hash
+    /// of their summaries.
+    std::vector<std::pair<std::string, uint64_t>> Dependencies;
+    /// The sorted GUIDs whose summaries were consulted.
+    std::vector<GlobalValue::GUID> Consulted;
+    /// Callees without a summary, and the GUID they were mapped to through
+    /// their original name (see ModuleSummaryIndex::getGUIDFromOriginalID).
+    std::vector<std::pair<GlobalValue::GUID, GlobalValue::GUID>> OriginalIDs;
+    FunctionImporter::ImportMapTy ImportList;
+    /// The exports this module's imports added to other modules.
+    StringMap<FunctionImporter::ExportSetTy> ExportLists;
+  };
+
+  /// Hash of the import options and index flags the lists were computed with.
+  uint64_t OptionsHash = 0;
+  /// Hash of the summaries of every module of the link.
+  StringMap<uint64_t> ModuleHashes;
+  StringMap<ModuleEntry> Modules;
+  /// The number of modules whose lists the last ComputeCrossModuleImport
+  /// reused.
+  unsigned NumReused = 0;
+
+  /// Read a cache written by save(). A missing or malformed file results in
+  /// an empty cache.
+  static ThinLinkImportCache load(StringRef Path);
+
+  /// Write the cache to \p Path, replacing an existing file atomically.
+  Error save(StringRef Path) const;
+};
+
 /// Compute all the imports and exports for every module in the Index.
 ///
 /// \p ModuleToDefinedGVSummaries contains for each Module a map
@@ -138,11 +180,15 @@ public:
 /// \p ExportLists contains for each Module the set of globals (GUID) that will
 /// be imported by another module, or referenced by such a function. I.e. this
 /// is the set of globals that need to be promoted/renamed appropriately.
+///
+/// If \p Cache is given, modules whose inputs are unchanged reuse the lists
+/// recorded in it, and \p Cache is updated to describe the current link.
 void ComputeCrossModuleImport(
     const ModuleSummaryIndex &Index,
     const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
     StringMap<FunctionImporter::ImportMapTy> &ImportLists,
-    StringMap<FunctionImporter::ExportSetTy> &ExportLists);
+    StringMap<FunctionImporter::ExportSetTy> &ExportLists,
+    ThinLinkImportCache *Cache = nullptr);
 
 /// Compute all the imports for the given module using the Index.
 ///
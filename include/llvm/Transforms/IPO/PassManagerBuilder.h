@@ -185,7 +185,9 @@ private:
                          legacy::PassManagerBase &PM) const;
   void addInitialAliasAnalysisPasses(legacy::PassManagerBase &PM) const;
   void addLTOOptimizationPasses(legacy::PassManagerBase &PM);
+  void addLTOFunctionOptimizationPasses(legacy::PassManagerBase &PM);
   void addLateLTOOptimizationPasses(legacy::PassManagerBase &PM);
+  void addLTOPasses(legacy::PassManagerBase &PM, bool RunFunctionPasses);
   void addPGOInstrPasses(legacy::PassManagerBase &MPM);
   void addFunctionSimplificationPasses(legacy::PassManagerBase &MPM);
   void addInstructionCombiningPass(legacy::PassManagerBase &MPM) const;
@@ -199,6 +201,14 @@ public:
   /// populateModulePassManager - This sets up the primary pass manager.
   void populateModulePassManager(legacy::PassManagerBase &MPM);
   void populateLTOPassManager(legacy::PassManagerBase &PM);
+
+  /// populateLTOModulePassManager - This sets up the LTO pipeline like
+  /// populateLTOPassManager, except for the function simplification passes
+  /// which follow the inliner.  These are run on each partition of the
+  /// optimized module with populateLTOPartitionPassManager instead, which
+  /// allows optimizing the partitions in parallel.
+  void populateLTOModulePassManager(legacy::PassManagerBase &PM);
+  void populateLTOPartitionPassManager(legacy::PassManagerBase &PM);
   void populateThinLTOPassManager(legacy::PassManagerBase &PM);
 };
 
@@ -26,6 +26,11 @@ class Module;
 /// Splits the module M into N linkable partitions. The function ModuleCallback
 /// is called N times passing each individual partition as the MPart argument.
 ///
+/// If BalanceBySize is set, the partitions are balanced by the number of
+/// instructions they contain while keeping as many references as possible
+/// within a partition. Otherwise, globals which need not stay together are
+/// assigned by the hash of their name.
+///
 /// FIXME: This function does not deal with the somewhat subtle symbol
 /// visibility issues around module splitting, including (but not limited to):
 ///
@@ -36,7 +41,7 @@ class Module;
 void SplitModule(
     std::unique_ptr<Module> M, unsigned N,
     function_ref<void(std::unique_ptr<Module> MPart)> ModuleCallback,
-    bool PreserveLocals = false);
+    bool PreserveLocals = false, bool BalanceBySize = false);
 
 } // end namespace llvm
 
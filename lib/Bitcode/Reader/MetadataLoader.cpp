@@ -100,7 +100,7 @@ static cl::opt<bool> ImportFullTypeDefinitions(
 static cl::opt<bool> DisableLazyLoading(
     "disable-ondemand-mds-loading", cl::init(false), cl::Hidden,
     cl::desc("Force disable the lazy-loading on-demand of metadata when "
-             "loading bitcode for importing."));
+             "loading bitcode for importing or linking."));
 
 namespace {
 
@@ -459,6 +459,10 @@ class MetadataLoader::MetadataLoaderImpl {
   /// True if metadata is being parsed for a module being ThinLTO imported.
   bool IsImporting = false;
 
+  /// True if module-level metadata is loaded on demand, as for importing,
+  /// but with complete type definitions.
+  bool LoadOnDemand = false;
+
   Error parseOneMetadata(SmallVectorImpl<uint64_t> &Record, unsigned Code,
                          PlaceholderQueue &Placeholders, StringRef Blob,
                          unsigned &NextMetadataNo);
@@ -625,10 +629,11 @@ public:
   MetadataLoaderImpl(BitstreamCursor &Stream, Module &TheModule,
                      BitcodeReaderValueList &ValueList,
                      std::function<Type *(unsigned)> getTypeByID,
-                     bool IsImporting)
+                     bool IsImporting, bool LoadOnDemand)
       : MetadataList(TheModule.getContext()), ValueList(ValueList),
         Stream(Stream), Context(TheModule.getContext()), TheModule(TheModule),
-        getTypeByID(std::move(getTypeByID)), IsImporting(IsImporting) {}
+        getTypeByID(std::move(getTypeByID)), IsImporting(IsImporting),
+        LoadOnDemand(LoadOnDemand) {}
 
   Error parseMetadata(bool ModuleLevel);
 
@@ -853,7 +858,7 @@ Error MetadataLoader::MetadataLoaderImpl::parseMetadata(bool ModuleLevel) {
 
   // We lazy-load module-level metadata: we build an index for each record, and
   // then load individual record as needed, starting with the named metadata.
-  if (ModuleLevel && IsImporting && MetadataList.empty() &&
+  if (ModuleLevel && (IsImporting || LoadOnDemand) && MetadataList.empty() &&
       !DisableLazyLoading) {
     auto SuccessOrErr = lazyLoadModuleMetadataBlock();
     if (!SuccessOrErr)
@@ -2004,10 +2009,11 @@ MetadataLoader::MetadataLoader(MetadataLoader &&RHS)
 MetadataLoader::~MetadataLoader() = default;
 MetadataLoader::MetadataLoader(BitstreamCursor &Stream, Module &TheModule,
                                BitcodeReaderValueList &ValueList,
-                               bool IsImporting,
+                               bool IsImporting, bool LoadOnDemand,
                                std::function<Type *(unsigned)> getTypeByID)
-    : Pimpl(llvm::make_unique<MetadataLoaderImpl>(
-          Stream, TheModule, ValueList, std::move(getTypeByID), IsImporting)) {}
+    : Pimpl(llvm::make_unique<MetadataLoaderImpl>(Stream, TheModule, ValueList,
+                                                  std::move(getTypeByID),
+                                                  IsImporting, LoadOnDemand)) {}
 
 Error MetadataLoader::parseMetadata(bool ModuleLevel) {
   return Pimpl->parseMetadata(ModuleLevel);
@@ -458,13 +458,16 @@ bool BranchRelaxation::fixupUnconditionalBranch(MachineInstr &MI) {
   if (!MBB->empty()) {
     BranchBB = createNewBlockAfter(*MBB);
 
-    // Add live outs.
-    for (const MachineBasicBlock *Succ : MBB->successors()) {
-      for (const MachineBasicBlock::RegisterMaskPair &LiveIn : Succ->liveins())
-        BranchBB->addLiveIn(LiveIn);
+    // Add live outs if we track liveness.
+    if (TRI->trackLivenessAfterRegAlloc(*MF)) {
+      for (const MachineBasicBlock *Succ : MBB->successors()) {
+        for (const MachineBasicBlock::RegisterMaskPair &LiveIn :
+             Succ->liveins())
+          BranchBB->addLiveIn(LiveIn);
+      }
+      BranchBB->sortUniqueLiveIns();
     }
 
-    BranchBB->sortUniqueLiveIns();
     BranchBB->addSuccessor(DestBB);
     MBB->replaceSuccessor(DestBB, BranchBB);
   }
@@ -211,7 +211,8 @@ bool XRayInstrumentation::runOnMachineFunction(MachineFunction &MF) {
   case Triple::ArchType::mips:
   case Triple::ArchType::mipsel:
   case Triple::ArchType::mips64:
-  case Triple::ArchType::mips64el: {
+  case Triple::ArchType::mips64el:
+  case Triple::ArchType::ve: {
     // For the architectures which don't have a single return instruction
     InstrumentationOptions op;
     op.HandleTailcall = false;
@@ -66,6 +66,59 @@ void ModuleSummaryIndex::collectDefinedFunctionsForModule(
   }
 }
 
+void ModuleSummaryIndex::mergeFrom(ModuleSummaryIndex &&Other) {
+  assert(!HaveGVs && !Other.HaveGVs && "Cannot merge indexes with GVs");
+
+  for (auto &M : Other.ModulePathStringTable)
+    addModule(M.first(), M.second.first, M.second.second);
+
+  // Map the value entries of Other to ours. Like the bitcode reader, keep the
+  // last name read for a GUID. Names which don't live in the string table of
+  // the module are owned by Other and need to be copied.
+  DenseMap<const GlobalValueSummaryMapTy::value_type *,
+           const GlobalValueSummaryMapTy::value_type *>
+      ValueMap;
+  for (auto &I : Other.GlobalValueMap) {
+    auto *VP = getOrInsertValuePtr(I.first);
+    StringRef Name = I.second.U.Name;
+    if (!Name.empty())
+      VP->second.U.Name =
+          Other.Alloc.identifyObject(Name.data()) ? saveString(Name) : Name;
+    ValueMap[&I] = VP;
+  }
+  auto Remap = [&](ValueInfo &VI) {
+    ValueInfo New(HaveGVs, ValueMap.lookup(VI.getRef()));
+    if (VI.isReadOnly())
+      New.setReadOnly();
+    VI = New;
+  };
+
+  for (auto &I : Other.GlobalValueMap) {
+    ValueInfo VI(HaveGVs, ValueMap.lookup(&I));
+    for (std::unique_ptr<GlobalValueSummary> &Summary : I.second.SummaryList) {
+      Summary->setModulePath(getModule(Summary->modulePath())->first());
+      for (ValueInfo &Ref : Summary->RefEdgeList)
+        Remap(Ref);
+      if (auto *FS = dyn_cast<FunctionSummary>(Summary.get()))
+        for (FunctionSummary::EdgeTy &Call : FS->CallGraphEdgeList)
+          Remap(Call.first);
+      addGlobalValueSummary(VI, std::move(Summary));
+    }
+  }
+  Other.GlobalValueMap.clear();
+
+  for (auto &T : Other.TypeIdMap)
+    getOrInsertTypeIdSummary(T.second.first) = std::move(T.second.second);
+  CfiFunctionDefs.insert(Other.CfiFunctionDefs.begin(),
+                         Other.CfiFunctionDefs.end());
+  CfiFunctionDecls.insert(Other.CfiFunctionDecls.begin(),
+                          Other.CfiFunctionDecls.end());
+  if (Other.WithGlobalValueDeadStripping)
+    setWithGlobalValueDeadStripping();
+  if (Other.SkipModuleByDistributedBackend)
+    setSkipModuleByDistributedBackend();
+}
+
 // Collect for each module the list of function it defines (GUID -> Summary).
 void ModuleSummaryIndex::collectDefinedGVSummariesPerModule(
     StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries) const {
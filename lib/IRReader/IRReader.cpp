@@ -32,11 +32,13 @@ static const char *const TimeIRParsingDescription = "Parse IR";
 
 static std::unique_ptr<Module>
 getLazyIRModule(std::unique_ptr<MemoryBuffer> Buffer, SMDiagnostic &Err,
-                LLVMContext &Context, bool ShouldLazyLoadMetadata) {
+                LLVMContext &Context, bool ShouldLazyLoadMetadata,
+                bool LoadMetadataOnDemand) {
   if (isBitcode((const unsigned char *)Buffer->getBufferStart(),
                 (const unsigned char *)Buffer->getBufferEnd())) {
     Expected<std::unique_ptr<Module>> ModuleOrErr = getOwningLazyBitcodeModule(
-        std::move(Buffer), Context, ShouldLazyLoadMetadata);
+        std::move(Buffer), Context, ShouldLazyLoadMetadata,
+        /*IsImporting=*/false, LoadMetadataOnDemand);
     if (Error E = ModuleOrErr.takeError()) {
       handleAllErrors(std::move(E), [&](ErrorInfoBase &EIB) {
         Err = SMDiagnostic(Buffer->getBufferIdentifier(), SourceMgr::DK_Error,
@@ -53,7 +55,8 @@ getLazyIRModule(std::unique_ptr<MemoryBuffer> Buffer, SMDiagnostic &Err,
 std::unique_ptr<Module> llvm::getLazyIRFileModule(StringRef Filename,
                                                   SMDiagnostic &Err,
                                                   LLVMContext &Context,
-                                                  bool ShouldLazyLoadMetadata) {
+                                                  bool ShouldLazyLoadMetadata,
+                                                  bool LoadMetadataOnDemand) {
   ErrorOr<std::unique_ptr<MemoryBuffer>> FileOrErr =
       MemoryBuffer::getFileOrSTDIN(Filename);
   if (std::error_code EC = FileOrErr.getError()) {
@@ -63,7 +66,7 @@ std::unique_ptr<Module> llvm::getLazyIRFileModule(StringRef Filename,
   }
 
   return getLazyIRModule(std::move(FileOrErr.get()), Err, Context,
-                         ShouldLazyLoadMetadata);
+                         ShouldLazyLoadMetadata, LoadMetadataOnDemand);
 }
 
 std::unique_ptr<Module> llvm::parseIR(MemoryBufferRef Buffer, SMDiagnostic &Err,
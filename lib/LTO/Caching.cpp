@@ -13,6 +13,8 @@
 
 #include "llvm/LTO/Caching.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Compression.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -28,8 +30,62 @@
 using namespace llvm;
 using namespace llvm::lto;
 
-Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
-                                            AddBufferFn AddBuffer) {
+// A compressed cache entry starts with this magic, the compression::Format
+// and the size of the object as a little-endian 64-bit value. No object file
+// format starts with the magic, so uncompressed entries can be told apart.
+static const char CompressedEntryMagic[] = {'\xC1', 'L', 'Z', 'C'};
+static constexpr size_t CompressedEntryHeaderSize =
+    sizeof(CompressedEntryMagic) + 1 + 8;
+
+/// Returns the object stored in the cache entry Entry, or null if Entry is
+/// compressed but can't be uncompressed.
+static std::unique_ptr<MemoryBuffer>
+readCacheEntry(std::unique_ptr<MemoryBuffer> Entry) {
+  StringRef Data = Entry->getBuffer();
+  if (!Data.startswith(
+          StringRef(CompressedEntryMagic, sizeof(CompressedEntryMagic))))
+    return Entry;
+  if (Data.size() < CompressedEntryHeaderSize)
+    return nullptr;
+  auto F = static_cast<compression::Format>(Data[sizeof(CompressedEntryMagic)]);
+  if (F != compression::Format::Zlib && F != compression::Format::LZ4)
+    return nullptr;
+  const compression::Codec &Codec = compression::getCodec(F);
+  if (!Codec.isAvailable())
+    return nullptr;
+  uint64_t Size =
+      support::endian::read64le(Data.data() + CompressedEntryHeaderSize - 8);
+  // The size is read from a file which may be corrupted, so it is checked
+  // against the most that the compressed data can expand to before anything
+  // is allocated. An LZ4 byte expands to at most 255 bytes, a deflate one to
+  // at most 1032.
+  uint64_t MaxExpansion = F == compression::Format::LZ4 ? 255 : 1032;
+  if (Size > (Data.size() - CompressedEntryHeaderSize) * MaxExpansion)
+    return nullptr;
+  std::unique_ptr<WritableMemoryBuffer> Object =
+      WritableMemoryBuffer::getNewUninitMemBuffer(
+          Size, Entry->getBufferIdentifier());
+  if (!Object)
+    return nullptr;
+  size_t UncompressedSize = Size;
+  if (Error E = Codec.uncompress(Data.drop_front(CompressedEntryHeaderSize),
+                                 Object->getBufferStart(), UncompressedSize)) {
+    consumeError(std::move(E));
+    return nullptr;
+  }
+  if (UncompressedSize != Size)
+    return nullptr;
+  return std::move(Object);
+}
+
+Expected<NativeObjectCache>
+lto::localCache(StringRef CacheDirectoryPath, AddBufferFn AddBuffer,
+                CacheStats *Stats, bool Indexed,
+                const compression::Codec *Compressor) {
+  if (Compressor && !Compressor->isAvailable())
+    return make_error<StringError>(Compressor->getName() +
+                                       " compression is not available",
+                                   inconvertibleErrorCode());
   if (std::error_code EC = sys::fs::create_directories(CacheDirectoryPath))
     return errorCodeToError(EC);
 
@@ -37,7 +93,10 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
     // This choice of file name allows the cache to be pruned (see pruneCache()
     // in include/llvm/Support/CachePruning.h).
     SmallString<64> EntryPath;
-    sys::path::append(EntryPath, CacheDirectoryPath, "llvmcache-" + Key);
+    if (Indexed)
+      EntryPath = getIndexedCacheEntryPath(CacheDirectoryPath, Key);
+    else
+      sys::path::append(EntryPath, CacheDirectoryPath, "llvmcache-" + Key);
     // First, see if we have a cache hit.
     int FD;
     SmallString<64> ResultPath;
@@ -50,10 +109,23 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
                                     /*RequiresNullTerminator*/ false);
       close(FD);
       if (MBOrErr) {
-        AddBuffer(Task, std::move(*MBOrErr));
-        return AddStreamFn();
+        uint64_t EntrySize = (*MBOrErr)->getBufferSize();
+        // An entry which doesn't uncompress is rebuilt and replaced.
+        if (std::unique_ptr<MemoryBuffer> Object =
+                readCacheEntry(std::move(*MBOrErr))) {
+          if (Stats) {
+            ++Stats->Hits;
+            Stats->BytesSaved += Object->getBufferSize();
+          }
+          if (Indexed)
+            recordIndexedCacheEntry(CacheDirectoryPath, Key, EntrySize);
+          AddBuffer(Task, std::move(Object));
+          return AddStreamFn();
+        }
+        EC = errc::no_such_file_or_directory;
+      } else {
+        EC = MBOrErr.getError();
       }
-      EC = MBOrErr.getError();
     }
 
     // On Windows we can fail to open a cache file with a permission denied
@@ -66,6 +138,9 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
       report_fatal_error(Twine("Failed to open cache file ") + EntryPath +
                          ": " + EC.message() + "\n");
 
+    if (Stats)
+      ++Stats->Misses;
+
     // This native object stream is responsible for commiting the resulting
     // file to the cache and calling AddBuffer to add it to the link.
     struct CacheStream : NativeObjectStream {
@@ -73,27 +148,73 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
       sys::fs::TempFile TempFile;
       std::string EntryPath;
       unsigned Task;
+      /// The cache directory and key if the cache is indexed.
+      std::string IndexedCachePath;
+      std::string Key;
+      /// If not null, the object is written to ObjectBuffer and stored
+      /// compressed with Compressor.
+      const compression::Codec *Compressor;
+      std::unique_ptr<SmallVector<char, 0>> ObjectBuffer;
 
       CacheStream(std::unique_ptr<raw_pwrite_stream> OS, AddBufferFn AddBuffer,
                   sys::fs::TempFile TempFile, std::string EntryPath,
-                  unsigned Task)
+                  unsigned Task, std::string IndexedCachePath, std::string Key,
+                  const compression::Codec *Compressor,
+                  std::unique_ptr<SmallVector<char, 0>> ObjectBuffer)
           : NativeObjectStream(std::move(OS)), AddBuffer(std::move(AddBuffer)),
             TempFile(std::move(TempFile)), EntryPath(std::move(EntryPath)),
-            Task(Task) {}
+            Task(Task), IndexedCachePath(std::move(IndexedCachePath)),
+            Key(std::move(Key)), Compressor(Compressor),
+            ObjectBuffer(std::move(ObjectBuffer)) {}
+
+      /// Write the compressed object to the temporary file and return the
+      /// object. Sets EntrySize to the size of the file.
+      std::unique_ptr<MemoryBuffer> writeCompressedEntry(uint64_t &EntrySize) {
+        StringRef Object(ObjectBuffer->data(), ObjectBuffer->size());
+        SmallVector<char, 0> Compressed;
+        if (Error E = Compressor->compress(Object, Compressed))
+          report_fatal_error(Twine("Failed to compress cache file ") +
+                             TempFile.TmpName + ": " +
+                             toString(std::move(E)) + "\n");
+        char Header[CompressedEntryHeaderSize];
+        memcpy(Header, CompressedEntryMagic, sizeof(CompressedEntryMagic));
+        Header[sizeof(CompressedEntryMagic)] =
+            static_cast<char>(Compressor->getFormat());
+        support::endian::write64le(Header + CompressedEntryHeaderSize - 8,
+                                   Object.size());
+        {
+          raw_fd_ostream OS(TempFile.FD, /*shouldClose=*/false);
+          OS.write(Header, sizeof(Header));
+          OS.write(Compressed.data(), Compressed.size());
+        }
+        EntrySize = sizeof(Header) + Compressed.size();
+        return MemoryBuffer::getMemBufferCopy(Object, EntryPath);
+      }
 
       ~CacheStream() {
         // Make sure the stream is closed before committing it.
         OS.reset();
 
-        // Open the file first to avoid racing with a cache pruner.
         ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
-            MemoryBuffer::getOpenFile(TempFile.FD, TempFile.TmpName,
-                                      /*FileSize*/ -1,
-                                      /*RequiresNullTerminator*/ false);
-        if (!MBOrErr)
-          report_fatal_error(Twine("Failed to open new cache file ") +
-                             TempFile.TmpName + ": " +
-                             MBOrErr.getError().message() + "\n");
+            std::unique_ptr<MemoryBuffer>();
+        uint64_t EntrySize = 0;
+        if (Compressor) {
+          MBOrErr = writeCompressedEntry(EntrySize);
+        } else {
+          // Open the file first to avoid racing with a cache pruner.
+          MBOrErr = MemoryBuffer::getOpenFile(TempFile.FD, TempFile.TmpName,
+                                              /*FileSize*/ -1,
+                                              /*RequiresNullTerminator*/ false);
+          if (!MBOrErr)
+            report_fatal_error(Twine("Failed to open new cache file ") +
+                               TempFile.TmpName + ": " +
+                               MBOrErr.getError().message() + "\n");
+          EntrySize = (*MBOrErr)->getBufferSize();
+        }
+
+        // The subdirectory of an indexed cache entry may not exist yet.
+        if (!IndexedCachePath.empty())
+          sys::fs::create_directories(sys::path::parent_path(EntryPath));
 
         // On POSIX systems, this will atomically replace the destination if
         // it already exists. We try to emulate this on Windows, but this may
@@ -125,10 +246,13 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
                              TempFile.TmpName + " to " + EntryPath + ": " +
                              toString(std::move(E)) + "\n");
 
+        if (!IndexedCachePath.empty())
+          recordIndexedCacheEntry(IndexedCachePath, Key, EntrySize);
         AddBuffer(Task, std::move(*MBOrErr));
       }
     };
 
+    std::string KeyStr = Key;
     return [=](size_t Task) -> std::unique_ptr<NativeObjectStream> {
       // Write to a temporary to avoid race condition
       SmallString<64> TempFilenameModel;
@@ -140,10 +264,23 @@ Expected<NativeObjectCache> lto::localCache(StringRef CacheDirectoryPath,
         report_fatal_error("ThinLTO: Can't get a temporary file");
       }
 
+      // The object is compressed as a whole, so it is kept in memory until
+      // the stream is done.
+      std::unique_ptr<raw_pwrite_stream> OS;
+      std::unique_ptr<SmallVector<char, 0>> ObjectBuffer;
+      if (Compressor) {
+        ObjectBuffer = llvm::make_unique<SmallVector<char, 0>>();
+        OS = llvm::make_unique<raw_svector_ostream>(*ObjectBuffer);
+      } else {
+        OS = llvm::make_unique<raw_fd_ostream>(Temp->FD,
+                                               /* ShouldClose */ false);
+      }
+
       // This CacheStream will move the temporary file into the cache when done.
       return llvm::make_unique<CacheStream>(
-          llvm::make_unique<raw_fd_ostream>(Temp->FD, /* ShouldClose */ false),
-          AddBuffer, std::move(*Temp), EntryPath.str(), Task);
+          std::move(OS), AddBuffer, std::move(*Temp), EntryPath.str(), Task,
+          Indexed ? CacheDirectoryPath.str() : std::string(), KeyStr,
+          Compressor, std::move(ObjectBuffer));
     };
   };
 }
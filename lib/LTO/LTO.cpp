@@ -27,9 +27,11 @@
 #include "llvm/LTO/LTOBackend.h"
 #include "llvm/Linker/IRMover.h"
 #include "llvm/Object/IRObjectFile.h"
+#include "llvm/Support/Debug.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SHA1.h"
 #include "llvm/Support/SourceMgr.h"
@@ -61,6 +63,19 @@ cl::opt<bool> EnableLTOInternalization(
     "enable-lto-internalization", cl::init(true), cl::Hidden,
     cl::desc("Enable global value internalization in LTO"));
 
+/// The estimated memory footprint of a ThinLTO backend per IR instruction of
+/// the functions it compiles. This only needs to be accurate enough to keep
+/// the largest backends from running at the same time.
+static cl::opt<unsigned> BackendBytesPerInstruction(
+    "thinlto-backend-bytes-per-inst", cl::init(1024), cl::Hidden,
+    cl::desc("Estimated memory footprint of a ThinLTO backend per IR "
+             "instruction, in bytes"));
+
+STATISTIC(NumBackendsDelayed,
+          "Number of ThinLTO backends delayed by the memory budget");
+STATISTIC(PeakBackendFootprintKB,
+          "Peak estimated footprint of the running ThinLTO backends, in KB");
+
 // Computes a unique hash for the Module considering the current list of
 // export/import and other global analysis results.
 // The hash is produced in \p Key.
@@ -142,19 +157,40 @@ void llvm::computeLTOCacheKey(
   // Include the hash for the current module
   auto ModHash = Index.getModuleHash(ModuleID);
   Hasher.update(ArrayRef<uint8_t>((uint8_t *)&ModHash[0], sizeof(ModHash)));
-  for (auto F : ExportList)
-    // The export list can impact the internalization, be conservative here
+  // The export list can impact the internalization, be conservative here.
+  // Hash it in sorted order, the iteration order of the set depends on the
+  // order in which the exports were discovered.
+  std::vector<GlobalValue::GUID> ExportsGUID(ExportList.begin(),
+                                             ExportList.end());
+  llvm::sort(ExportsGUID);
+  for (auto F : ExportsGUID)
     Hasher.update(ArrayRef<uint8_t>((uint8_t *)&F, sizeof(F)));
 
   // Include the hash for every module we import functions from. The set of
   // imported symbols for each module may affect code generation and is
-  // sensitive to link order, so include that as well.
-  for (auto &Entry : ImportList) {
-    auto ModHash = Index.getModuleHash(Entry.first());
-    Hasher.update(ArrayRef<uint8_t>((uint8_t *)&ModHash[0], sizeof(ModHash)));
-
-    AddUint64(Entry.second.size());
-    for (auto &Fn : Entry.second)
+  // sensitive to link order, so include that as well. The import list is
+  // hashed in a fixed order, since a list reused from a previous thin link
+  // iterates differently than a newly computed one.
+  using ImportEntry =
+      std::pair<ModuleHash, const FunctionImporter::ImportMapTy::value_type *>;
+  std::vector<ImportEntry> ImportEntries;
+  for (auto &Entry : ImportList)
+    ImportEntries.push_back(
+        std::make_pair(Index.getModuleHash(Entry.first()), &Entry));
+  llvm::sort(ImportEntries, [](const ImportEntry &L, const ImportEntry &R) {
+    return std::make_pair(L.first, L.second->first()) <
+           std::make_pair(R.first, R.second->first());
+  });
+  for (auto &Entry : ImportEntries) {
+    const ModuleHash &ModHash = Entry.first;
+    Hasher.update(ArrayRef<uint8_t>((const uint8_t *)&ModHash[0],
+                                    sizeof(ModHash)));
+
+    std::vector<GlobalValue::GUID> Functions(Entry.second->second.begin(),
+                                             Entry.second->second.end());
+    llvm::sort(Functions);
+    AddUint64(Functions.size());
+    for (auto Fn : Functions)
       AddUint64(Fn);
   }
 
@@ -378,8 +414,16 @@ static void thinLTOInternalizeAndPromoteGUID(
 void llvm::thinLTOInternalizeAndPromoteInIndex(
     ModuleSummaryIndex &Index,
     function_ref<bool(StringRef, GlobalValue::GUID)> isExported) {
+  // Every GUID only updates its own summaries, so the entries are processed
+  // in parallel. isExported is only reading the export lists.
+  std::vector<GlobalValueSummaryMapTy::value_type *> Entries;
+  Entries.reserve(Index.size());
   for (auto &I : Index)
-    thinLTOInternalizeAndPromoteGUID(I.second.SummaryList, I.first, isExported);
+    Entries.push_back(&I);
+  parallel::for_each_n(parallel::par, size_t(0), Entries.size(), [&](size_t I) {
+    thinLTOInternalizeAndPromoteGUID(Entries[I]->second.SummaryList,
+                                     Entries[I]->first, isExported);
+  });
 }
 
 // Requires a destructor for std::vector<InputModule>.
@@ -563,8 +607,7 @@ Error LTO::addModule(InputFile &Input, unsigned ModI,
 
   // Regular LTO module summaries are added to a dummy module that represents
   // the combined regular LTO module.
-  if (Error Err = BM.readSummary(ThinLTO.CombinedIndex, "", -1ull))
-    return Err;
+  ThinLTO.PendingSummaries.push_back({BM, {"", -1ull, {}}});
   RegularLTO.ModsWithSummaries.push_back(std::move(*ModOrErr));
   return Error::success();
 }
@@ -745,10 +788,8 @@ Error LTO::linkRegularLTO(RegularLTOState::AddedModule Mod,
 Error LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
                       const SymbolResolution *&ResI,
                       const SymbolResolution *ResE) {
-  if (Error Err =
-          BM.readSummary(ThinLTO.CombinedIndex, BM.getModuleIdentifier(),
-                         ThinLTO.ModuleMap.size()))
-    return Err;
+  ThinLTOState::PendingSummary Pending{BM.getModuleIdentifier(),
+                                       ThinLTO.ModuleMap.size(), {}};
 
   for (const InputFile::Symbol &Sym : Syms) {
     assert(ResI != ResE);
@@ -757,29 +798,16 @@ Error LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
     if (!Sym.getIRName().empty()) {
       auto GUID = GlobalValue::getGUID(GlobalValue::getGlobalIdentifier(
           Sym.getIRName(), GlobalValue::ExternalLinkage, ""));
-      if (Res.Prevailing) {
+      if (Res.Prevailing)
         ThinLTO.PrevailingModuleForGUID[GUID] = BM.getModuleIdentifier();
 
-        // For linker redefined symbols (via --wrap or --defsym) we want to
-        // switch the linkage to `weak` to prevent IPOs from happening.
-        // Find the summary in the module for this very GV and record the new
-        // linkage so that we can switch it when we import the GV.
-        if (Res.LinkerRedefined)
-          if (auto S = ThinLTO.CombinedIndex.findSummaryInModule(
-                  GUID, BM.getModuleIdentifier()))
-            S->setLinkage(GlobalValue::WeakAnyLinkage);
-      }
-
-      // If the linker resolved the symbol to a local definition then mark it
-      // as local in the summary for the module we are adding.
-      if (Res.FinalDefinitionInLinkageUnit) {
-        if (auto S = ThinLTO.CombinedIndex.findSummaryInModule(
-                GUID, BM.getModuleIdentifier())) {
-          S->setDSOLocal(true);
-        }
-      }
+      bool LinkerRedefined = Res.Prevailing && Res.LinkerRedefined;
+      if (LinkerRedefined || Res.FinalDefinitionInLinkageUnit)
+        Pending.Updates.push_back(
+            {GUID, LinkerRedefined, Res.FinalDefinitionInLinkageUnit});
     }
   }
+  ThinLTO.PendingSummaries.push_back({BM, std::move(Pending)});
 
   if (!ThinLTO.ModuleMap.insert({BM.getModuleIdentifier(), BM}).second)
     return make_error<StringError>(
@@ -789,12 +817,68 @@ Error LTO::addThinLTO(BitcodeModule BM, ArrayRef<InputFile::Symbol> Syms,
   return Error::success();
 }
 
+Error LTO::readPendingSummaries() {
+  std::vector<std::pair<BitcodeModule, ThinLTOState::PendingSummary>> Pending =
+      std::move(ThinLTO.PendingSummaries);
+  ThinLTO.PendingSummaries.clear();
+
+  // Reading a summary only touches its own index, so the summaries of all
+  // modules can be read in parallel.
+  std::vector<Optional<Expected<std::unique_ptr<ModuleSummaryIndex>>>>
+      Indexes(Pending.size());
+  parallel::for_each_n(
+      parallel::par, size_t(0), Pending.size(), [&](size_t I) {
+        auto Index = llvm::make_unique<ModuleSummaryIndex>(/*HaveGVs=*/false);
+        const ThinLTOState::PendingSummary &P = Pending[I].second;
+        if (Error Err =
+                Pending[I].first.readSummary(*Index, P.ModulePath, P.ModuleId))
+          Indexes[I].emplace(std::move(Err));
+        else
+          Indexes[I].emplace(std::move(Index));
+      });
+
+  for (unsigned I = 0; I != Pending.size(); ++I) {
+    Expected<std::unique_ptr<ModuleSummaryIndex>> &IndexOrErr = *Indexes[I];
+    if (!IndexOrErr) {
+      for (unsigned J = I + 1; J != Pending.size(); ++J)
+        if (!*Indexes[J])
+          consumeError(Indexes[J]->takeError());
+      return IndexOrErr.takeError();
+    }
+    ThinLTO.CombinedIndex.mergeFrom(std::move(**IndexOrErr));
+
+    StringRef ModulePath = Pending[I].second.ModulePath;
+    for (const ThinLTOState::PendingSummary::Update &U :
+         Pending[I].second.Updates) {
+      // For linker redefined symbols (via --wrap or --defsym) we want to
+      // switch the linkage to `weak` to prevent IPOs from happening.
+      // Find the summary in the module for this very GV and record the new
+      // linkage so that we can switch it when we import the GV.
+      if (U.LinkerRedefined)
+        if (auto S =
+                ThinLTO.CombinedIndex.findSummaryInModule(U.GUID, ModulePath))
+          S->setLinkage(GlobalValue::WeakAnyLinkage);
+
+      // If the linker resolved the symbol to a local definition then mark it
+      // as local in the summary for the module we are adding.
+      if (U.FinalDefinitionInLinkageUnit)
+        if (auto S =
+                ThinLTO.CombinedIndex.findSummaryInModule(U.GUID, ModulePath))
+          S->setDSOLocal(true);
+    }
+  }
+  return Error::success();
+}
+
 unsigned LTO::getMaxTasks() const {
   CalledGetMaxTasks = true;
   return RegularLTO.ParallelCodeGenParallelismLevel + ThinLTO.ModuleMap.size();
 }
 
 Error LTO::run(AddStreamFn AddStream, NativeObjectCache Cache) {
+  if (Error Err = readPendingSummaries())
+    return Err;
+
   // Compute "dead" symbols, we don't want to import/export these!
   DenseSet<GlobalValue::GUID> GUIDPreservedSymbols;
   DenseMap<GlobalValue::GUID, PrevailingType> GUIDPrevailingResolutions;
@@ -937,6 +1021,60 @@ public:
 };
 
 namespace {
+/// Estimates the cost of the ThinLTO backend of a module as the number of IR
+/// instructions it optimizes and generates code for: those of the functions
+/// defined in the module and of the functions it imports.
+uint64_t estimateBackendCost(const ModuleSummaryIndex &CombinedIndex,
+                             const GVSummaryMapTy &DefinedGlobals,
+                             const FunctionImporter::ImportMapTy &ImportList) {
+  uint64_t Cost = 0;
+  for (auto &DefinedGlobal : DefinedGlobals)
+    if (auto *FS = dyn_cast<FunctionSummary>(DefinedGlobal.second))
+      Cost += FS->instCount();
+  for (auto &FromModule : ImportList)
+    for (GlobalValue::GUID GUID : FromModule.second)
+      if (auto *FS = dyn_cast_or_null<FunctionSummary>(
+              CombinedIndex.findSummaryInModule(GUID, FromModule.first())))
+        Cost += FS->instCount();
+  return Cost;
+}
+
+/// Limits the sum of the estimated memory footprints of the backends running
+/// at the same time.
+class BackendMemoryBudget {
+  const uint64_t Budget;
+  uint64_t InUse = 0;
+  std::mutex Mu;
+  std::condition_variable Released;
+
+public:
+  explicit BackendMemoryBudget(uint64_t Budget) : Budget(Budget) {}
+
+  /// Blocks until \p Bytes fit into the budget. A backend exceeding the
+  /// budget on its own runs once no other backend is running.
+  void acquire(StringRef ModulePath, uint64_t Bytes) {
+    std::unique_lock<std::mutex> L(Mu);
+    auto Fits = [&] { return !InUse || InUse + Bytes <= Budget; };
+    if (!Fits()) {
+      ++NumBackendsDelayed;
+      Released.wait(L, Fits);
+    }
+    InUse += Bytes;
+    PeakBackendFootprintKB.updateMax(InUse / 1024);
+    LLVM_DEBUG(dbgs() << "ThinLTO backend " << ModulePath << " starts: "
+                      << Bytes << " bytes, " << InUse << " of " << Budget
+                      << " bytes in use\n");
+  }
+
+  void release(uint64_t Bytes) {
+    {
+      std::unique_lock<std::mutex> L(Mu);
+      InUse -= Bytes;
+    }
+    Released.notify_all();
+  }
+};
+
 class InProcessThinBackend : public ThinBackendProc {
   ThreadPool BackendThreadPool;
   AddStreamFn AddStream;
@@ -944,18 +1082,31 @@ class InProcessThinBackend : public ThinBackendProc {
   std::set<GlobalValue::GUID> CfiFunctionDefs;
   std::set<GlobalValue::GUID> CfiFunctionDecls;
 
+  /// A backend collected by start(), and its estimated cost.
+  struct BackendJob {
+    StringRef ModulePath;
+    uint64_t Cost;
+    std::function<void()> Run;
+  };
+  std::vector<BackendJob> Jobs;
+
+  /// The memory budget of the backends, if any.
+  std::unique_ptr<BackendMemoryBudget> MemoryBudget;
+
   Optional<Error> Err;
   std::mutex ErrMu;
 
 public:
   InProcessThinBackend(
       Config &Conf, ModuleSummaryIndex &CombinedIndex,
-      unsigned ThinLTOParallelismLevel,
+      unsigned ThinLTOParallelismLevel, uint64_t MemoryBudgetBytes,
       const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
       AddStreamFn AddStream, NativeObjectCache Cache)
       : ThinBackendProc(Conf, CombinedIndex, ModuleToDefinedGVSummaries),
         BackendThreadPool(ThinLTOParallelismLevel),
         AddStream(std::move(AddStream)), Cache(std::move(Cache)) {
+    if (MemoryBudgetBytes)
+      MemoryBudget = llvm::make_unique<BackendMemoryBudget>(MemoryBudgetBytes);
     for (auto &Name : CombinedIndex.cfiFunctionDefs())
       CfiFunctionDefs.insert(
           GlobalValue::getGUID(GlobalValue::dropLLVMManglingEscape(Name)));
@@ -1012,7 +1163,10 @@ public:
     assert(ModuleToDefinedGVSummaries.count(ModulePath));
     const GVSummaryMapTy &DefinedGlobals =
         ModuleToDefinedGVSummaries.find(ModulePath)->second;
-    BackendThreadPool.async(
+    uint64_t Cost =
+        estimateBackendCost(CombinedIndex, DefinedGlobals, ImportList);
+    uint64_t Footprint = Cost * BackendBytesPerInstruction;
+    Jobs.push_back({ModulePath, Cost, std::bind(
         [=](BitcodeModule BM, ModuleSummaryIndex &CombinedIndex,
             const FunctionImporter::ImportMapTy &ImportList,
             const FunctionImporter::ExportSetTy &ExportList,
@@ -1020,9 +1174,13 @@ public:
                 &ResolvedODR,
             const GVSummaryMapTy &DefinedGlobals,
             MapVector<StringRef, BitcodeModule> &ModuleMap) {
+          if (MemoryBudget)
+            MemoryBudget->acquire(BM.getModuleIdentifier(), Footprint);
           Error E = runThinLTOBackendThread(
               AddStream, Cache, Task, BM, CombinedIndex, ImportList, ExportList,
               ResolvedODR, DefinedGlobals, ModuleMap);
+          if (MemoryBudget)
+            MemoryBudget->release(Footprint);
           if (E) {
             std::unique_lock<std::mutex> L(ErrMu);
             if (Err)
@@ -1032,11 +1190,23 @@ public:
           }
         },
         BM, std::ref(CombinedIndex), std::ref(ImportList), std::ref(ExportList),
-        std::ref(ResolvedODR), std::ref(DefinedGlobals), std::ref(ModuleMap));
+        std::ref(ResolvedODR), std::ref(DefinedGlobals), std::ref(ModuleMap))});
     return Error::success();
   }
 
   Error wait() override {
+    // Start the most expensive backends first, so that none of them is left
+    // running alone at the end of the backend phase.
+    std::stable_sort(Jobs.begin(), Jobs.end(),
+                     [](const BackendJob &LHS, const BackendJob &RHS) {
+                       return LHS.Cost > RHS.Cost;
+                     });
+    for (BackendJob &Job : Jobs) {
+      LLVM_DEBUG(dbgs() << "Dispatching ThinLTO backend " << Job.ModulePath
+                        << " with cost " << Job.Cost << "\n");
+      BackendThreadPool.async(std::move(Job.Run));
+    }
+    Jobs.clear();
     BackendThreadPool.wait();
     if (Err)
       return std::move(*Err);
@@ -1046,13 +1216,14 @@ public:
 };
 } // end anonymous namespace
 
-ThinBackend lto::createInProcessThinBackend(unsigned ParallelismLevel) {
+ThinBackend lto::createInProcessThinBackend(unsigned ParallelismLevel,
+                                            uint64_t MemoryBudget) {
   return [=](Config &Conf, ModuleSummaryIndex &CombinedIndex,
              const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
              AddStreamFn AddStream, NativeObjectCache Cache) {
     return llvm::make_unique<InProcessThinBackend>(
-        Conf, CombinedIndex, ParallelismLevel, ModuleToDefinedGVSummaries,
-        AddStream, Cache);
+        Conf, CombinedIndex, ParallelismLevel, MemoryBudget,
+        ModuleToDefinedGVSummaries, AddStream, Cache);
   };
 }
 
@@ -1179,9 +1350,21 @@ Error LTO::runThinLTO(AddStreamFn AddStream, NativeObjectCache Cache) {
   if (DumpThinCGSCCs)
     ThinLTO.CombinedIndex.dumpSCCs(outs());
 
-  if (Conf.OptLevel > 0)
-    ComputeCrossModuleImport(ThinLTO.CombinedIndex, ModuleToDefinedGVSummaries,
-                             ImportLists, ExportLists);
+  if (Conf.OptLevel > 0) {
+    if (Conf.ThinLinkCacheFile.empty()) {
+      ComputeCrossModuleImport(ThinLTO.CombinedIndex,
+                               ModuleToDefinedGVSummaries, ImportLists,
+                               ExportLists);
+    } else {
+      ThinLinkImportCache ImportCache =
+          ThinLinkImportCache::load(Conf.ThinLinkCacheFile);
+      ComputeCrossModuleImport(ThinLTO.CombinedIndex,
+                               ModuleToDefinedGVSummaries, ImportLists,
+                               ExportLists, &ImportCache);
+      if (Error E = ImportCache.save(Conf.ThinLinkCacheFile))
+        return E;
+    }
+  }
 
   // Figure out which symbols need to be internalized. This also needs to happen
   // at -O0 because summary-based DCE is implemented using internalization, and
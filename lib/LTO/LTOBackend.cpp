@@ -255,34 +255,56 @@ static void runNewPMCustomPasses(Module &Mod, TargetMachine *TM,
   MPM.run(Mod, MAM);
 }
 
+static void initOldPMBuilder(PassManagerBuilder &PMB, Config &Conf,
+                             TargetMachine *TM) {
+  PMB.LibraryInfo = new TargetLibraryInfoImpl(Triple(TM->getTargetTriple()));
+  PMB.VerifyOutput = !Conf.DisableVerify;
+  PMB.LoopVectorize = true;
+  PMB.SLPVectorize = true;
+  PMB.OptLevel = Conf.OptLevel;
+  PMB.PGOSampleUse = Conf.SampleProfile;
+}
+
 static void runOldPMPasses(Config &Conf, Module &Mod, TargetMachine *TM,
-                           bool IsThinLTO, ModuleSummaryIndex *ExportSummary,
+                           bool IsThinLTO, bool SplitFunctionPasses,
+                           ModuleSummaryIndex *ExportSummary,
                            const ModuleSummaryIndex *ImportSummary) {
   legacy::PassManager passes;
   passes.add(createTargetTransformInfoWrapperPass(TM->getTargetIRAnalysis()));
 
   PassManagerBuilder PMB;
-  PMB.LibraryInfo = new TargetLibraryInfoImpl(Triple(TM->getTargetTriple()));
+  initOldPMBuilder(PMB, Conf, TM);
   PMB.Inliner = createFunctionInliningPass();
   PMB.ExportSummary = ExportSummary;
   PMB.ImportSummary = ImportSummary;
   // Unconditionally verify input since it is not verified before this
   // point and has unknown origin.
   PMB.VerifyInput = true;
-  PMB.VerifyOutput = !Conf.DisableVerify;
-  PMB.LoopVectorize = true;
-  PMB.SLPVectorize = true;
-  PMB.OptLevel = Conf.OptLevel;
-  PMB.PGOSampleUse = Conf.SampleProfile;
   if (IsThinLTO)
     PMB.populateThinLTOPassManager(passes);
+  else if (SplitFunctionPasses)
+    PMB.populateLTOModulePassManager(passes);
   else
     PMB.populateLTOPassManager(passes);
   passes.run(Mod);
 }
 
+// Runs the function simplification passes which runOldPMPasses left out with
+// SplitFunctionPasses on one partition of the module.
+static void runOldPMPartitionPasses(Config &Conf, Module &Mod,
+                                    TargetMachine *TM) {
+  legacy::PassManager passes;
+  passes.add(createTargetTransformInfoWrapperPass(TM->getTargetIRAnalysis()));
+
+  PassManagerBuilder PMB;
+  initOldPMBuilder(PMB, Conf, TM);
+  PMB.populateLTOPartitionPassManager(passes);
+  passes.run(Mod);
+}
+
 bool opt(Config &Conf, TargetMachine *TM, unsigned Task, Module &Mod,
-         bool IsThinLTO, ModuleSummaryIndex *ExportSummary,
+         bool IsThinLTO, bool SplitFunctionPasses,
+         ModuleSummaryIndex *ExportSummary,
          const ModuleSummaryIndex *ImportSummary) {
   // FIXME: Plumb the combined index into the new pass manager.
   if (!Conf.OptPipeline.empty())
@@ -292,7 +314,8 @@ bool opt(Config &Conf, TargetMachine *TM, unsigned Task, Module &Mod,
     runNewPMPasses(Conf, Mod, TM, Conf.OptLevel, IsThinLTO, ExportSummary,
                    ImportSummary);
   else
-    runOldPMPasses(Conf, Mod, TM, IsThinLTO, ExportSummary, ImportSummary);
+    runOldPMPasses(Conf, Mod, TM, IsThinLTO, SplitFunctionPasses,
+                   ExportSummary, ImportSummary);
   return !Conf.PostOptModuleHook || Conf.PostOptModuleHook(Task, Mod);
 }
 
@@ -335,7 +358,7 @@ void codegen(Config &Conf, TargetMachine *TM, AddStreamFn AddStream,
 
 void splitCodeGen(Config &C, TargetMachine *TM, AddStreamFn AddStream,
                   unsigned ParallelCodeGenParallelismLevel,
-                  std::unique_ptr<Module> Mod) {
+                  bool SplitFunctionPasses, std::unique_ptr<Module> Mod) {
   ThreadPool CodegenThreadPool(ParallelCodeGenParallelismLevel);
   unsigned ThreadCount = 0;
   const Target *T = &TM->getTarget();
@@ -367,13 +390,15 @@ void splitCodeGen(Config &C, TargetMachine *TM, AddStreamFn AddStream,
               std::unique_ptr<TargetMachine> TM =
                   createTargetMachine(C, T, *MPartInCtx);
 
+              if (SplitFunctionPasses)
+                runOldPMPartitionPasses(C, *MPartInCtx, TM.get());
               codegen(C, TM.get(), AddStream, ThreadId, *MPartInCtx);
             },
             // Pass BC using std::move to ensure that it get moved rather than
             // copied into the thread's context.
             std::move(BC), ThreadCount++);
       },
-      false);
+      false, C.BalancePartitions);
 
   // Because the inner lambda (which runs in a worker thread) captures our local
   // variables, we need to wait for the worker threads to terminate before we
@@ -424,8 +449,15 @@ Error lto::backend(Config &C, AddStreamFn AddStream,
     return DiagFileOrErr.takeError();
   auto DiagnosticOutputFile = std::move(*DiagFileOrErr);
 
+  // The function passes of the default pipeline may run on the partitions
+  // of the module in parallel rather than on the whole module.
+  bool SplitFunctionPasses = C.SplitFunctionPasses &&
+                             ParallelCodeGenParallelismLevel > 1 &&
+                             !C.CodeGenOnly && C.OptPipeline.empty() &&
+                             !C.UseNewPM;
+
   if (!C.CodeGenOnly) {
-    if (!opt(C, TM.get(), 0, *Mod, /*IsThinLTO=*/false,
+    if (!opt(C, TM.get(), 0, *Mod, /*IsThinLTO=*/false, SplitFunctionPasses,
              /*ExportSummary=*/&CombinedIndex, /*ImportSummary=*/nullptr))
       return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
   }
@@ -434,7 +466,7 @@ Error lto::backend(Config &C, AddStreamFn AddStream,
     codegen(C, TM.get(), AddStream, 0, *Mod);
   } else {
     splitCodeGen(C, TM.get(), AddStream, ParallelCodeGenParallelismLevel,
-                 std::move(Mod));
+                 SplitFunctionPasses, std::move(Mod));
   }
   return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
 }
@@ -520,6 +552,7 @@ Error lto::thinBackend(Config &Conf, unsigned Task, AddStreamFn AddStream,
     return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
 
   if (!opt(Conf, TM.get(), Task, Mod, /*IsThinLTO=*/true,
+           /*SplitFunctionPasses=*/false,
            /*ExportSummary=*/nullptr, /*ImportSummary=*/&CombinedIndex))
     return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
 
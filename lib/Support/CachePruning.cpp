@@ -13,10 +13,16 @@
 
 #include "llvm/Support/CachePruning.h"
 
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Chrono.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/LineIterator.h"
+#include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -49,6 +55,212 @@ struct FileInfo {
 };
 } // anonymous namespace
 
+static const char IndexFileName[] = "llvmcache.index";
+static const char JournalFileName[] = "llvmcache.journal";
+static const char SweepFileName[] = "llvmcache.sweep";
+
+/// How long a journal taken over by a prune may still receive records from
+/// processes which opened it before.
+static const std::chrono::seconds JournalGracePeriod(60);
+
+/// How often the directories of an indexed cache are scanned for entries
+/// missing from the index.
+static const std::chrono::hours SweepInterval(24);
+
+void CacheStats::print(raw_ostream &OS) const {
+  uint64_t Lookups = Hits + Misses;
+  OS << "===-------------------------------------------------------------------"
+        "------===\n"
+     << "                             Cache statistics\n"
+     << "===-------------------------------------------------------------------"
+        "------===\n"
+     << "  hits:          " << Hits << "\n"
+     << "  misses:        " << Misses << "\n"
+     << "  hit rate:      " << (Lookups ? Hits * 100 / Lookups : 0) << "%\n"
+     << "  bytes saved:   " << BytesSaved << "\n"
+     << "  evictions:     " << Evictions << "\n"
+     << "  bytes evicted: " << BytesEvicted << "\n";
+}
+
+std::string llvm::getIndexedCacheEntryPath(StringRef Path, StringRef Key) {
+  SmallString<128> EntryPath(Path);
+  sys::path::append(EntryPath, Key.take_front(2), "llvmcache-" + Key);
+  return EntryPath.str();
+}
+
+void llvm::recordIndexedCacheEntry(StringRef Path, StringRef Key,
+                                   uint64_t Size) {
+  SmallString<128> JournalPath(Path);
+  sys::path::append(JournalPath, JournalFileName);
+  std::error_code EC;
+  raw_fd_ostream OS(JournalPath, EC, sys::fs::F_Append);
+  if (EC)
+    return;
+  // The record is written with a single write() when OS is destroyed, so the
+  // records of concurrent processes don't interleave.
+  OS << Key << ' ' << Size << ' '
+     << sys::toTimeT(std::chrono::system_clock::now()) << '\n';
+}
+
+namespace {
+struct IndexEntry {
+  uint64_t Size = 0;
+  std::time_t Time = 0;
+};
+} // anonymous namespace
+
+/// Read the "<key> <size> <time>" records of an index or journal file,
+/// keeping the latest use of each key. Malformed records are skipped.
+static void readIndexRecords(StringRef File,
+                             StringMap<IndexEntry> &Entries) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr = MemoryBuffer::getFile(File);
+  if (!MBOrErr)
+    return;
+  for (line_iterator Line(**MBOrErr); !Line.is_at_eof(); ++Line) {
+    SmallVector<StringRef, 3> Fields;
+    Line->split(Fields, ' ');
+    uint64_t Size;
+    long long Time;
+    // The key becomes part of a path to delete, so it must not contain
+    // separators.
+    if (Fields.size() != 3 || Fields[0].empty() ||
+        Fields[0].find_first_of("/\\.") != StringRef::npos ||
+        Fields[1].getAsInteger(10, Size) || Fields[2].getAsInteger(10, Time))
+      continue;
+    IndexEntry &Entry = Entries[Fields[0]];
+    Entry.Size = Size;
+    Entry.Time = std::max<std::time_t>(Entry.Time, Time);
+  }
+}
+
+/// Returns the entries of the indexed cache directory Path, after folding
+/// its journal into them. Must be called with the index locked.
+static StringMap<IndexEntry> readIndexedCache(StringRef Path,
+                                              sys::TimePoint<> CurrentTime) {
+  StringMap<IndexEntry> Entries;
+  SmallString<128> IndexPath(Path);
+  sys::path::append(IndexPath, IndexFileName);
+  readIndexRecords(IndexPath, Entries);
+
+  // A process which opened the journal before an earlier prune took it over
+  // may have appended to it afterwards, so the journals taken over are kept
+  // for a grace period and read again. Their records are only used for
+  // entries which are still around; the others were read and have been
+  // evicted since.
+  std::string TakenPrefix = std::string(JournalFileName) + "-";
+  std::error_code EC;
+  for (sys::fs::directory_iterator File(Path, EC), FileEnd;
+       File != FileEnd && !EC; File.increment(EC)) {
+    StringRef Name = sys::path::filename(File->path());
+    long long TakeTime;
+    if (!Name.startswith(TakenPrefix) ||
+        Name.drop_front(TakenPrefix.size())
+            .split('-')
+            .first.getAsInteger(10, TakeTime))
+      continue;
+    StringMap<IndexEntry> Records;
+    readIndexRecords(File->path(), Records);
+    for (const auto &Record : Records) {
+      StringRef Key = Record.getKey();
+      auto Entry = Entries.find(Key);
+      if (Entry == Entries.end()) {
+        if (!sys::fs::exists(getIndexedCacheEntryPath(Path, Key)))
+          continue;
+        Entries[Key] = Record.getValue();
+        continue;
+      }
+      Entry->second.Size = Record.getValue().Size;
+      Entry->second.Time =
+          std::max(Entry->second.Time, Record.getValue().Time);
+    }
+    if (CurrentTime - sys::toTimePoint(TakeTime) > JournalGracePeriod)
+      sys::fs::remove(File->path());
+  }
+
+  // Take the journal over, so that records appended from now on go to a new
+  // one.
+  SmallString<128> JournalPath(Path), TakenPath;
+  sys::path::append(JournalPath, JournalFileName);
+  if (sys::fs::createUniqueFile(JournalPath + "-" +
+                                    Twine(sys::toTimeT(CurrentTime)) +
+                                    "-%%%%%%",
+                                TakenPath))
+    return Entries;
+  if (!sys::fs::rename(JournalPath, TakenPath))
+    readIndexRecords(TakenPath, Entries);
+  else
+    sys::fs::remove(TakenPath);
+  return Entries;
+}
+
+/// Scan the subdirectories of the indexed cache directory Path and bring
+/// Entries in line with the files found there. Files without an entry, whose
+/// journal records were lost, are adopted so that they get pruned, and
+/// entries without a file are dropped.
+static void sweepIndexedCache(StringRef Path, StringMap<IndexEntry> &Entries) {
+  StringSet<> Found;
+  std::error_code EC;
+  for (sys::fs::directory_iterator Dir(Path, EC), DirEnd;
+       Dir != DirEnd && !EC; Dir.increment(EC)) {
+    StringRef Shard = sys::path::filename(Dir->path());
+    if (Shard.size() != 2 || Dir->type() != sys::fs::file_type::directory_file)
+      continue;
+    std::error_code FileEC;
+    for (sys::fs::directory_iterator File(Dir->path(), FileEC), FileEnd;
+         File != FileEnd && !FileEC; File.increment(FileEC)) {
+      StringRef Name = sys::path::filename(File->path());
+      if (!Name.startswith("llvmcache-"))
+        continue;
+      StringRef Key = Name.drop_front(StringRef("llvmcache-").size());
+      if (!Key.startswith(Shard))
+        continue;
+      Found.insert(Key);
+      if (Entries.count(Key))
+        continue;
+      ErrorOr<sys::fs::basic_file_status> StatusOrErr = File->status();
+      if (!StatusOrErr)
+        continue;
+      LLVM_DEBUG(dbgs() << "Adopt " << File->path() << "\n");
+      IndexEntry &Entry = Entries[Key];
+      Entry.Size = StatusOrErr->getSize();
+      Entry.Time = sys::toTimeT(StatusOrErr->getLastModificationTime());
+    }
+    if (FileEC)
+      EC = FileEC;
+  }
+  // Only drop entries after a complete scan.
+  if (EC)
+    return;
+  for (auto I = Entries.begin(), E = Entries.end(); I != E;) {
+    auto Entry = I++;
+    if (!Found.count(Entry->first()))
+      Entries.erase(Entry);
+  }
+}
+
+/// Atomically replace the index of the indexed cache directory Path with
+/// Entries.
+static void writeIndex(StringRef Path, const StringMap<IndexEntry> &Entries) {
+  SmallString<128> IndexPath(Path);
+  sys::path::append(IndexPath, IndexFileName);
+  Expected<sys::fs::TempFile> Temp =
+      sys::fs::TempFile::create(IndexPath + "-%%%%%%");
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    for (const auto &Entry : Entries)
+      OS << Entry.getKey() << ' ' << Entry.getValue().Size << ' '
+         << Entry.getValue().Time << '\n';
+  }
+  if (Error E = Temp->keep(IndexPath)) {
+    consumeError(std::move(E));
+    consumeError(Temp->discard());
+  }
+}
+
 /// Write a new timestamp file with the given path. This is used for the pruning
 /// interval option.
 static void writeTimestampFile(StringRef TimestampFile) {
@@ -149,7 +361,8 @@ llvm::parseCachePruningPolicy(StringRef PolicyStr) {
 }
 
 /// Prune the cache of files that haven't been accessed in a long time.
-bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy) {
+bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy,
+                      CacheStats *Stats) {
   using namespace std::chrono;
 
   if (Path.empty())
@@ -212,42 +425,100 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy) {
   std::set<FileInfo> FileInfos;
   uint64_t TotalSize = 0;
 
-  // Walk the entire directory cache, looking for unused files.
-  std::error_code EC;
-  SmallString<128> CachePathNative;
-  sys::path::native(Path, CachePathNative);
-  // Walk all of the files within this directory.
-  for (sys::fs::directory_iterator File(CachePathNative, EC), FileEnd;
-       File != FileEnd && !EC; File.increment(EC)) {
-    // Ignore any files not beginning with the string "llvmcache-". This
-    // includes the timestamp file as well as any files created by the user.
-    // This acts as a safeguard against data loss if the user specifies the
-    // wrong directory as their cache directory.
-    if (!sys::path::filename(File->path()).startswith("llvmcache-"))
-      continue;
+  auto RemoveFile = [&](StringRef File, uint64_t Size) {
+    // The file of an index entry may be gone already.
+    if (sys::fs::remove(File, /*IgnoreNonExisting=*/false))
+      return;
+    if (Stats) {
+      ++Stats->Evictions;
+      Stats->BytesEvicted += Size;
+    }
+  };
 
-    // Look at this file. If we can't stat it, there's nothing interesting
-    // there.
-    ErrorOr<sys::fs::basic_file_status> StatusOrErr = File->status();
-    if (!StatusOrErr) {
-      LLVM_DEBUG(dbgs() << "Ignore " << File->path() << " (can't stat)\n");
-      continue;
+  SmallString<128> IndexPath(Path), JournalPath(Path);
+  sys::path::append(IndexPath, IndexFileName);
+  sys::path::append(JournalPath, JournalFileName);
+  bool IsIndexed =
+      sys::fs::exists(IndexPath) || sys::fs::exists(JournalPath);
+  StringMap<IndexEntry> Entries;
+  std::unique_ptr<LockFileManager> IndexLock;
+
+  if (IsIndexed) {
+    // Concurrent pruners would each fold a different journal and overwrite
+    // each other's index, so only one may run at a time.
+    IndexLock = llvm::make_unique<LockFileManager>(IndexPath);
+    if (IndexLock->getState() != LockFileManager::LFS_Owned) {
+      LLVM_DEBUG(dbgs() << "Index locked by another process, do not prune.\n");
+      return false;
     }
 
-    // If the file hasn't been used recently enough, delete it
-    const auto FileAccessTime = StatusOrErr->getLastAccessedTime();
-    auto FileAge = CurrentTime - FileAccessTime;
-    if (Policy.Expiration != seconds(0) && FileAge > Policy.Expiration) {
-      LLVM_DEBUG(dbgs() << "Remove " << File->path() << " ("
-                        << duration_cast<seconds>(FileAge).count()
-                        << "s old)\n");
-      sys::fs::remove(File->path());
-      continue;
+    // The index lists the files with their time of last use, so there is no
+    // need to walk the directories, except once in a while in case records
+    // were lost, for example because a process was killed.
+    Entries = readIndexedCache(Path, CurrentTime);
+    SmallString<128> SweepFile(Path);
+    sys::path::append(SweepFile, SweepFileName);
+    sys::fs::file_status SweepStatus;
+    if (sys::fs::status(SweepFile, SweepStatus) ||
+        CurrentTime - SweepStatus.getLastModificationTime() > SweepInterval) {
+      writeTimestampFile(SweepFile);
+      sweepIndexedCache(Path, Entries);
     }
 
-    // Leave it here for now, but add it to the list of size-based pruning.
-    TotalSize += StatusOrErr->getSize();
-    FileInfos.insert({FileAccessTime, StatusOrErr->getSize(), File->path()});
+    for (auto I = Entries.begin(), E = Entries.end(); I != E;) {
+      auto Entry = I++;
+      std::string EntryPath = getIndexedCacheEntryPath(Path, Entry->first());
+      auto FileAge = CurrentTime - sys::toTimePoint(Entry->second.Time);
+      if (Policy.Expiration != seconds(0) && FileAge > Policy.Expiration) {
+        LLVM_DEBUG(dbgs() << "Remove " << EntryPath << " ("
+                          << duration_cast<seconds>(FileAge).count()
+                          << "s old)\n");
+        RemoveFile(EntryPath, Entry->second.Size);
+        Entries.erase(Entry);
+        continue;
+      }
+      TotalSize += Entry->second.Size;
+      FileInfos.insert({sys::toTimePoint(Entry->second.Time),
+                        Entry->second.Size, EntryPath});
+    }
+  } else {
+    // Walk the entire directory cache, looking for unused files.
+    std::error_code EC;
+    SmallString<128> CachePathNative;
+    sys::path::native(Path, CachePathNative);
+    // Walk all of the files within this directory.
+    for (sys::fs::directory_iterator File(CachePathNative, EC), FileEnd;
+         File != FileEnd && !EC; File.increment(EC)) {
+      // Ignore any files not beginning with the string "llvmcache-". This
+      // includes the timestamp file as well as any files created by the user.
+      // This acts as a safeguard against data loss if the user specifies the
+      // wrong directory as their cache directory.
+      if (!sys::path::filename(File->path()).startswith("llvmcache-"))
+        continue;
+
+      // Look at this file. If we can't stat it, there's nothing interesting
+      // there.
+      ErrorOr<sys::fs::basic_file_status> StatusOrErr = File->status();
+      if (!StatusOrErr) {
+        LLVM_DEBUG(dbgs() << "Ignore " << File->path() << " (can't stat)\n");
+        continue;
+      }
+
+      // If the file hasn't been used recently enough, delete it
+      const auto FileAccessTime = StatusOrErr->getLastAccessedTime();
+      auto FileAge = CurrentTime - FileAccessTime;
+      if (Policy.Expiration != seconds(0) && FileAge > Policy.Expiration) {
+        LLVM_DEBUG(dbgs() << "Remove " << File->path() << " ("
+                          << duration_cast<seconds>(FileAge).count()
+                          << "s old)\n");
+        RemoveFile(File->path(), StatusOrErr->getSize());
+        continue;
+      }
+
+      // Leave it here for now, but add it to the list of size-based pruning.
+      TotalSize += StatusOrErr->getSize();
+      FileInfos.insert({FileAccessTime, StatusOrErr->getSize(), File->path()});
+    }
   }
 
   auto FileInfo = FileInfos.begin();
@@ -255,7 +526,10 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy) {
 
   auto RemoveCacheFile = [&]() {
     // Remove the file.
-    sys::fs::remove(FileInfo->Path);
+    RemoveFile(FileInfo->Path, FileInfo->Size);
+    if (IsIndexed)
+      Entries.erase(sys::path::filename(FileInfo->Path).drop_front(
+          StringRef("llvmcache-").size()));
     // Update size
     TotalSize -= FileInfo->Size;
     NumFiles--;
@@ -296,5 +570,8 @@ bool llvm::pruneCache(StringRef Path, CachePruningPolicy Policy) {
     while (TotalSize > TotalSizeTarget && FileInfo != FileInfos.end())
       RemoveCacheFile();
   }
+
+  if (IsIndexed)
+    writeIndex(Path, Entries);
   return true;
 }
@@ -18,17 +18,20 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
 #if LLVM_ENABLE_ZLIB == 1 && HAVE_ZLIB_H
 #include <zlib.h>
 #endif
 
 using namespace llvm;
 
-#if LLVM_ENABLE_ZLIB == 1 && HAVE_LIBZ
 static Error createError(StringRef Err) {
   return make_error<StringError>(Err, inconvertibleErrorCode());
 }
 
+#if LLVM_ENABLE_ZLIB == 1 && HAVE_LIBZ
 static StringRef convertZlibCodeToString(int Code) {
   switch (Code) {
   case Z_MEM_ERROR:
@@ -105,3 +108,235 @@ uint32_t zlib::crc32(StringRef Buffer) {
   llvm_unreachable("zlib::crc32 is unavailable");
 }
 #endif
+
+// The LZ4 block format is a sequence of sequences. Each sequence consists of
+//   - a token byte, whose high nibble is the number of literals and whose low
+//     nibble is the length of the match minus 4,
+//   - if the number of literals is 15 or more, further bytes adding to it,
+//     ending with the first byte which isn't 255,
+//   - the literals,
+//   - the offset of the match as a little-endian 16-bit value,
+//   - if the match length minus 4 is 15 or more, further bytes adding to it,
+//     the same way as for the number of literals.
+// The last sequence only consists of the token and the literals. It has at
+// least 5 literals, and the last match starts at least 12 bytes before the end
+// of the input.
+static constexpr unsigned LZ4MinMatch = 4;
+static constexpr unsigned LZ4LastLiterals = 5;
+static constexpr unsigned LZ4MatchFindLimit = 12;
+static constexpr unsigned LZ4MaxOffset = 65535;
+static constexpr unsigned LZ4HashLog = 14;
+
+static uint32_t readLZ4Word(const uint8_t *P) {
+  uint32_t V;
+  std::memcpy(&V, P, sizeof(V));
+  return V;
+}
+
+static void writeLZ4Length(SmallVectorImpl<char> &Out, size_t Len) {
+  for (; Len >= 255; Len -= 255)
+    Out.push_back(char(255));
+  Out.push_back(char(Len));
+}
+
+static void writeLZ4Sequence(SmallVectorImpl<char> &Out,
+                             const uint8_t *Literals, size_t NumLiterals,
+                             size_t Offset, size_t MatchLen) {
+  size_t MatchCode = MatchLen ? MatchLen - LZ4MinMatch : 0;
+  Out.push_back(char((std::min<size_t>(NumLiterals, 15) << 4) |
+                     std::min<size_t>(MatchCode, 15)));
+  if (NumLiterals >= 15)
+    writeLZ4Length(Out, NumLiterals - 15);
+  Out.append(Literals, Literals + NumLiterals);
+  if (!MatchLen)
+    return;
+  Out.push_back(char(Offset & 0xff));
+  Out.push_back(char(Offset >> 8));
+  if (MatchCode >= 15)
+    writeLZ4Length(Out, MatchCode - 15);
+}
+
+Error lz4::compress(StringRef InputBuffer,
+                    SmallVectorImpl<char> &CompressedBuffer) {
+  const uint8_t *Src = InputBuffer.bytes_begin();
+  size_t Size = InputBuffer.size();
+  CompressedBuffer.clear();
+  CompressedBuffer.reserve(Size + Size / 255 + 16);
+
+  // The positions plus one of the last occurrences of each hashed word.
+  std::vector<uint32_t> Table(1 << LZ4HashLog, 0);
+  size_t Anchor = 0;
+  if (Size > LZ4MatchFindLimit) {
+    size_t MatchStartLimit = Size - LZ4MatchFindLimit;
+    size_t MatchEndLimit = Size - LZ4LastLiterals;
+    size_t Pos = 0;
+    while (Pos < MatchStartLimit) {
+      uint32_t Word = readLZ4Word(Src + Pos);
+      uint32_t &Entry = Table[(Word * 2654435761U) >> (32 - LZ4HashLog)];
+      size_t Cand = Entry;
+      Entry = Pos + 1;
+      if (!Cand || Pos - (Cand - 1) > LZ4MaxOffset ||
+          readLZ4Word(Src + Cand - 1) != Word) {
+        // Skip faster through data which doesn't compress.
+        Pos += 1 + ((Pos - Anchor) >> 6);
+        continue;
+      }
+      --Cand;
+
+      size_t Len = LZ4MinMatch;
+      while (Pos + Len < MatchEndLimit && Src[Cand + Len] == Src[Pos + Len])
+        ++Len;
+      while (Pos > Anchor && Cand > 0 && Src[Pos - 1] == Src[Cand - 1]) {
+        --Pos;
+        --Cand;
+        ++Len;
+      }
+      writeLZ4Sequence(CompressedBuffer, Src + Anchor, Pos - Anchor,
+                       Pos - Cand, Len);
+      Pos += Len;
+      Anchor = Pos;
+    }
+  }
+  writeLZ4Sequence(CompressedBuffer, Src + Anchor, Size - Anchor, 0, 0);
+  return Error::success();
+}
+
+/// Read the extension bytes of a length whose nibble was 15.
+static bool readLZ4Length(const uint8_t *&P, const uint8_t *End, size_t &Len) {
+  uint8_t B;
+  do {
+    if (P == End)
+      return false;
+    B = *P++;
+    Len += B;
+  } while (B == 255);
+  return true;
+}
+
+Error lz4::uncompress(StringRef InputBuffer, char *UncompressedBuffer,
+                      size_t &UncompressedSize) {
+  const uint8_t *P = InputBuffer.bytes_begin();
+  const uint8_t *End = InputBuffer.bytes_end();
+  uint8_t *Dst = reinterpret_cast<uint8_t *>(UncompressedBuffer);
+  size_t Capacity = UncompressedSize;
+  size_t Out = 0;
+  while (true) {
+    if (P == End)
+      return createError("lz4 error: truncated input");
+    uint8_t Token = *P++;
+
+    size_t NumLiterals = Token >> 4;
+    if (NumLiterals == 15 && !readLZ4Length(P, End, NumLiterals))
+      return createError("lz4 error: truncated input");
+    if (size_t(End - P) < NumLiterals)
+      return createError("lz4 error: truncated input");
+    if (Capacity - Out < NumLiterals)
+      return createError("lz4 error: output buffer too small");
+    std::memcpy(Dst + Out, P, NumLiterals);
+    P += NumLiterals;
+    Out += NumLiterals;
+    if (P == End)
+      break;
+
+    if (End - P < 2)
+      return createError("lz4 error: truncated input");
+    size_t Offset = P[0] | (P[1] << 8);
+    P += 2;
+    if (Offset == 0 || Offset > Out)
+      return createError("lz4 error: invalid match offset");
+    size_t Len = Token & 15;
+    if (Len == 15 && !readLZ4Length(P, End, Len))
+      return createError("lz4 error: truncated input");
+    Len += LZ4MinMatch;
+    if (Capacity - Out < Len)
+      return createError("lz4 error: output buffer too small");
+    // Matches may overlap their own output.
+    if (Offset >= Len) {
+      std::memcpy(Dst + Out, Dst + Out - Offset, Len);
+    } else {
+      for (size_t I = 0; I != Len; ++I)
+        Dst[Out + I] = Dst[Out - Offset + I];
+    }
+    Out += Len;
+  }
+  UncompressedSize = Out;
+  return Error::success();
+}
+
+Error lz4::uncompress(StringRef InputBuffer,
+                      SmallVectorImpl<char> &UncompressedBuffer,
+                      size_t UncompressedSize) {
+  UncompressedBuffer.resize(UncompressedSize);
+  Error E =
+      uncompress(InputBuffer, UncompressedBuffer.data(), UncompressedSize);
+  UncompressedBuffer.resize(UncompressedSize);
+  return E;
+}
+
+compression::Codec::~Codec() = default;
+
+Error compression::Codec::uncompress(StringRef InputBuffer,
+                                     SmallVectorImpl<char> &UncompressedBuffer,
+                                     size_t UncompressedSize) const {
+  UncompressedBuffer.resize(UncompressedSize);
+  Error E =
+      uncompress(InputBuffer, UncompressedBuffer.data(), UncompressedSize);
+  UncompressedBuffer.resize(UncompressedSize);
+  return E;
+}
+
+namespace {
+class ZlibCodec : public compression::Codec {
+public:
+  compression::Format getFormat() const override {
+    return compression::Format::Zlib;
+  }
+  StringRef getName() const override { return "zlib"; }
+  bool isAvailable() const override { return zlib::isAvailable(); }
+  Error compress(StringRef InputBuffer,
+                 SmallVectorImpl<char> &CompressedBuffer) const override {
+    return zlib::compress(InputBuffer, CompressedBuffer,
+                          zlib::BestSpeedCompression);
+  }
+  Error uncompress(StringRef InputBuffer, char *UncompressedBuffer,
+                   size_t &UncompressedSize) const override {
+    return zlib::uncompress(InputBuffer, UncompressedBuffer, UncompressedSize);
+  }
+};
+
+class LZ4Codec : public compression::Codec {
+public:
+  compression::Format getFormat() const override {
+    return compression::Format::LZ4;
+  }
+  StringRef getName() const override { return "lz4"; }
+  bool isAvailable() const override { return true; }
+  Error compress(StringRef InputBuffer,
+                 SmallVectorImpl<char> &CompressedBuffer) const override {
+    return lz4::compress(InputBuffer, CompressedBuffer);
+  }
+  Error uncompress(StringRef InputBuffer, char *UncompressedBuffer,
+                   size_t &UncompressedSize) const override {
+    return lz4::uncompress(InputBuffer, UncompressedBuffer, UncompressedSize);
+  }
+};
+} // end anonymous namespace
+
+const compression::Codec &compression::getCodec(Format F) {
+  static const ZlibCodec Zlib;
+  static const LZ4Codec LZ4;
+  switch (F) {
+  case Format::Zlib:
+    return Zlib;
+  case Format::LZ4:
+    return LZ4;
+  }
+  llvm_unreachable("unknown compression format");
+}
+
+const compression::Codec *compression::getCodec(StringRef Name) {
+  for (Format F : {Format::Zlib, Format::LZ4})
+    if (getCodec(F).getName() == Name)
+      return &getCodec(F);
+  return nullptr;
+}
@@ -12,55 +12,68 @@
 
 #if LLVM_ENABLE_THREADS
 
+#include "llvm/Support/Compiler.h"
 #include "llvm/Support/Threading.h"
 
 #include <atomic>
+#include <deque>
 #include <stack>
 #include <thread>
+#include <vector>
 
 using namespace llvm;
+using parallel::detail::ExecutorKind;
+using parallel::detail::Latch;
 
 namespace {
 
+/// A closure and the latch of the TaskGroup that spawned it.  Executors move
+/// tasks around, so spawning a task costs a single std::function.
+struct Task {
+  std::function<void()> F;
+  Latch *L;
+
+  void operator()() {
+    F();
+    L->dec();
+  }
+};
+
 /// An abstract class that takes closures and runs them asynchronously.
 class Executor {
 public:
   virtual ~Executor() = default;
-  virtual void add(std::function<void()> func) = 0;
+  virtual void add(Task T) = 0;
 
-  static Executor *getDefaultExecutor();
+  static Executor *getExecutor(ExecutorKind Kind);
 };
 
 #if defined(_MSC_VER)
 /// An Executor that runs tasks via ConcRT.
 class ConcRTExecutor : public Executor {
   struct Taskish {
-    Taskish(std::function<void()> Task) : Task(Task) {}
+    Taskish(Task T) : T(std::move(T)) {}
 
-    std::function<void()> Task;
+    Task T;
 
     static void run(void *P) {
       Taskish *Self = static_cast<Taskish *>(P);
-      Self->Task();
+      Self->T();
       concurrency::Free(Self);
     }
   };
 
 public:
-  virtual void add(std::function<void()> F) {
+  virtual void add(Task T) {
     Concurrency::CurrentScheduler::ScheduleTask(
-        Taskish::run, new (concurrency::Alloc(sizeof(Taskish))) Taskish(F));
+        Taskish::run,
+        new (concurrency::Alloc(sizeof(Taskish))) Taskish(std::move(T)));
   }
 };
+#endif
 
-Executor *Executor::getDefaultExecutor() {
-  static ConcRTExecutor exec;
-  return &exec;
-}
-
-#else
 /// An implementation of an Executor that runs closures on a thread pool
-///   in filo order.
+///   in filo order.  All threads share a single stack and mutex.
 class ThreadPoolExecutor : public Executor {
 public:
   explicit ThreadPoolExecutor(unsigned ThreadCount = hardware_concurrency())
@@ -83,9 +96,9 @@ public:
     // Wait for ~Latch.
   }
 
-  void add(std::function<void()> F) override {
+  void add(Task T) override {
     std::unique_lock<std::mutex> Lock(Mutex);
-    WorkStack.push(F);
+    WorkStack.push(std::move(T));
     Lock.unlock();
     Cond.notify_one();
   }
@@ -97,33 +110,158 @@ private:
       Cond.wait(Lock, [&] { return Stop || !WorkStack.empty(); });
       if (Stop)
         break;
-      auto Task = WorkStack.top();
+      Task T = std::move(WorkStack.top());
       WorkStack.pop();
       Lock.unlock();
-      Task();
+      T();
     }
     Done.dec();
   }
 
   std::atomic<bool> Stop{false};
-  std::stack<std::function<void()>> WorkStack;
+  std::stack<Task> WorkStack;
   std::mutex Mutex;
   std::condition_variable Cond;
-  parallel::detail::Latch Done;
+  Latch Done;
 };
 
-Executor *Executor::getDefaultExecutor() {
-  static ThreadPoolExecutor exec;
-  return &exec;
-}
+class WorkStealingExecutor;
+
+/// The executor and the index of the worker running on this thread, if any.
+static LLVM_THREAD_LOCAL WorkStealingExecutor *CurrentExecutor = nullptr;
+static LLVM_THREAD_LOCAL unsigned CurrentWorker = 0;
+
+/// An implementation of an Executor that runs closures on a thread pool
+///   with a deque per worker.  A worker pushes the tasks it spawns to the
+///   back of its own deque and pops them from there, so the task run next
+///   usually works on data still in its cache.  Workers whose deque runs
+///   empty take tasks added by threads outside of the pool from a global
+///   injection queue, and then steal the oldest tasks of the other workers.
+///   As long as every worker has work, each only takes its own lock.
+class WorkStealingExecutor : public Executor {
+public:
+  explicit WorkStealingExecutor(unsigned ThreadCount = hardware_concurrency())
+      : Queues(ThreadCount), Done(ThreadCount) {
+    // Spawn all but one of the threads in another thread as spawning threads
+    // can take a while.
+    std::thread([&, ThreadCount] {
+      for (unsigned I = 1; I < ThreadCount; ++I)
+        std::thread([=] { work(I); }).detach();
+      work(0);
+    }).detach();
+  }
+
+  ~WorkStealingExecutor() override {
+    std::unique_lock<std::mutex> Lock(SleepMutex);
+    Stop = true;
+    Lock.unlock();
+    SleepCond.notify_all();
+    // Wait for ~Latch.
+  }
+
+  void add(Task T) override {
+    WorkQueue &Q = CurrentExecutor == this ? Queues[CurrentWorker] : Injected;
+    {
+      std::lock_guard<std::mutex> Lock(Q.Mutex);
+      Q.Tasks.push_back(std::move(T));
+    }
+    // A worker going to sleep increments Sleeping before it checks Pending,
+    // so either it sees this task or this sees it sleeping.
+    ++Pending;
+    if (Sleeping != 0) {
+      std::lock_guard<std::mutex> Lock(SleepMutex);
+      SleepCond.notify_one();
+    }
+  }
+
+private:
+  struct WorkQueue {
+    std::mutex Mutex;
+    std::deque<Task> Tasks;
+  };
+
+  bool popBack(WorkQueue &Q, Task &T) {
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    if (Q.Tasks.empty())
+      return false;
+    T = std::move(Q.Tasks.back());
+    Q.Tasks.pop_back();
+    --Pending;
+    return true;
+  }
+
+  bool popFront(WorkQueue &Q, Task &T) {
+    std::lock_guard<std::mutex> Lock(Q.Mutex);
+    if (Q.Tasks.empty())
+      return false;
+    T = std::move(Q.Tasks.front());
+    Q.Tasks.pop_front();
+    --Pending;
+    return true;
+  }
+
+  bool take(unsigned Self, Task &T) {
+    if (popBack(Queues[Self], T) || popFront(Injected, T))
+      return true;
+    for (unsigned I = 1, E = Queues.size(); I != E; ++I)
+      if (popFront(Queues[(Self + I) % E], T))
+        return true;
+    return false;
+  }
+
+  void work(unsigned Self) {
+    CurrentExecutor = this;
+    CurrentWorker = Self;
+    while (!Stop) {
+      Task T;
+      if (take(Self, T)) {
+        T();
+        continue;
+      }
+      std::unique_lock<std::mutex> Lock(SleepMutex);
+      ++Sleeping;
+      SleepCond.wait(Lock, [&] { return Stop || Pending != 0; });
+      --Sleeping;
+    }
+    Done.dec();
+  }
+
+  std::atomic<bool> Stop{false};
+  std::vector<WorkQueue> Queues;
+  WorkQueue Injected;
+  /// The number of tasks in all queues.
+  std::atomic<unsigned> Pending{0};
+  /// The number of workers waiting for SleepCond.
+  std::atomic<unsigned> Sleeping{0};
+  std::mutex SleepMutex;
+  std::condition_variable SleepCond;
+  Latch Done;
+};
+
+Executor *Executor::getExecutor(ExecutorKind Kind) {
+  switch (Kind) {
+  case ExecutorKind::Default:
+    break;
+  case ExecutorKind::WorkStealing: {
+    static WorkStealingExecutor Exec;
+    return &Exec;
+  }
+  case ExecutorKind::SharedStack: {
+    static ThreadPoolExecutor Exec;
+    return &Exec;
+  }
+  }
+#if defined(_MSC_VER)
+  static ConcRTExecutor Exec;
+  return &Exec;
+#else
+  return getExecutor(ExecutorKind::WorkStealing);
 #endif
 }
+}
 
 void parallel::detail::TaskGroup::spawn(std::function<void()> F) {
   L.inc();
-  Executor::getDefaultExecutor()->add([&, F] {
-    F();
-    L.dec();
-  });
+  Executor::getExecutor(Kind)->add(Task{std::move(F), &L});
 }
 #endif // LLVM_ENABLE_THREADS
@@ -13,14 +13,50 @@
 
 #include "llvm/Support/ThreadPool.h"
 
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
+#include <chrono>
+
 using namespace llvm;
 
+void ThreadPool::pushReadyTask(QueuedTask Task) {
+  ReadyTasks.push_back(std::move(Task));
+  std::push_heap(ReadyTasks.begin(), ReadyTasks.end());
+}
+
+ThreadPool::QueuedTask ThreadPool::popReadyTask() {
+  std::pop_heap(ReadyTasks.begin(), ReadyTasks.end());
+  QueuedTask Task = std::move(ReadyTasks.back());
+  ReadyTasks.pop_back();
+  return Task;
+}
+
 #if LLVM_ENABLE_THREADS
 
+// Returns true if the task of Future has finished.
+static bool isReady(const std::shared_future<void> &Future) {
+  return Future.wait_for(std::chrono::seconds(0)) ==
+         std::future_status::ready;
+}
+
+unsigned ThreadPool::releaseBlockedTasks() {
+  unsigned NumReleased = 0;
+  for (size_t I = 0; I < BlockedTasks.size();) {
+    if (!llvm::all_of(BlockedTasks[I].second, isReady)) {
+      ++I;
+      continue;
+    }
+    pushReadyTask(std::move(BlockedTasks[I].first));
+    BlockedTasks.erase(BlockedTasks.begin() + I);
+    ++NumReleased;
+  }
+  return NumReleased;
+}
+
 // Default to hardware_concurrency
 ThreadPool::ThreadPool() : ThreadPool(hardware_concurrency()) {}
 
@@ -32,35 +68,39 @@ ThreadPool::ThreadPool(unsigned ThreadCount)
   for (unsigned ThreadID = 0; ThreadID < ThreadCount; ++ThreadID) {
     Threads.emplace_back([&] {
       while (true) {
-        PackagedTaskTy Task;
+        QueuedTask Task;
         {
           std::unique_lock<std::mutex> LockGuard(QueueLock);
           // Wait for tasks to be pushed in the queue
-          QueueCondition.wait(LockGuard,
-                              [&] { return !EnableFlag || !Tasks.empty(); });
+          QueueCondition.wait(LockGuard, [&] {
+            return !EnableFlag || !ReadyTasks.empty();
+          });
           // Exit condition
-          if (!EnableFlag && Tasks.empty())
+          if (!EnableFlag && ReadyTasks.empty())
             return;
-          // Yeah, we have a task, grab it and release the lock on the queue
-
-          // We first need to signal that we are active before popping the queue
-          // in order for wait() to properly detect that even if the queue is
-          // empty, there is still a task in flight.
-          {
-            std::unique_lock<std::mutex> LockGuard(CompletionLock);
-            ++ActiveThreads;
-          }
-          Task = std::move(Tasks.front());
-          Tasks.pop();
+          // Yeah, we have a task, grab it and release the lock on the queue.
+          // Counting it as active under the same lock lets wait() see it in
+          // flight even though the queue may be empty.
+          ++ActiveThreads;
+          Task = popReadyTask();
         }
         // Run the task we just grabbed
-        Task();
+        Task.Task();
 
+        unsigned NumReleased;
         {
-          // Adjust `ActiveThreads`, in case someone waits on ThreadPool::wait()
-          std::unique_lock<std::mutex> LockGuard(CompletionLock);
+          // Adjust `ActiveThreads` and the group, in case someone waits on
+          // ThreadPool::wait(), and start the tasks depending on this one.
+          std::unique_lock<std::mutex> LockGuard(QueueLock);
           --ActiveThreads;
+          if (Task.Group)
+            --Task.Group->NumTasks;
+          NumReleased = releaseBlockedTasks();
         }
+        if (NumReleased == 1)
+          QueueCondition.notify_one();
+        else if (NumReleased > 1)
+          QueueCondition.notify_all();
 
         // Notify task completion, in case someone waits on ThreadPool::wait()
         CompletionCondition.notify_all();
@@ -70,19 +110,27 @@ ThreadPool::ThreadPool(unsigned ThreadCount)
 }
 
 void ThreadPool::wait() {
-  // Wait for all threads to complete and the queue to be empty
-  std::unique_lock<std::mutex> LockGuard(CompletionLock);
-  // The order of the checks for ActiveThreads and Tasks.empty() matters because
-  // any active threads might be modifying the Tasks queue, and this would be a
-  // race.
-  CompletionCondition.wait(LockGuard,
-                           [&] { return !ActiveThreads && Tasks.empty(); });
+  // Wait for all threads to complete and the queues to be empty
+  std::unique_lock<std::mutex> LockGuard(QueueLock);
+  CompletionCondition.wait(LockGuard, [&] {
+    return !ActiveThreads && ReadyTasks.empty() && BlockedTasks.empty();
+  });
+}
+
+void ThreadPool::wait(ThreadPoolTaskGroup &Group) {
+  assert(&Group.getPool() == this && "Waiting for a group of another pool");
+  std::unique_lock<std::mutex> LockGuard(QueueLock);
+  CompletionCondition.wait(LockGuard, [&] { return !Group.NumTasks; });
 }
 
-std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
+std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task, TaskOptions Opts) {
   /// Wrap the Task in a packaged_task to return a future object.
-  PackagedTaskTy PackagedTask(std::move(Task));
-  auto Future = PackagedTask.get_future();
+  QueuedTask Queued;
+  Queued.Task = PackagedTaskTy(std::move(Task));
+  Queued.Group = Opts.Group;
+  Queued.Priority = Opts.Priority;
+  auto Future = Queued.Task.get_future().share();
+  bool Blocked;
   {
     // Lock the queue and push the new task
     std::unique_lock<std::mutex> LockGuard(QueueLock);
@@ -90,10 +138,18 @@ std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
     // Don't allow enqueueing after disabling the pool
     assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
 
-    Tasks.push(std::move(PackagedTask));
+    Queued.Seq = NumSubmitted++;
+    if (Queued.Group)
+      ++Queued.Group->NumTasks;
+    Blocked = !llvm::all_of(Opts.DependsOn, isReady);
+    if (Blocked)
+      BlockedTasks.emplace_back(std::move(Queued), std::move(Opts.DependsOn));
+    else
+      pushReadyTask(std::move(Queued));
   }
-  QueueCondition.notify_one();
-  return Future.share();
+  if (!Blocked)
+    QueueCondition.notify_one();
+  return Future;
 }
 
 // The destructor joins all threads, waiting for completion.
@@ -121,21 +177,41 @@ ThreadPool::ThreadPool(unsigned ThreadCount)
 }
 
 void ThreadPool::wait() {
-  // Sequential implementation running the tasks
-  while (!Tasks.empty()) {
-    auto Task = std::move(Tasks.front());
-    Tasks.pop();
-    Task();
+  // Sequential implementation running the tasks in priority order. A task
+  // runs the deferred tasks it depends on first.
+  while (!ReadyTasks.empty()) {
+    QueuedTask Task = popReadyTask();
+    Task.Task();
+    if (Task.Group)
+      --Task.Group->NumTasks;
   }
 }
 
-std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
-  // Get a Future with launch::deferred execution using std::async
-  auto Future = std::async(std::launch::deferred, std::move(Task)).share();
+void ThreadPool::wait(ThreadPoolTaskGroup &Group) {
+  assert(&Group.getPool() == this && "Waiting for a group of another pool");
+  // Tasks of the group may depend on tasks of other groups.
+  wait();
+}
+
+std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task, TaskOptions Opts) {
+  // Get a Future with launch::deferred execution using std::async. The task
+  // forces its dependencies first, which are deferred as well.
+  std::vector<std::shared_future<void>> DependsOn = Opts.DependsOn;
+  auto Future = std::async(std::launch::deferred, [DependsOn, Task]() {
+                  for (const std::shared_future<void> &Dep : DependsOn)
+                    Dep.get();
+                  Task();
+                }).share();
   // Wrap the future so that both ThreadPool::wait() can operate and the
   // returned future can be sync'ed on.
-  PackagedTaskTy PackagedTask([Future]() { Future.get(); });
-  Tasks.push(std::move(PackagedTask));
+  QueuedTask Queued;
+  Queued.Task = PackagedTaskTy([Future]() { Future.get(); });
+  Queued.Group = Opts.Group;
+  Queued.Priority = Opts.Priority;
+  Queued.Seq = NumSubmitted++;
+  if (Queued.Group)
+    ++Queued.Group->NumTasks;
+  pushReadyTask(std::move(Queued));
   return Future;
 }
 
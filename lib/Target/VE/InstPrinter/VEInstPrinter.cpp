@@ -161,6 +161,23 @@ void VEInstPrinter::printMemASXOperand(const MCInst *MI, int opNum,
   O << ")";
 }
 
+void VEInstPrinter::printMemASXrriOperand(const MCInst *MI, int opNum,
+                                          const MCSubtargetInfo &STI,
+                                          raw_ostream &O) {
+  // Operands are base, index and displacement, printed as disp(index, base).
+  const MCOperand &MO = MI->getOperand(opNum+2);
+  if (MO.isImm() && MO.getImm() == 0) {
+    // don't print "+0"
+  } else {
+    printOperand(MI, opNum+2, STI, O);
+  }
+  O << "(";
+  printOperand(MI, opNum+1, STI, O);
+  O << ", ";
+  printOperand(MI, opNum, STI, O);
+  O << ")";
+}
+
 void VEInstPrinter::printMemASOperand(const MCInst *MI, int opNum,
                                       const MCSubtargetInfo &STI,
                                       raw_ostream &O, const char *Modifier) {
@@ -44,6 +44,8 @@ public:
                     raw_ostream &OS);
   void printMemASXOperand(const MCInst *MI, int opNum, const MCSubtargetInfo &STI,
                        raw_ostream &OS, const char *Modifier = nullptr);
+  void printMemASXrriOperand(const MCInst *MI, int opNum,
+                             const MCSubtargetInfo &STI, raw_ostream &OS);
   void printMemASOperand(const MCInst *MI, int opNum, const MCSubtargetInfo &STI,
                          raw_ostream &OS, const char *Modifier = nullptr);
   void printCCOperand(const MCInst *MI, int opNum, const MCSubtargetInfo &STI,
@@ -21,14 +21,31 @@
 
 namespace llvm {
   class FunctionPass;
+  class PassRegistry;
   class VETargetMachine;
   class formatted_raw_ostream;
   class AsmPrinter;
   class MCInst;
   class MachineInstr;
+  class InstructionSelector;
+  class VERegisterBankInfo;
+  class VESubtarget;
 
   FunctionPass *createVEISelDag(VETargetMachine &TM);
   FunctionPass *createVEPromoteToI1Pass();
+  FunctionPass *createVEIntrinsicsToIRPass();
+  FunctionPass *createVEChunkLoopOptPass();
+  FunctionPass *createVEStreamingStoresPass();
+  FunctionPass *createVETLSVariableHoistPass();
+
+  void initializeVEIntrinsicsToIRPass(PassRegistry &);
+  void initializeVEChunkLoopOptPass(PassRegistry &);
+  void initializeVEStreamingStoresPass(PassRegistry &);
+  void initializeVETLSVariableHoistPass(PassRegistry &);
+
+  InstructionSelector *createVEInstructionSelector(const VETargetMachine &TM,
+                                                   VESubtarget &Subtarget,
+                                                   VERegisterBankInfo &RBI);
 
   void LowerVEMachineInstrToMCInst(const MachineInstr *MI,
                                       MCInst &OutMI,
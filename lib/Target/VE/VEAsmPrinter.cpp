@@ -55,6 +55,8 @@ namespace {
     void printMemASOperand(const MachineInstr *MI, int opNum, raw_ostream &OS,
                            const char *Modifier = nullptr);
 
+    bool runOnMachineFunction(MachineFunction &MF) override;
+
     void EmitFunctionBodyStart() override;
     void EmitInstruction(const MachineInstr *MI) override;
 
@@ -88,6 +90,10 @@ namespace {
     void LowerV2VMPAndEmitMCInsts(const MachineInstr *MI,
                                   const MCSubtargetInfo &STI);
 
+    void LowerPATCHABLE_FUNCTION_ENTER(const MachineInstr &MI);
+    void LowerPATCHABLE_FUNCTION_EXIT(const MachineInstr &MI);
+    void LowerPATCHABLE_TAIL_CALL(const MachineInstr &MI);
+    void EmitSled(const MachineInstr &MI, SledKind Kind);
   };
 } // end of anonymous namespace
 
@@ -591,6 +597,56 @@ void VEAsmPrinter::LowerV2VMPAndEmitMCInsts(
   }
 }
 
+void VEAsmPrinter::LowerPATCHABLE_FUNCTION_ENTER(const MachineInstr &MI) {
+  EmitSled(MI, SledKind::FUNCTION_ENTER);
+}
+
+void VEAsmPrinter::LowerPATCHABLE_FUNCTION_EXIT(const MachineInstr &MI) {
+  EmitSled(MI, SledKind::FUNCTION_EXIT);
+}
+
+void VEAsmPrinter::LowerPATCHABLE_TAIL_CALL(const MachineInstr &MI) {
+  EmitSled(MI, SledKind::TAIL_CALL);
+}
+
+void VEAsmPrinter::EmitSled(const MachineInstr &MI, SledKind Kind) {
+  static const int8_t NoopsInSledCount = 6;
+  // We want to emit the following pattern:
+  //
+  // .Lxray_sled_N:
+  //   br.l 56
+  //   ; 6 NOP instructions (48 bytes)
+  // .tmpN
+  //
+  // We need 48 bytes (6 instructions) because at runtime, we'd be patching
+  // over the full 56 bytes (7 instructions) with the following pattern:
+  //
+  //   st %lr, -8(, %sp)        ; save the link register
+  //   lea %s13, <function id>  ; %s13 := function ID
+  //   lea %s12, <trampoline>@lo
+  //   and %s12, %s12, (32)0
+  //   lea.sl %s12, <trampoline>@hi(, %s12)
+  //   bsic %lr, (, %s12)       ; call the tracing trampoline
+  //   ld %lr, -8(, %sp)        ; restore the link register
+  //
+  // The first "st" instruction is written last, so the sled is switched
+  // on and off atomically.
+  auto CurSled = OutContext.createTempSymbol("xray_sled_", true);
+  OutStreamer->EmitLabel(CurSled);
+  auto Target = OutContext.createTempSymbol();
+
+  // Emit "br.l 56" instruction, which jumps over the next 48 bytes.  The
+  // operand is the byte offset relative to the branch instruction itself.
+  EmitToStreamer(*OutStreamer, MCInstBuilder(VE::BCRLa)
+    .addImm((NoopsInSledCount + 1) * 8));
+
+  for (int8_t I = 0; I < NoopsInSledCount; I++)
+    EmitToStreamer(*OutStreamer, MCInstBuilder(VE::NOP));
+
+  OutStreamer->EmitLabel(Target);
+  recordSled(CurSled, MI, Kind);
+}
+
 void VEAsmPrinter::EmitInstruction(const MachineInstr *MI)
 {
 
@@ -630,6 +686,15 @@ void VEAsmPrinter::EmitInstruction(const MachineInstr *MI)
   case VE::V2VMP:
     LowerV2VMPAndEmitMCInsts(MI, getSubtargetInfo());
     return;
+  case TargetOpcode::PATCHABLE_FUNCTION_ENTER:
+    LowerPATCHABLE_FUNCTION_ENTER(*MI);
+    return;
+  case TargetOpcode::PATCHABLE_FUNCTION_EXIT:
+    LowerPATCHABLE_FUNCTION_EXIT(*MI);
+    return;
+  case TargetOpcode::PATCHABLE_TAIL_CALL:
+    LowerPATCHABLE_TAIL_CALL(*MI);
+    return;
   }
   MachineBasicBlock::const_instr_iterator I = MI->getIterator();
   MachineBasicBlock::const_instr_iterator E = MI->getParent()->instr_end();
@@ -640,6 +705,19 @@ void VEAsmPrinter::EmitInstruction(const MachineInstr *MI)
   } while ((++I != E) && I->isInsideBundle()); // Delay slot check.
 }
 
+bool VEAsmPrinter::runOnMachineFunction(MachineFunction &MF) {
+  SetupMachineFunction(MF);
+
+  // Emit the rest of the function body.
+  EmitFunctionBody();
+
+  // Emit the XRay table for this function.
+  emitXRayTable();
+
+  // We didn't modify anything.
+  return false;
+}
+
 void VEAsmPrinter::EmitFunctionBodyStart() {
 #if 0
   const MachineRegisterInfo &MRI = MF->getRegInfo();
@@ -0,0 +1,202 @@
+//===-- VECallLowering.cpp - Call lowering ----------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// This file implements the lowering of LLVM calls to machine code calls for
+/// GlobalISel.
+///
+/// Only incoming arguments and return values are handled here.  Outgoing
+/// calls are not lowered yet, so functions containing calls fall back to
+/// SelectionDAG.
+//
+//===----------------------------------------------------------------------===//
+
+#include "VECallLowering.h"
+#include "VEISelLowering.h"
+#include "VEInstrInfo.h"
+#include "llvm/CodeGen/Analysis.h"
+#include "llvm/CodeGen/GlobalISel/MachineIRBuilder.h"
+#include "llvm/CodeGen/MachineFrameInfo.h"
+#include "llvm/CodeGen/MachineRegisterInfo.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+
+using namespace llvm;
+
+// Base offset of the incoming arguments area from %fp, and the size of the
+// register save area at its beginning.  These mirror LowerFormalArguments.
+static const unsigned ArgsBaseOffset = 176;
+static const unsigned ArgsPreserved = 64;
+
+VECallLowering::VECallLowering(const VETargetLowering &TLI)
+    : CallLowering(&TLI) {}
+
+namespace {
+struct IncomingArgHandler : public CallLowering::ValueHandler {
+  IncomingArgHandler(MachineIRBuilder &MIRBuilder, MachineRegisterInfo &MRI,
+                     CCAssignFn *AssignFn)
+      : ValueHandler(MIRBuilder, MRI, AssignFn) {}
+
+  unsigned getStackAddress(uint64_t Size, int64_t Offset,
+                           MachinePointerInfo &MPO) override {
+    // CCState in handleAssignments doesn't know about the preserved area,
+    // so skip it here.
+    auto &MFI = MIRBuilder.getMF().getFrameInfo();
+    Offset += ArgsBaseOffset + ArgsPreserved;
+    int FI = MFI.CreateFixedObject(Size, Offset, true);
+    MPO = MachinePointerInfo::getFixedStack(MIRBuilder.getMF(), FI);
+    unsigned AddrReg = MRI.createGenericVirtualRegister(LLT::pointer(0, 64));
+    MIRBuilder.buildFrameIndex(AddrReg, FI);
+    return AddrReg;
+  }
+
+  void assignValueToReg(unsigned ValVReg, unsigned PhysReg,
+                        CCValAssign &VA) override {
+    MIRBuilder.getMBB().addLiveIn(PhysReg);
+    switch (VA.getLocInfo()) {
+    default:
+      MIRBuilder.buildCopy(ValVReg, PhysReg);
+      break;
+    case CCValAssign::LocInfo::SExt:
+    case CCValAssign::LocInfo::ZExt:
+    case CCValAssign::LocInfo::AExt: {
+      // The caller promoted the argument, so take the low bits only.
+      auto Copy = MIRBuilder.buildCopy(LLT{VA.getLocVT()}, PhysReg);
+      MIRBuilder.buildTrunc(ValVReg, Copy);
+      break;
+    }
+    }
+  }
+
+  void assignValueToAddress(unsigned ValVReg, unsigned Addr, uint64_t Size,
+                            MachinePointerInfo &MPO, CCValAssign &VA) override {
+    auto MMO = MIRBuilder.getMF().getMachineMemOperand(
+        MPO, MachineMemOperand::MOLoad | MachineMemOperand::MOInvariant, Size,
+        0);
+    MIRBuilder.buildLoad(ValVReg, Addr, *MMO);
+  }
+};
+
+struct OutgoingArgHandler : public CallLowering::ValueHandler {
+  OutgoingArgHandler(MachineIRBuilder &MIRBuilder, MachineRegisterInfo &MRI,
+                     MachineInstrBuilder MIB, CCAssignFn *AssignFn)
+      : ValueHandler(MIRBuilder, MRI, AssignFn), MIB(MIB) {}
+
+  unsigned getStackAddress(uint64_t Size, int64_t Offset,
+                           MachinePointerInfo &MPO) override {
+    llvm_unreachable("VE returns a single value in registers only");
+  }
+
+  void assignValueToReg(unsigned ValVReg, unsigned PhysReg,
+                        CCValAssign &VA) override {
+    MIB.addUse(PhysReg, RegState::Implicit);
+    unsigned ExtReg = extendRegister(ValVReg, VA);
+    MIRBuilder.buildCopy(PhysReg, ExtReg);
+  }
+
+  void assignValueToAddress(unsigned ValVReg, unsigned Addr, uint64_t Size,
+                            MachinePointerInfo &MPO, CCValAssign &VA) override {
+    llvm_unreachable("VE returns a single value in registers only");
+  }
+
+  MachineInstrBuilder MIB;
+};
+} // end anonymous namespace
+
+bool VECallLowering::convertToValueType(const ArgInfo &OrigArg,
+                                        SmallVectorImpl<ArgInfo> &Args,
+                                        const DataLayout &DL) const {
+  const VETargetLowering &TLI = *getTLI<VETargetLowering>();
+  SmallVector<EVT, 4> SplitVTs;
+  ComputeValueVTs(TLI, DL, OrigArg.Ty, SplitVTs);
+  if (SplitVTs.size() != 1 || !SplitVTs[0].isSimple())
+    return false;
+
+  // Integers wider than a scalar register are split by SelectionDAG.
+  MVT VT = SplitVTs[0].getSimpleVT();
+  if (VT.isScalarInteger() && VT.getSizeInBits() > 64)
+    return false;
+
+  // f32 lives in the upper half of a scalar register while i32 lives in the
+  // lower one.  GlobalISel has a single s32 type for both and selects it to
+  // I32, so f32 values are left to SelectionDAG.
+  if (VT == MVT::f32)
+    return false;
+
+  LLVMContext &Ctx = OrigArg.Ty->getContext();
+  Args.emplace_back(OrigArg.Reg, SplitVTs[0].getTypeForEVT(Ctx), OrigArg.Flags,
+                    OrigArg.IsFixed);
+  return true;
+}
+
+bool VECallLowering::lowerReturn(MachineIRBuilder &MIRBuilder,
+                                 const Value *Val,
+                                 ArrayRef<unsigned> VRegs) const {
+  auto MIB = MIRBuilder.buildInstrNoInsert(VE::RET);
+  assert(((Val && !VRegs.empty()) || (!Val && VRegs.empty())) &&
+         "Return value without a vreg");
+
+  bool Success = true;
+  if (!VRegs.empty()) {
+    MachineFunction &MF = MIRBuilder.getMF();
+    const Function &F = MF.getFunction();
+    MachineRegisterInfo &MRI = MF.getRegInfo();
+    const DataLayout &DL = F.getParent()->getDataLayout();
+    const VETargetLowering &TLI = *getTLI<VETargetLowering>();
+
+    // Aggregate return values are left to SelectionDAG.
+    SmallVector<ArgInfo, 1> RetInfos;
+    ArgInfo OrigArg{VRegs[0], Val->getType()};
+    setArgFlags(OrigArg, AttributeList::ReturnIndex, DL, F);
+    if (VRegs.size() != 1 || !convertToValueType(OrigArg, RetInfos, DL))
+      return false;
+
+    OutgoingArgHandler Handler(MIRBuilder, MRI, MIB,
+                               TLI.CCAssignFnForReturn(F.getCallingConv()));
+    Success = handleAssignments(MIRBuilder, RetInfos, Handler);
+  }
+
+  MIRBuilder.insertInstr(MIB);
+  return Success;
+}
+
+bool VECallLowering::lowerFormalArguments(MachineIRBuilder &MIRBuilder,
+                                          const Function &F,
+                                          ArrayRef<unsigned> VRegs) const {
+  // Variadic functions need the register save area set up by
+  // LowerFormalArguments.
+  if (F.isVarArg())
+    return false;
+
+  MachineFunction &MF = MIRBuilder.getMF();
+  MachineBasicBlock &MBB = MIRBuilder.getMBB();
+  MachineRegisterInfo &MRI = MF.getRegInfo();
+  const DataLayout &DL = F.getParent()->getDataLayout();
+
+  SmallVector<ArgInfo, 8> ArgInfos;
+  unsigned i = 0;
+  for (auto &Arg : F.args()) {
+    if (DL.getTypeStoreSize(Arg.getType()) == 0)
+      continue;
+    ArgInfo OrigArg{VRegs[i], Arg.getType()};
+    setArgFlags(OrigArg, i + AttributeList::FirstArgIndex, DL, F);
+    if (OrigArg.Flags.isByVal() || !convertToValueType(OrigArg, ArgInfos, DL))
+      return false;
+    ++i;
+  }
+
+  if (!MBB.empty())
+    MIRBuilder.setInstr(*MBB.begin());
+
+  const VETargetLowering &TLI = *getTLI<VETargetLowering>();
+  IncomingArgHandler Handler(
+      MIRBuilder, MRI,
+      TLI.CCAssignFnForCall(F.getCallingConv(), /*IsVarArg=*/false));
+  return handleAssignments(MIRBuilder, ArgInfos, Handler);
+}
@@ -0,0 +1,46 @@
+//===-- VECallLowering.h - Call lowering ------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+/// \file
+/// This file describes how to lower LLVM calls to machine code calls.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIB_TARGET_VE_VECALLLOWERING_H
+#define LLVM_LIB_TARGET_VE_VECALLLOWERING_H
+
+#include "llvm/CodeGen/GlobalISel/CallLowering.h"
+
+namespace llvm {
+
+class DataLayout;
+class VETargetLowering;
+
+class VECallLowering : public CallLowering {
+public:
+  VECallLowering(const VETargetLowering &TLI);
+
+  bool lowerReturn(MachineIRBuilder &MIRBuilder, const Value *Val,
+                   ArrayRef<unsigned> VRegs) const override;
+
+  bool lowerFormalArguments(MachineIRBuilder &MIRBuilder, const Function &F,
+                            ArrayRef<unsigned> VRegs) const override;
+
+private:
+  /// Convert \p OrigArg into an argument of a simple value type.  Pointers
+  /// are turned into i64.  Returns false for aggregates and other types
+  /// which have to be split into several registers.
+  bool convertToValueType(const ArgInfo &OrigArg,
+                          SmallVectorImpl<ArgInfo> &Args,
+                          const DataLayout &DL) const;
+};
+
+} // end namespace llvm
+
+#endif // LLVM_LIB_TARGET_VE_VECALLLOWERING_H
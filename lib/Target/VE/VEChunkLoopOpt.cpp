@@ -0,0 +1,337 @@
+//===-- VEChunkLoopOpt.cpp - Optimize VE loops processing VL chunks -------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Code written with VE intrinsics processes long arrays in chunks of at most
+// 256 elements and sets VL for every chunk:
+//
+//   for (long i = 0; i < n; i += 256) {
+//     int vl = n - i < 256 ? n - i : 256;
+//     _ve_lvl(vl);
+//     ...
+//   }
+//
+// This pass finds such loops and
+//   - removes every LVL which is dominated by another LVL of the same chunk
+//     length, so each chunk sets VL only once, and
+//   - versions the loop on whether the trip count is a multiple of 256.  The
+//     new version sets VL to 256 once before the loop and uses the constant
+//     256 as the chunk length inside it.
+//
+// It does not strip-mine loops itself.  Only loops already written in chunks
+// are handled; generic IR vectors longer than 256 elements are split by type
+// legalization instead.  llc only runs it with -ve-enable-chunk-loop-opt.
+//
+//===----------------------------------------------------------------------===//
+
+#include "VE.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/PatternMatch.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Transforms/Utils.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Transforms/Utils/LoopUtils.h"
+#include "llvm/Transforms/Utils/ValueMapper.h"
+
+using namespace llvm;
+using namespace llvm::PatternMatch;
+
+#define DEBUG_TYPE "ve-chunk-loop-opt"
+
+STATISTIC(NumLVLRemoved, "Number of redundant LVLs removed");
+STATISTIC(NumLoopsVersioned, "Number of loops versioned for full chunks");
+
+static cl::opt<bool> DisableVersioning(
+  "disable-ve-chunk-loop-versioning",
+  cl::init(false),
+  cl::desc("Don't version VE chunk loops for full chunks."),
+  cl::Hidden);
+
+/// Maximum vector length.
+static const unsigned MaxVL = 256;
+
+namespace {
+  /// A loop processing one chunk of at most MaxVL elements per iteration.
+  struct ChunkLoop {
+    Loop *L;
+    PHINode *IV;          // Start of the chunk, stepping by MaxVL.
+    Value *Start;         // Initial value of IV.
+    Value *End;           // Loop invariant bound of IV.
+    ICmpInst::Predicate Pred; // The loop continues while IV.next Pred End.
+    Value *Len;           // smin(End - IV, MaxVL).
+    Value *VL;            // Len or its truncation, passed to LVL.
+    SmallVector<IntrinsicInst *, 4> LVLs;
+  };
+
+  struct VEChunkLoopOpt : public FunctionPass {
+    static char ID;
+    VEChunkLoopOpt() : FunctionPass(ID) {
+      initializeVEChunkLoopOptPass(*PassRegistry::getPassRegistry());
+    }
+
+    StringRef getPassName() const override {
+      return "VE chunk loop optimization";
+    }
+
+    void getAnalysisUsage(AnalysisUsage &AU) const override {
+      AU.addRequired<DominatorTreeWrapperPass>();
+      AU.addRequired<LoopInfoWrapperPass>();
+      AU.addRequiredID(LoopSimplifyID);
+      AU.addRequiredID(LCSSAID);
+    }
+
+    bool runOnFunction(Function &F) override;
+
+  private:
+    DominatorTree *DT;
+    LoopInfo *LI;
+
+    bool analyzeLoop(Loop *L, ChunkLoop &CL);
+    bool removeRedundantLVLs(ChunkLoop &CL);
+    void makeFullChunks(ChunkLoop &CL, Value *Len, Value *VL,
+                        ArrayRef<IntrinsicInst *> LVLs,
+                        BasicBlock *Preheader);
+    void versionLoop(ChunkLoop &CL);
+  };
+} // end anonymous namespace
+
+char VEChunkLoopOpt::ID = 0;
+
+INITIALIZE_PASS_BEGIN(VEChunkLoopOpt, DEBUG_TYPE,
+                      "VE chunk loop optimization", false, false)
+INITIALIZE_PASS_DEPENDENCY(DominatorTreeWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(LoopSimplify)
+INITIALIZE_PASS_DEPENDENCY(LCSSAWrapperPass)
+INITIALIZE_PASS_END(VEChunkLoopOpt, DEBUG_TYPE,
+                    "VE chunk loop optimization", false, false)
+
+static bool isLVL(const Instruction &I) {
+  if (const auto *II = dyn_cast<IntrinsicInst>(&I))
+    return II->getIntrinsicID() == Intrinsic::ve_lvl;
+  return false;
+}
+
+/// Return true if \p V is smin(End - IV, MaxVL).
+static bool isChunkLength(Value *V, Value *IV, Value *End) {
+  Value *A, *B;
+  if (!match(V, m_SMin(m_Value(A), m_Value(B))))
+    return false;
+  if (match(A, m_SpecificInt(MaxVL)))
+    std::swap(A, B);
+  return match(B, m_SpecificInt(MaxVL)) &&
+         match(A, m_Sub(m_Specific(End), m_Specific(IV)));
+}
+
+bool VEChunkLoopOpt::analyzeLoop(Loop *L, ChunkLoop &CL) {
+  CL.L = L;
+  BasicBlock *Header = L->getHeader();
+  BasicBlock *Latch = L->getLoopLatch();
+  if (!L->empty() || !L->isLoopSimplifyForm() || !Latch ||
+      L->getExitingBlock() != Latch || !L->getUniqueExitBlock())
+    return false;
+
+  // Collect LVLs.  Any other call might change VL behind our back.
+  for (BasicBlock *BB : L->blocks()) {
+    for (Instruction &I : *BB) {
+      if (isLVL(I)) {
+        CL.LVLs.push_back(cast<IntrinsicInst>(&I));
+        continue;
+      }
+      // Memory intrinsics may be lowered to code which sets VL.
+      if ((isa<CallInst>(I) || isa<InvokeInst>(I)) &&
+          (!isa<IntrinsicInst>(I) || isa<MemIntrinsic>(I)))
+        return false;
+    }
+  }
+  if (CL.LVLs.empty())
+    return false;
+  CL.VL = CL.LVLs.front()->getArgOperand(0);
+  for (IntrinsicInst *LVL : CL.LVLs)
+    if (LVL->getArgOperand(0) != CL.VL)
+      return false;
+
+  // The latch must be "br (icmp IV.next, End), Header, Exit".
+  auto *BI = dyn_cast<BranchInst>(Latch->getTerminator());
+  if (!BI || !BI->isConditional())
+    return false;
+  auto *Cmp = dyn_cast<ICmpInst>(BI->getCondition());
+  if (!Cmp)
+    return false;
+  Value *Next = Cmp->getOperand(0);
+  CL.End = Cmp->getOperand(1);
+  CL.Pred = Cmp->getPredicate();
+  if (!L->isLoopInvariant(CL.End)) {
+    std::swap(Next, CL.End);
+    CL.Pred = Cmp->getSwappedPredicate();
+  }
+  if (BI->getSuccessor(0) != Header)
+    CL.Pred = CmpInst::getInversePredicate(CL.Pred);
+  if (!L->isLoopInvariant(CL.End) ||
+      (CL.Pred != ICmpInst::ICMP_SLT && CL.Pred != ICmpInst::ICMP_ULT &&
+       CL.Pred != ICmpInst::ICMP_NE))
+    return false;
+
+  CL.IV = nullptr;
+  for (PHINode &PN : Header->phis()) {
+    if (PN.getIncomingValueForBlock(Latch) == Next &&
+        match(Next, m_Add(m_Specific(&PN), m_SpecificInt(MaxVL)))) {
+      CL.IV = &PN;
+      break;
+    }
+  }
+  if (!CL.IV)
+    return false;
+  CL.Start = CL.IV->getIncomingValueForBlock(L->getLoopPreheader());
+
+  // LVL takes an i32, so the chunk length may be truncated on the way.
+  CL.Len = CL.VL;
+  if (auto *Trunc = dyn_cast<TruncInst>(CL.VL))
+    CL.Len = Trunc->getOperand(0);
+  return isChunkLength(CL.Len, CL.IV, CL.End);
+}
+
+bool VEChunkLoopOpt::removeRedundantLVLs(ChunkLoop &CL) {
+  // All LVLs set the same value and nothing else in the loop changes VL, so
+  // an LVL dominated by another one is redundant.
+  SmallVector<IntrinsicInst *, 4> Kept, Dead;
+  for (IntrinsicInst *LVL : CL.LVLs) {
+    bool Dominated = false;
+    for (IntrinsicInst *Other : CL.LVLs)
+      if (Other != LVL && DT->dominates(Other, LVL)) {
+        Dominated = true;
+        break;
+      }
+    (Dominated ? Dead : Kept).push_back(LVL);
+  }
+  for (IntrinsicInst *LVL : Dead)
+    LVL->eraseFromParent();
+  NumLVLRemoved += Dead.size();
+  CL.LVLs = Kept;
+  return !Dead.empty();
+}
+
+/// Turn the loop with preheader \p Preheader into one processing only full
+/// chunks: the chunk length is the constant MaxVL and VL is set once before
+/// the loop.
+void VEChunkLoopOpt::makeFullChunks(ChunkLoop &CL, Value *Len, Value *VL,
+                                 ArrayRef<IntrinsicInst *> LVLs,
+                                 BasicBlock *Preheader) {
+  Function *LVLFn = LVLs.front()->getCalledFunction();
+  IRBuilder<> Builder(Preheader->getTerminator());
+  Builder.CreateCall(LVLFn, Builder.getInt32(MaxVL));
+  for (IntrinsicInst *LVL : LVLs)
+    LVL->eraseFromParent();
+
+  VL->replaceAllUsesWith(ConstantInt::get(VL->getType(), MaxVL));
+  if (Len != VL)
+    Len->replaceAllUsesWith(ConstantInt::get(Len->getType(), MaxVL));
+}
+
+void VEChunkLoopOpt::versionLoop(ChunkLoop &CL) {
+  Loop *L = CL.L;
+  BasicBlock *Latch = L->getLoopLatch();
+  BasicBlock *Exit = L->getUniqueExitBlock();
+
+  // Give the loop a fresh preheader so that the old one can hold the check.
+  BasicBlock *CheckBB = L->getLoopPreheader();
+  BasicBlock *Preheader =
+      SplitBlock(CheckBB, CheckBB->getTerminator(), DT, LI);
+  Preheader->setName(CheckBB->getName() + ".vl");
+
+  // Every chunk is full if the loop runs and End - Start is a multiple of
+  // MaxVL.
+  IRBuilder<> Builder(CheckBB->getTerminator());
+  Value *Runs;
+  switch (CL.Pred) {
+  default: llvm_unreachable("Unexpected loop predicate");
+  case ICmpInst::ICMP_SLT: Runs = Builder.CreateICmpSGT(CL.End, CL.Start); break;
+  case ICmpInst::ICMP_ULT: Runs = Builder.CreateICmpUGT(CL.End, CL.Start); break;
+  case ICmpInst::ICMP_NE:  Runs = Builder.CreateICmpNE(CL.End, CL.Start); break;
+  }
+  Value *Rem = Builder.CreateAnd(Builder.CreateSub(CL.End, CL.Start),
+                                 MaxVL - 1);
+  Value *Full = Builder.CreateAnd(
+      Runs, Builder.CreateICmpEQ(Rem, ConstantInt::get(Rem->getType(), 0)),
+      "vl.full");
+
+  if (auto *C = dyn_cast<ConstantInt>(Full)) {
+    // The check folded, so there is no need for two versions.
+    if (C->isOne())
+      makeFullChunks(CL, CL.Len, CL.VL, CL.LVLs, Preheader);
+    return;
+  }
+
+  ValueToValueMapTy VMap;
+  SmallVector<BasicBlock *, 8> Blocks;
+  Loop *FullL = cloneLoopWithPreheader(Preheader, CheckBB, L, VMap, ".vl256",
+                                       LI, DT, Blocks);
+  remapInstructionsInBlocks(Blocks, VMap);
+
+  // The loop is in LCSSA form, so values live out of it flow through the
+  // PHIs of the exit block.
+  BasicBlock *FullLatch = cast<BasicBlock>(VMap[Latch]);
+  for (PHINode &PN : Exit->phis()) {
+    Value *V = PN.getIncomingValueForBlock(Latch);
+    if (Value *NewV = VMap.lookup(V))
+      V = NewV;
+    PN.addIncoming(V, FullLatch);
+  }
+
+  BasicBlock *FullPreheader = FullL->getLoopPreheader();
+  CheckBB->getTerminator()->eraseFromParent();
+  BranchInst::Create(FullPreheader, Preheader, Full, CheckBB);
+  DT->changeImmediateDominator(Exit, CheckBB);
+
+  SmallVector<IntrinsicInst *, 4> FullLVLs;
+  for (IntrinsicInst *LVL : CL.LVLs)
+    FullLVLs.push_back(cast<IntrinsicInst>(VMap[LVL]));
+  makeFullChunks(CL, VMap[CL.Len], VMap[CL.VL], FullLVLs, FullPreheader);
+  ++NumLoopsVersioned;
+}
+
+bool VEChunkLoopOpt::runOnFunction(Function &F) {
+  if (skipFunction(F))
+    return false;
+
+  DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+  LI = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+
+  SmallVector<ChunkLoop, 4> Candidates;
+  for (Loop *L : LI->getLoopsInPreorder()) {
+    ChunkLoop CL;
+    if (analyzeLoop(L, CL))
+      Candidates.push_back(CL);
+  }
+
+  bool Changed = false;
+  for (ChunkLoop &CL : Candidates) {
+    LLVM_DEBUG(dbgs() << "VE chunk loop: " << *CL.L);
+    Changed |= removeRedundantLVLs(CL);
+    if (!DisableVersioning) {
+      versionLoop(CL);
+      Changed = true;
+    }
+  }
+  return Changed;
+}
+
+/// createVEChunkLoopOptPass - Returns a pass that optimizes loops processing
+/// VL-sized chunks with VE intrinsics.
+///
+FunctionPass *llvm::createVEChunkLoopOptPass() {
+  return new VEChunkLoopOpt();
+}
@@ -46,6 +46,8 @@ public:
   // Complex Pattern Selectors.
   bool SelectADDRrr(SDValue N, SDValue &R1, SDValue &R2);
   bool SelectADDRri(SDValue N, SDValue &Base, SDValue &Offset);
+  bool SelectADDRrri(SDValue N, SDValue &Base, SDValue &Index,
+                     SDValue &Offset);
 
   /// SelectInlineAsmMemoryOperand - Implement addressing mode selection for
   /// inline asm expressions.
@@ -145,6 +147,50 @@ bool VEDAGToDAGISel::SelectADDRrr(SDValue Addr, SDValue &R1, SDValue &R2) {
 #endif
 }
 
+// Returns true if N is (a part of) the hi/lo pair addressing a symbol, which
+// the reg+imm pattern handles.
+static bool isSymbolAddress(SDValue N) {
+  auto IsHiLo = [](SDValue V) {
+    return V.getOpcode() == VEISD::Hi || V.getOpcode() == VEISD::Lo;
+  };
+  if (N.getOpcode() == ISD::ADD)
+    return IsHiLo(N.getOperand(0)) || IsHiLo(N.getOperand(1));
+  return IsHiLo(N);
+}
+
+/// SelectADDRrri - Match base + index + disp for the full ASX format, i.e.
+/// disp(index, base), which saves computing base + index separately.
+bool VEDAGToDAGISel::SelectADDRrri(SDValue Addr, SDValue &Base,
+                                   SDValue &Index, SDValue &Offset) {
+  if (Addr.getOpcode() != ISD::ADD)
+    return false;
+
+  SDValue Sum = Addr;
+  int64_t Disp = 0;
+  if (ConstantSDNode *CN = dyn_cast<ConstantSDNode>(Addr.getOperand(1))) {
+    // Let the reg+imm pattern catch reg + imm.
+    if (!isInt<32>(CN->getSExtValue()) ||
+        Addr.getOperand(0).getOpcode() != ISD::ADD)
+      return false;
+    Sum = Addr.getOperand(0);
+    Disp = CN->getSExtValue();
+  }
+
+  SDValue LHS = Sum.getOperand(0);
+  SDValue RHS = Sum.getOperand(1);
+  if (isa<ConstantSDNode>(LHS) || isa<ConstantSDNode>(RHS))
+    return false;
+  // eliminateFrameIndex expects a frame index to be followed by its offset.
+  if (isa<FrameIndexSDNode>(LHS) || isa<FrameIndexSDNode>(RHS))
+    return false;
+  if (isSymbolAddress(LHS) || isSymbolAddress(RHS))
+    return false;
+
+  Base = LHS;
+  Index = RHS;
+  Offset = CurDAG->getTargetConstant(Disp, SDLoc(Addr), MVT::i32);
+  return true;
+}
 
 // Re-assemble i64 arguments split up in SelectionDAGBuilder's
 // visitInlineAsm / GetRegistersForValue functions.
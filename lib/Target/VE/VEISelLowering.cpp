@@ -34,18 +34,36 @@
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Intrinsics.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/KnownBits.h"
+#include <cmath>
 using namespace llvm;
 
 #define DEBUG_TYPE "ve-lower"
 
+static cl::opt<unsigned> PrefetchLines(
+    "ve-prefetch-lines", cl::Hidden, cl::init(16),
+    cl::desc("Number of consecutive cache lines fetched by a data prefetch "
+             "on VE.  More than one line uses a vector prefetch (pfchv)."));
+
 //===----------------------------------------------------------------------===//
 // Calling Convention Implementation
 //===----------------------------------------------------------------------===//
 
 #include "VEGenCallingConv.inc"
 
+CCAssignFn *VETargetLowering::CCAssignFnForCall(CallingConv::ID CC,
+                                                bool IsVarArg) const {
+  // Variadic calls additionally copy every argument to memory using CC_VE2,
+  // see LowerCall_64.  The register assignment itself is always CC_VE.
+  return CC_VE;
+}
+
+CCAssignFn *VETargetLowering::CCAssignFnForReturn(CallingConv::ID CC) const {
+  return RetCC_VE;
+}
+
 bool
 VETargetLowering::CanLowerReturn(CallingConv::ID CallConv, MachineFunction &MF,
                                  bool isVarArg,
@@ -743,9 +761,16 @@ VETargetLowering::LowerCall(TargetLowering::CallLoweringInfo &CLI,
   // Turn GlobalAddress/ExternalSymbol node into a value node
   // containing the address of them here.
   if (GlobalAddressSDNode *G = dyn_cast<GlobalAddressSDNode>(Callee)) {
-    if (IsPICCall) {
-      if (UsePlt)
-        Subtarget->getInstrInfo()->getGlobalBaseReg(&MF);
+    if (IsPICCall && !UsePlt) {
+      // A dso_local callee is called directly through its GOT-relative
+      // address.  Unlike GETFUNPLT, this needs no sic, so the address is
+      // hoisted and CSE'd like any other.
+      SDValue HiLo = makeHiLoPair(Callee, VEMCExpr::VK_VE_GOTOFF_HI32,
+                                  VEMCExpr::VK_VE_GOTOFF_LO32, DAG);
+      SDValue GlobalBase = DAG.getNode(VEISD::GLOBAL_BASE_REG, DL, PtrVT);
+      Callee = DAG.getNode(ISD::ADD, DL, PtrVT, GlobalBase, HiLo);
+    } else if (IsPICCall) {
+      Subtarget->getInstrInfo()->getGlobalBaseReg(&MF);
       Callee = DAG.getTargetGlobalAddress(G->getGlobal(), DL, PtrVT, 0, 0);
       Callee = DAG.getNode(VEISD::GETFUNPLT, DL, PtrVT, Callee);
     } else {
@@ -1043,10 +1068,12 @@ VETargetLowering::VETargetLowering(const TargetMachine &TM,
   // VE doesn't have BRCOND
   setOperationAction(ISD::BRCOND, MVT::Other, Expand);
 
-  // BRIND/BR_JT are not implemented yet.
-  //   FIXME: BRIND instruction is implemented, but JumpTable is not yet.
-  setOperationAction(ISD::BRIND,  MVT::Other, Expand);
-  setOperationAction(ISD::BR_JT,  MVT::Other, Expand);
+  // Jump tables are lowered to a load of the entry followed by BRIND.
+  setOperationAction(ISD::BRIND,  MVT::Other, Legal);
+  setOperationAction(ISD::BR_JT,  MVT::Other, Custom);
+
+  // Data prefetches of more than one cache line use PFCHV.
+  setOperationAction(ISD::PREFETCH, MVT::Other, Custom);
 
   setOperationAction(ISD::EH_SJLJ_SETJMP, MVT::i32, Custom);
   setOperationAction(ISD::EH_SJLJ_LONGJMP, MVT::Other, Custom);
@@ -1135,15 +1162,14 @@ VETargetLowering::VETargetLowering(const TargetMachine &TM,
   setOperationAction(ISD::FCOPYSIGN, MVT::f64, Expand);
   setOperationAction(ISD::FCOPYSIGN, MVT::f32, Expand);
 
-  // FIXME: VE's SHL_PARTS and others are not investigated yet.
+  // i32 pairs are never formed since i64 is legal.  128-bit shifts use the
+  // double shift instructions SLD and SRD.
   setOperationAction(ISD::SHL_PARTS, MVT::i32, Expand);
   setOperationAction(ISD::SRA_PARTS, MVT::i32, Expand);
   setOperationAction(ISD::SRL_PARTS, MVT::i32, Expand);
-  if (1) {
-    setOperationAction(ISD::SHL_PARTS, MVT::i64, Expand);
-    setOperationAction(ISD::SRA_PARTS, MVT::i64, Expand);
-    setOperationAction(ISD::SRL_PARTS, MVT::i64, Expand);
-  }
+  setOperationAction(ISD::SHL_PARTS, MVT::i64, Custom);
+  setOperationAction(ISD::SRA_PARTS, MVT::i64, Custom);
+  setOperationAction(ISD::SRL_PARTS, MVT::i64, Custom);
 
   // Expands to [SU]MUL_LOHI.
   setOperationAction(ISD::MULHU,     MVT::i32, Expand);
@@ -1191,12 +1217,12 @@ VETargetLowering::VETargetLowering(const TargetMachine &TM,
   setOperationAction(ISD::CTPOP, MVT::i64, Legal);
   setOperationAction(ISD::CTLZ , MVT::i32, Legal);
   setOperationAction(ISD::CTLZ , MVT::i64, Legal);
-  setOperationAction(ISD::CTTZ , MVT::i32, Expand);
-  setOperationAction(ISD::CTTZ , MVT::i64, Expand);
+  setOperationAction(ISD::CTTZ , MVT::i32, Legal);
+  setOperationAction(ISD::CTTZ , MVT::i64, Legal);
   setOperationAction(ISD::ROTL , MVT::i32, Expand);
-  setOperationAction(ISD::ROTL , MVT::i64, Expand);
+  setOperationAction(ISD::ROTL , MVT::i64, Legal);
   setOperationAction(ISD::ROTR , MVT::i32, Expand);
-  setOperationAction(ISD::ROTR , MVT::i64, Expand);
+  setOperationAction(ISD::ROTR , MVT::i64, Legal);
 
   // VASTART needs to be custom lowered to use the VarArgsFrameIndex.
   setOperationAction(ISD::VASTART           , MVT::Other, Custom);
@@ -1311,8 +1337,13 @@ VETargetLowering::VETargetLowering(const TargetMachine &TM,
 
       setOperationAction(ISD::MLOAD, VT, Custom);
 
-      // VE doesn't have instructions for fp<->uint, so expand them by llvm
-      if (VT.getVectorElementType() == MVT::i32) {
+      // VE doesn't have instructions for fp<->uint.  256-element vectors
+      // are converted through v256i64 in LowerFP_TO_UINT/LowerUINT_TO_FP,
+      // and others are expanded by llvm.
+      if (VT == MVT::v256i32 || VT == MVT::v256i64) {
+        setOperationAction(ISD::FP_TO_UINT, VT, Custom);
+        setOperationAction(ISD::UINT_TO_FP, VT, Custom);
+      } else if (VT.getVectorElementType() == MVT::i32) {
         setOperationAction(ISD::FP_TO_UINT, VT, Promote); // use i64
         setOperationAction(ISD::UINT_TO_FP, VT, Promote); // use i64
       } else {
@@ -1322,6 +1353,19 @@ VETargetLowering::VETargetLowering(const TargetMachine &TM,
     }
   }
 
+  // Loads of v256i8 are promoted to extending loads, which
+  // LowerVectorExtLoad gathers from aligned words.  v256i16 has no MVT, so
+  // its extending loads can't be customized and are still expanded.
+  for (MVT VT : { MVT::v256i32, MVT::v256i64 }) {
+    setLoadExtAction(ISD::EXTLOAD, VT, MVT::v256i8, Custom);
+    setLoadExtAction(ISD::SEXTLOAD, VT, MVT::v256i8, Custom);
+    setLoadExtAction(ISD::ZEXTLOAD, VT, MVT::v256i8, Custom);
+  }
+
+  // Floating-point vectors are converted in registers by vcvt.
+  setLoadExtAction(ISD::EXTLOAD, MVT::v256f64, MVT::v256f32, Expand);
+  setTruncStoreAction(MVT::v256f64, MVT::v256f32, Expand);
+
   // VE has no packed MUL, SDIV, or UDIV operations.
   for (MVT VT : { MVT::v512i32, MVT::v512f32 }) {
     setOperationAction(ISD::MUL,   VT, Expand);
@@ -1341,8 +1385,10 @@ VETargetLowering::VETargetLowering(const TargetMachine &TM,
   setOperationAction(ISD::FADD,  MVT::f128, Legal);
   setOperationAction(ISD::FSUB,  MVT::f128, Legal);
   setOperationAction(ISD::FMUL,  MVT::f128, Legal);
-  setOperationAction(ISD::FDIV,  MVT::f128, Expand);
-  setOperationAction(ISD::FSQRT, MVT::f128, Expand);
+  // FDIV and FSQRT are lowered to Newton-Raphson iterations under fast-math
+  // flags, and to library calls otherwise.
+  setOperationAction(ISD::FDIV,  MVT::f128, Custom);
+  setOperationAction(ISD::FSQRT, MVT::f128, Custom);
   setOperationAction(ISD::FP_EXTEND, MVT::f128, Legal);
   setOperationAction(ISD::FP_ROUND,  MVT::f128, Legal);
 
@@ -1407,6 +1453,8 @@ const char *VETargetLowering::getTargetNodeName(unsigned Opcode) const {
   case VEISD::MIN:             return "VEISD::MIN";
   case VEISD::FMAX:            return "VEISD::FMAX";
   case VEISD::FMIN:            return "VEISD::FMIN";
+  case VEISD::SLD:             return "VEISD::SLD";
+  case VEISD::SRD:             return "VEISD::SRD";
   case VEISD::GETFUNPLT:       return "VEISD::GETFUNPLT";
   case VEISD::GETSTACKTOP:     return "VEISD::GETSTACKTOP";
   case VEISD::GETTLSADDR:      return "VEISD::GETTLSADDR";
@@ -1421,6 +1469,8 @@ const char *VETargetLowering::getTargetNodeName(unsigned Opcode) const {
   case VEISD::VEC_VMV:         return "VEISD::VEC_VMV";
   case VEISD::VEC_SCATTER:     return "VEISD::VEC_SCATTER";
   case VEISD::VEC_GATHER:      return "VEISD::VEC_GATHER";
+  case VEISD::VEC_VLD:         return "VEISD::VEC_VLD";
+  case VEISD::VEC_VST:         return "VEISD::VEC_VST";
   case VEISD::Wrapper:         return "VEISD::Wrapper";
   case VEISD::INT_LVM:         return "VEISD::INT_LVM";
   case VEISD::INT_SVM:         return "VEISD::INT_SVM";
@@ -1842,6 +1892,9 @@ SDValue VETargetLowering::withTargetFlags(SDValue Op, unsigned TF,
     return DAG.getTargetExternalSymbol(ES->getSymbol(),
                                        ES->getValueType(0), TF);
 
+  if (const JumpTableSDNode *JT = dyn_cast<JumpTableSDNode>(Op))
+    return DAG.getTargetJumpTable(JT->getIndex(), JT->getValueType(0), TF);
+
   llvm_unreachable("Unhandled address SDNode");
 }
 
@@ -1858,7 +1911,7 @@ SDValue VETargetLowering::makeHiLoPair(SDValue Op,
 }
 
 // Build SDNodes for producing an address from a GlobalAddress, ConstantPool,
-// or ExternalSymbol SDNode.
+// JumpTable, or ExternalSymbol SDNode.
 SDValue VETargetLowering::makeAddress(SDValue Op, SelectionDAG &DAG) const {
   SDLoc DL(Op);
   EVT VT = getPointerTy(DAG.getDataLayout());
@@ -1871,6 +1924,7 @@ SDValue VETargetLowering::makeAddress(SDValue Op, SelectionDAG &DAG) const {
     MFI.setHasCalls(true);
 
     if (dyn_cast<ConstantPoolSDNode>(Op) != nullptr ||
+        dyn_cast<JumpTableSDNode>(Op) != nullptr ||
         (dyn_cast<GlobalAddressSDNode>(Op) != nullptr &&
          dyn_cast<GlobalAddressSDNode>(Op)->getGlobal()->hasLocalLinkage())) {
       // Create following instructions for local linkage PIC code.
@@ -1878,7 +1932,9 @@ SDValue VETargetLowering::makeAddress(SDValue Op, SelectionDAG &DAG) const {
       //     and %s35, %s35, (32)0
       //     lea.sl %s35, %gotoff_hi(.LCPI0_0)(%s35)
       //     adds.l %s35, %s15, %s35                  ; %s15 is GOT
-      // FIXME: use lea.sl %s35, %gotoff_hi(.LCPI0_0)(%s35, %s15)
+      // The last two are combined into
+      //     lea.sl %s35, %gotoff_hi(.LCPI0_0)(%s15, %s35)
+      // by instruction selection.
       SDValue HiLo = makeHiLoPair(Op, VEMCExpr::VK_VE_GOTOFF_HI32,
                                   VEMCExpr::VK_VE_GOTOFF_LO32, DAG);
       SDValue GlobalBase = DAG.getNode(VEISD::GLOBAL_BASE_REG, DL, VT);
@@ -1890,13 +1946,18 @@ SDValue VETargetLowering::makeAddress(SDValue Op, SelectionDAG &DAG) const {
       //     lea.sl %s35, %got_hi(.LCPI0_0)(%s35)
       //     adds.l %s35, %s15, %s35                  ; %s15 is GOT
       //     ld     %s35, (,%s35)
-      // FIXME: use lea.sl %s35, %gotoff_hi(.LCPI0_0)(%s35, %s15)
+      // The lea.sl and adds.l are combined as above.
       SDValue HiLo = makeHiLoPair(Op, VEMCExpr::VK_VE_GOT_HI32,
                                   VEMCExpr::VK_VE_GOT_LO32, DAG);
       SDValue GlobalBase = DAG.getNode(VEISD::GLOBAL_BASE_REG, DL, VT);
       SDValue AbsAddr = DAG.getNode(ISD::ADD, DL, VT, GlobalBase, HiLo);
+      // GOT entries never change, so let MachineLICM and MachineCSE hoist
+      // and share the loads across the function.
       return DAG.getLoad(VT, DL, DAG.getEntryNode(), AbsAddr,
-                         MachinePointerInfo::getGOT(DAG.getMachineFunction()));
+                         MachinePointerInfo::getGOT(DAG.getMachineFunction()),
+                         /* Alignment */ 8,
+                         MachineMemOperand::MODereferenceable |
+                             MachineMemOperand::MOInvariant);
     }
   }
 
@@ -1928,6 +1989,74 @@ SDValue VETargetLowering::LowerBlockAddress(SDValue Op,
   return makeAddress(Op, DAG);
 }
 
+SDValue VETargetLowering::LowerBR_JT(SDValue Op, SelectionDAG &DAG) const {
+  SDLoc dl(Op);
+  SDValue Chain = Op.getOperand(0);
+  SDValue Table = Op.getOperand(1);
+  SDValue Index = Op.getOperand(2);
+  EVT PtrVT = getPointerTy(DAG.getDataLayout());
+  MachineFunction &MF = DAG.getMachineFunction();
+  const MachineJumpTableInfo *MJTI = MF.getJumpTableInfo();
+  unsigned EntrySize = MJTI->getEntrySize(DAG.getDataLayout());
+
+  // Load the entry from the jump table.
+  SDValue Base = makeAddress(Table, DAG);
+  Index = DAG.getNode(ISD::SHL, dl, PtrVT, Index,
+                      DAG.getConstant(Log2_32(EntrySize), dl, PtrVT));
+  SDValue Addr = DAG.getNode(ISD::ADD, dl, PtrVT, Base, Index);
+  SDValue Target;
+  if (MJTI->getEntryKind() == MachineJumpTableInfo::EK_Custom32) {
+    // Each entry holds the offset of the block from the function (see
+    // LowerCustomJumpTableEntry), so add the address of the function.
+    //     ldl.zx %Off, (%Base, %Index)
+    //     lea %Tmp1, fun@gotoff_lo
+    //     and %Tmp2, %Tmp1, (32)0
+    //     lea.sl %Fun, fun@gotoff_hi(%s15, %Tmp2)   ; %s15 is GOT
+    //     adds.l %Target, %Fun, %Off
+    SDValue Offset = DAG.getExtLoad(
+        ISD::ZEXTLOAD, dl, PtrVT, Chain, Addr,
+        MachinePointerInfo::getJumpTable(MF), MVT::i32);
+    Chain = Offset.getValue(1);
+    SDValue Fun = DAG.getGlobalAddress(&MF.getFunction(), dl, PtrVT);
+    SDValue HiLo = makeHiLoPair(Fun, VEMCExpr::VK_VE_GOTOFF_HI32,
+                                VEMCExpr::VK_VE_GOTOFF_LO32, DAG);
+    SDValue GlobalBase = DAG.getNode(VEISD::GLOBAL_BASE_REG, dl, PtrVT);
+    Target = DAG.getNode(ISD::ADD, dl, PtrVT,
+                         DAG.getNode(ISD::ADD, dl, PtrVT, GlobalBase, HiLo),
+                         Offset);
+  } else {
+    assert(MJTI->getEntryKind() == MachineJumpTableInfo::EK_BlockAddress &&
+           "Unexpected jump table encoding");
+    Target = DAG.getLoad(PtrVT, dl, Chain, Addr,
+                         MachinePointerInfo::getJumpTable(MF));
+    Chain = Target.getValue(1);
+  }
+  return DAG.getNode(ISD::BRIND, dl, MVT::Other, Chain, Target);
+}
+
+SDValue VETargetLowering::LowerPREFETCH(SDValue Op, SelectionDAG &DAG) const {
+  // VE has no instruction prefetch, so drop it.  A single line prefetch is
+  // selected to PFCH.
+  bool IsData = cast<ConstantSDNode>(Op.getOperand(4))->getZExtValue();
+  if (!IsData)
+    return Op.getOperand(0);
+  if (PrefetchLines <= 1)
+    return Op;
+
+  // Otherwise, fetch PrefetchLines consecutive lines by a vector prefetch
+  // with the line size as stride.
+  //   lea %vl, PrefetchLines
+  //   lvl %vl
+  //   pfchv 128, %addr
+  SDLoc dl(Op);
+  unsigned NumLines = std::min(PrefetchLines.getValue(), 256u);
+  SDValue Ops[] = {
+      Op.getOperand(0),
+      DAG.getConstant(Subtarget->getCacheLineSize(), dl, MVT::i64),
+      Op.getOperand(1), DAG.getConstant(NumLines, dl, MVT::i32)};
+  return DAG.getNode(VEISD::INT_PFCHV, dl, MVT::Other, Ops);
+}
+
 SDValue VETargetLowering::LowerToTLSGeneralDynamicModel(
   SDValue Op, SelectionDAG &DAG) const {
   SDLoc dl(Op);
@@ -2217,24 +2346,24 @@ static SDValue LowerF128Load(SDValue Op, SelectionDAG &DAG)
     return Op;
   }
 
-  unsigned alignment = LdNode->getAlignment();
-  if (alignment > 8)
-    alignment = 8;
+  // Both halves keep the flags and alias info of the original access, and
+  // the upper half is described at offset 8 so that alias analysis and the
+  // load clustering in the machine scheduler see two adjacent accesses.
+  unsigned alignment = std::min(LdNode->getAlignment(), 8u);
+  MachineMemOperand::Flags MMOFlags = LdNode->getMemOperand()->getFlags();
 
   SDValue Lo64 =
       DAG.getLoad(MVT::f64, dl, LdNode->getChain(), LdNode->getBasePtr(),
-                  LdNode->getPointerInfo(), alignment,
-                  LdNode->isVolatile() ? MachineMemOperand::MOVolatile :
-                                         MachineMemOperand::MONone);
+                  LdNode->getPointerInfo(), alignment, MMOFlags,
+                  LdNode->getAAInfo());
   EVT addrVT = LdNode->getBasePtr().getValueType();
   SDValue HiPtr = DAG.getNode(ISD::ADD, dl, addrVT,
                               LdNode->getBasePtr(),
                               DAG.getConstant(8, dl, addrVT));
   SDValue Hi64 =
       DAG.getLoad(MVT::f64, dl, LdNode->getChain(), HiPtr,
-                  LdNode->getPointerInfo(), alignment,
-                  LdNode->isVolatile() ? MachineMemOperand::MOVolatile :
-                                         MachineMemOperand::MONone);
+                  LdNode->getPointerInfo().getWithOffset(8),
+                  MinAlign(alignment, 8), MMOFlags, LdNode->getAAInfo());
 
   SDValue SubRegEven = DAG.getTargetConstant(VE::sub_even, dl, MVT::i32);
   SDValue SubRegOdd  = DAG.getTargetConstant(VE::sub_odd, dl, MVT::i32);
@@ -2259,6 +2388,56 @@ static SDValue LowerF128Load(SDValue Op, SelectionDAG &DAG)
   return DAG.getMergeValues(Ops, dl);
 }
 
+// Lower an extending load of i8/i16 vector elements.  VE has no vector load
+// for sub-word elements, so gather the aligned 8-byte word holding each
+// element and shift the element down.  Only words containing loaded bytes
+// are accessed.
+static SDValue LowerVectorExtLoad(SDValue Op, SelectionDAG &DAG)
+{
+  SDLoc dl(Op);
+  LoadSDNode *LdNode = cast<LoadSDNode>(Op.getNode());
+  EVT VT = Op.getValueType();
+  unsigned EltBits = LdNode->getMemoryVT().getScalarSizeInBits();
+  MVT WideVT = MVT::v256i64;
+
+  auto Splat = [&](uint64_t Val) {
+    return DAG.getNode(VEISD::VEC_BROADCAST, dl, WideVT,
+                       DAG.getConstant(Val, dl, MVT::i64));
+  };
+
+  // Byte address of each element.
+  SDValue Addr = DAG.getNode(VEISD::VEC_SEQ, dl, WideVT,
+                             DAG.getConstant(1, dl, MVT::i64));
+  if (EltBits > 8)
+    Addr = DAG.getNode(ISD::SHL, dl, WideVT, Addr, Splat(Log2_32(EltBits / 8)));
+  Addr = DAG.getNode(ISD::ADD, dl, WideVT, Addr,
+                     DAG.getNode(VEISD::VEC_BROADCAST, dl, WideVT,
+                                 LdNode->getBasePtr()));
+
+  SDValue Words = DAG.getNode(ISD::AND, dl, WideVT, Addr, Splat(~7ULL));
+  SDValue Shift = DAG.getNode(ISD::SHL, dl, WideVT,
+                              DAG.getNode(ISD::AND, dl, WideVT, Addr, Splat(7)),
+                              Splat(3));
+  SDValue Load = DAG.getNode(VEISD::VEC_GATHER, dl,
+                             DAG.getVTList(WideVT, MVT::Other),
+                             {LdNode->getChain(), Words});
+
+  // VE is little endian, so the element starts at bit 8 * (Addr & 7).
+  SDValue Val = DAG.getNode(ISD::SRL, dl, WideVT, Load, Shift);
+  if (LdNode->getExtensionType() == ISD::SEXTLOAD) {
+    SDValue Amt = Splat(64 - EltBits);
+    Val = DAG.getNode(ISD::SRA, dl, WideVT,
+                      DAG.getNode(ISD::SHL, dl, WideVT, Val, Amt), Amt);
+  } else {
+    Val = DAG.getNode(ISD::AND, dl, WideVT, Val, Splat((1ULL << EltBits) - 1));
+  }
+  if (VT != WideVT)
+    Val = DAG.getNode(ISD::TRUNCATE, dl, VT, Val);
+
+  SDValue Ops[2] = {Val, Load.getValue(1)};
+  return DAG.getMergeValues(Ops, dl);
+}
+
 static SDValue LowerLOAD(SDValue Op, SelectionDAG &DAG)
 {
   LoadSDNode *LdNode = cast<LoadSDNode>(Op.getNode());
@@ -2267,6 +2446,9 @@ static SDValue LowerLOAD(SDValue Op, SelectionDAG &DAG)
   if (MemVT == MVT::f128)
     return LowerF128Load(Op, DAG);
 
+  if (MemVT.isVector() && LdNode->getExtensionType() != ISD::NON_EXTLOAD)
+    return LowerVectorExtLoad(Op, DAG);
+
   return Op;
 }
 
@@ -2298,26 +2480,24 @@ static SDValue LowerF128Store(SDValue Op, SelectionDAG &DAG) {
                                     StNode->getValue(),
                                     SubRegOdd);
 
-  unsigned alignment = StNode->getAlignment();
-  if (alignment > 8)
-    alignment = 8;
+  // See LowerF128Load for the memory operands of the halves.
+  unsigned alignment = std::min(StNode->getAlignment(), 8u);
+  MachineMemOperand::Flags MMOFlags = StNode->getMemOperand()->getFlags();
 
   // VE stores Hi64 to 8(addr) and Lo64 to 0(addr)
   SDValue OutChains[2];
   OutChains[0] =
       DAG.getStore(StNode->getChain(), dl, SDValue(Lo64, 0),
-                   StNode->getBasePtr(), MachinePointerInfo(), alignment,
-                   StNode->isVolatile() ? MachineMemOperand::MOVolatile :
-                                          MachineMemOperand::MONone);
+                   StNode->getBasePtr(), StNode->getPointerInfo(), alignment,
+                   MMOFlags, StNode->getAAInfo());
   EVT addrVT = StNode->getBasePtr().getValueType();
   SDValue HiPtr = DAG.getNode(ISD::ADD, dl, addrVT,
                               StNode->getBasePtr(),
                               DAG.getConstant(8, dl, addrVT));
   OutChains[1] =
       DAG.getStore(StNode->getChain(), dl, SDValue(Hi64, 0), HiPtr,
-                   MachinePointerInfo(), alignment,
-                   StNode->isVolatile() ? MachineMemOperand::MOVolatile :
-                                          MachineMemOperand::MONone);
+                   StNode->getPointerInfo().getWithOffset(8),
+                   MinAlign(alignment, 8), MMOFlags, StNode->getAAInfo());
   return DAG.getNode(ISD::TokenFactor, dl, MVT::Other, OutChains);
 }
 
@@ -2333,6 +2513,336 @@ static SDValue LowerSTORE(SDValue Op, SelectionDAG &DAG)
   return SDValue();
 }
 
+// Return the upper 64 bits of an f128 value, which hold the sign and the
+// exponent, and the lower 64 bits of the significand.
+static SDValue getF128Hi(SDValue V, SelectionDAG &DAG, const SDLoc &dl) {
+  SDValue SubRegEven = DAG.getTargetConstant(VE::sub_even, dl, MVT::i32);
+  return SDValue(DAG.getMachineNode(TargetOpcode::EXTRACT_SUBREG, dl,
+                                    MVT::i64, V, SubRegEven), 0);
+}
+
+static SDValue getF128Lo(SDValue V, SelectionDAG &DAG, const SDLoc &dl) {
+  SDValue SubRegOdd = DAG.getTargetConstant(VE::sub_odd, dl, MVT::i32);
+  return SDValue(DAG.getMachineNode(TargetOpcode::EXTRACT_SUBREG, dl,
+                                    MVT::i64, V, SubRegOdd), 0);
+}
+
+static SDValue makeF128(SDValue Hi, SDValue Lo, SelectionDAG &DAG,
+                        const SDLoc &dl) {
+  SDValue SubRegEven = DAG.getTargetConstant(VE::sub_even, dl, MVT::i32);
+  SDValue SubRegOdd = DAG.getTargetConstant(VE::sub_odd, dl, MVT::i32);
+  SDNode *N = DAG.getMachineNode(TargetOpcode::IMPLICIT_DEF, dl, MVT::f128);
+  N = DAG.getMachineNode(TargetOpcode::INSERT_SUBREG, dl, MVT::f128,
+                         SDValue(N, 0), Hi, SubRegEven);
+  N = DAG.getMachineNode(TargetOpcode::INSERT_SUBREG, dl, MVT::f128,
+                         SDValue(N, 0), Lo, SubRegOdd);
+  return SDValue(N, 0);
+}
+
+static const uint64_t F128ExpMask = 0x7fff;
+static const uint64_t F128ExpBias = 0x3fff;
+
+// Return the biased exponent field of an f128 value.
+static SDValue getF128Exp(SDValue V, SelectionDAG &DAG, const SDLoc &dl) {
+  SDValue Hi = getF128Hi(V, DAG, dl);
+  return DAG.getNode(ISD::AND, dl, MVT::i64,
+                     DAG.getNode(ISD::SRL, dl, MVT::i64, Hi,
+                                 DAG.getConstant(48, dl, MVT::i64)),
+                     DAG.getConstant(F128ExpMask, dl, MVT::i64));
+}
+
+// Return V with its exponent field replaced by Exp.
+static SDValue setF128Exp(SDValue V, SDValue Exp, SelectionDAG &DAG,
+                          const SDLoc &dl) {
+  SDValue Hi = DAG.getNode(ISD::AND, dl, MVT::i64, getF128Hi(V, DAG, dl),
+                           DAG.getConstant(~(F128ExpMask << 48), dl,
+                                           MVT::i64));
+  Hi = DAG.getNode(ISD::OR, dl, MVT::i64, Hi,
+                   DAG.getNode(ISD::SHL, dl, MVT::i64, Exp,
+                               DAG.getConstant(48, dl, MVT::i64)));
+  return makeF128(Hi, getF128Lo(V, DAG, dl), DAG, dl);
+}
+
+// Return 2^E as an f128 for an unbiased exponent E of a normal number.
+static SDValue getF128Pow2(SDValue E, SelectionDAG &DAG, const SDLoc &dl) {
+  SDValue Exp = DAG.getNode(ISD::ADD, dl, MVT::i64, E,
+                            DAG.getConstant(F128ExpBias, dl, MVT::i64));
+  return makeF128(DAG.getNode(ISD::SHL, dl, MVT::i64, Exp,
+                              DAG.getConstant(48, dl, MVT::i64)),
+                  DAG.getConstant(0, dl, MVT::i64), DAG, dl);
+}
+
+// Lower f128 division to Newton-Raphson iterations on FMQ/FAQ instead of a
+// library call.  The result may be off by an ulp, so this is done only when
+// reciprocals are allowed.
+//
+// The divisor B is scaled to M = B * 2^-E in [1, 2), which lets fdiv.d
+// estimate 1/M to about 52 bits.  One iteration doubles that, and a final
+// correction of the quotient gets it to full precision:
+//     Y = Y + Y * (1 - M * Y)
+//     Q = A * Y
+//     Q = Q + (A - M * Q) * Y
+// Then Q is scaled back by 2^-E in two steps, each of them a normal number.
+//
+// Zero, infinite and NaN operands don't go through the iteration, where they
+// would turn into NaNs (inf - inf) or lose the sign of a zero.  A quotient
+// with such a divisor is A * (1/B) with 1/B exact in double precision, and
+// one with such a dividend is A * (1/M), whose only role is to give the sign.
+// Constant operands select the right form at compile time.
+static SDValue LowerF128FDIV(SDValue Op, SelectionDAG &DAG) {
+  if (!DAG.getTarget().Options.UnsafeFPMath &&
+      !Op->getFlags().hasAllowReciprocal())
+    return SDValue();
+
+  SDLoc dl(Op);
+  SDValue A = Op.getOperand(0);
+  SDValue B = Op.getOperand(1);
+  const TargetLowering &TLI = DAG.getTargetLoweringInfo();
+  EVT CCVT = TLI.getSetCCResultType(DAG.getDataLayout(), *DAG.getContext(),
+                                    MVT::i64);
+  auto FConst = [&](double V) { return DAG.getConstantFP(V, dl, MVT::f128); };
+  auto IConst = [&](uint64_t V) { return DAG.getConstant(V, dl, MVT::i64); };
+  auto FOp = [&](unsigned Opc, SDValue L, SDValue R) {
+    return DAG.getNode(Opc, dl, MVT::f128, L, R);
+  };
+  // (f128)(1.0 / (double)X)
+  auto Recip64 = [&](SDValue X) {
+    SDValue D = DAG.getNode(ISD::FP_ROUND, dl, MVT::f64, X,
+                            DAG.getIntPtrConstant(0, dl));
+    D = DAG.getNode(ISD::FDIV, dl, MVT::f64,
+                    DAG.getConstantFP(1.0, dl, MVT::f64), D);
+    return DAG.getNode(ISD::FP_EXTEND, dl, MVT::f128, D);
+  };
+
+  auto IsSpecialConst = [](SDValue V) {
+    auto *C = dyn_cast<ConstantFPSDNode>(V);
+    return C && (C->isZero() || C->isInfinity() || C->isNaN());
+  };
+
+  if (IsSpecialConst(B)) {
+    APFloat R(APFloat::IEEEquad(), 1);
+    R.divide(cast<ConstantFPSDNode>(B)->getValueAPF(),
+             APFloat::rmNearestTiesToEven);
+    return FOp(ISD::FMUL, A, DAG.getConstantFP(R, dl, MVT::f128));
+  }
+
+  // Bring denormal divisors into the normal range first.
+  SDValue IsDenorm =
+      DAG.getSetCC(dl, CCVT, getF128Exp(B, DAG, dl), IConst(0), ISD::SETEQ);
+  SDValue BS = DAG.getSelect(dl, MVT::f128, IsDenorm,
+                             FOp(ISD::FMUL, B, FConst(std::ldexp(1.0, 128))), B);
+  SDValue Exp = getF128Exp(BS, DAG, dl);
+  SDValue E = DAG.getNode(
+      ISD::SUB, dl, MVT::i64, Exp,
+      DAG.getSelect(dl, MVT::i64, IsDenorm, IConst(F128ExpBias + 128),
+                    IConst(F128ExpBias)));
+
+  SDValue M = setF128Exp(BS, IConst(F128ExpBias), DAG, dl);
+  SDValue Y = Recip64(M);
+
+  SDValue IsSpecialB = DAG.getNode(
+      ISD::OR, dl, CCVT, DAG.getSetCC(dl, CCVT, Exp, IConst(0), ISD::SETEQ),
+      DAG.getSetCC(dl, CCVT, Exp, IConst(F128ExpMask), ISD::SETEQ));
+  SDValue SpecialB = FOp(ISD::FMUL, A, Recip64(B));
+  if (IsSpecialConst(A))
+    return DAG.getSelect(dl, MVT::f128, IsSpecialB, SpecialB,
+                         FOp(ISD::FMUL, A, Y));
+
+  SDValue One = FConst(1.0);
+  Y = FOp(ISD::FADD, Y,
+          FOp(ISD::FMUL, Y, FOp(ISD::FSUB, One, FOp(ISD::FMUL, M, Y))));
+  SDValue Q = FOp(ISD::FMUL, A, Y);
+  Q = FOp(ISD::FADD, Q,
+          FOp(ISD::FMUL, FOp(ISD::FSUB, A, FOp(ISD::FMUL, M, Q)), Y));
+
+  SDValue E1 = DAG.getNode(ISD::SRA, dl, MVT::i64, E, IConst(1));
+  SDValue E2 = DAG.getNode(ISD::SUB, dl, MVT::i64, E, E1);
+  Q = FOp(ISD::FMUL, Q,
+          getF128Pow2(DAG.getNode(ISD::SUB, dl, MVT::i64, IConst(0), E1),
+                      DAG, dl));
+  Q = FOp(ISD::FMUL, Q,
+          getF128Pow2(DAG.getNode(ISD::SUB, dl, MVT::i64, IConst(0), E2),
+                      DAG, dl));
+
+  SDValue AbsHiA = DAG.getNode(ISD::AND, dl, MVT::i64, getF128Hi(A, DAG, dl),
+                               IConst(INT64_MAX));
+  SDValue IsZeroA = DAG.getSetCC(
+      dl, CCVT,
+      DAG.getNode(ISD::OR, dl, MVT::i64, AbsHiA, getF128Lo(A, DAG, dl)),
+      IConst(0), ISD::SETEQ);
+  SDValue IsSpecialA = DAG.getNode(
+      ISD::OR, dl, CCVT, IsZeroA,
+      DAG.getSetCC(dl, CCVT, getF128Exp(A, DAG, dl), IConst(F128ExpMask),
+                   ISD::SETEQ));
+  Q = DAG.getSelect(dl, MVT::f128, IsSpecialA, FOp(ISD::FMUL, A, Y), Q);
+  return DAG.getSelect(dl, MVT::f128, IsSpecialB, SpecialB, Q);
+}
+
+// Lower f128 square root to Newton-Raphson iterations on FMQ/FAQ instead of
+// a library call when approximate functions are allowed.
+//
+// The operand X is scaled to M = X * 2^-2K in [1, 4).  VE has no scalar
+// square root, so 1/sqrt(M) is estimated from the bit pattern of M in double
+// precision and refined there first.  The coupled iteration for S = sqrt(M)
+// and H = 1/(2 * sqrt(M)) and a final correction get it to full precision:
+//     R = 0.5 - S * H
+//     S = S + S * R
+//     H = H + H * R
+//     S = S + (M - S * S) * H
+// Then S is scaled back by 2^K.
+static SDValue LowerF128FSQRT(SDValue Op, SelectionDAG &DAG) {
+  if (!DAG.getTarget().Options.UnsafeFPMath &&
+      !Op->getFlags().hasApproximateFuncs())
+    return SDValue();
+
+  SDLoc dl(Op);
+  SDValue X = Op.getOperand(0);
+  const TargetLowering &TLI = DAG.getTargetLoweringInfo();
+  EVT CCVT = TLI.getSetCCResultType(DAG.getDataLayout(), *DAG.getContext(),
+                                    MVT::i64);
+  auto FConst = [&](double V) { return DAG.getConstantFP(V, dl, MVT::f128); };
+  auto DConst = [&](double V) { return DAG.getConstantFP(V, dl, MVT::f64); };
+  auto IConst = [&](uint64_t V) { return DAG.getConstant(V, dl, MVT::i64); };
+  auto FOp = [&](unsigned Opc, SDValue L, SDValue R) {
+    return DAG.getNode(Opc, dl, L.getValueType(), L, R);
+  };
+
+  // Bring denormal operands into the normal range first.
+  SDValue IsDenorm =
+      DAG.getSetCC(dl, CCVT, getF128Exp(X, DAG, dl), IConst(0), ISD::SETEQ);
+  SDValue XS = DAG.getSelect(dl, MVT::f128, IsDenorm,
+                             FOp(ISD::FMUL, X, FConst(std::ldexp(1.0, 128))), X);
+  SDValue Exp = getF128Exp(XS, DAG, dl);
+  SDValue E = DAG.getNode(
+      ISD::SUB, dl, MVT::i64, Exp,
+      DAG.getSelect(dl, MVT::i64, IsDenorm, IConst(F128ExpBias + 128),
+                    IConst(F128ExpBias)));
+  SDValue K = DAG.getNode(ISD::SRA, dl, MVT::i64, E, IConst(1));
+  SDValue M = setF128Exp(
+      XS,
+      DAG.getNode(ISD::ADD, dl, MVT::i64, IConst(F128ExpBias),
+                  DAG.getNode(ISD::AND, dl, MVT::i64, E, IConst(1))),
+      DAG, dl);
+
+  // Estimate 1/sqrt(M) to about 2^-5 from its bit pattern, and refine it
+  // to double precision: Y = Y * (1.5 - (M / 2) * Y * Y).
+  SDValue D = DAG.getNode(ISD::FP_ROUND, dl, MVT::f64, M,
+                          DAG.getIntPtrConstant(0, dl));
+  SDValue Bits = DAG.getNode(ISD::BITCAST, dl, MVT::i64, D);
+  SDValue Y = DAG.getNode(
+      ISD::BITCAST, dl, MVT::f64,
+      DAG.getNode(ISD::SUB, dl, MVT::i64, IConst(0x5fe6eb50c7b537a9ULL),
+                  DAG.getNode(ISD::SRL, dl, MVT::i64, Bits, IConst(1))));
+  SDValue HalfD = FOp(ISD::FMUL, D, DConst(0.5));
+  for (int i = 0; i < 4; ++i)
+    Y = FOp(ISD::FMUL, Y,
+            FOp(ISD::FSUB, DConst(1.5),
+                FOp(ISD::FMUL, HalfD, FOp(ISD::FMUL, Y, Y))));
+
+  SDValue YQ = DAG.getNode(ISD::FP_EXTEND, dl, MVT::f128, Y);
+  SDValue Half = FConst(0.5);
+  SDValue S = FOp(ISD::FMUL, M, YQ);
+  SDValue H = FOp(ISD::FMUL, YQ, Half);
+  SDValue R = FOp(ISD::FSUB, Half, FOp(ISD::FMUL, S, H));
+  S = FOp(ISD::FADD, S, FOp(ISD::FMUL, S, R));
+  H = FOp(ISD::FADD, H, FOp(ISD::FMUL, H, R));
+  S = FOp(ISD::FADD, S,
+          FOp(ISD::FMUL, FOp(ISD::FSUB, M, FOp(ISD::FMUL, S, S)), H));
+  S = FOp(ISD::FMUL, S, getF128Pow2(K, DAG, dl));
+
+  // Zero, negative, infinite and NaN operands.  The square root of zero,
+  // +inf and NaN is the operand itself, and that of others is NaN.
+  SDValue IsNeg = DAG.getSetCC(dl, CCVT, X, FConst(0.0), ISD::SETOLT);
+  SDValue IsSpecial = DAG.getNode(
+      ISD::OR, dl, CCVT,
+      DAG.getNode(ISD::OR, dl, CCVT,
+                  DAG.getSetCC(dl, CCVT, Exp, IConst(0), ISD::SETEQ),
+                  DAG.getSetCC(dl, CCVT, Exp, IConst(F128ExpMask),
+                               ISD::SETEQ)),
+      IsNeg);
+  SDValue NaN = DAG.getConstantFP(APFloat::getQNaN(APFloat::IEEEquad()), dl,
+                                  MVT::f128);
+  return DAG.getSelect(dl, MVT::f128, IsSpecial,
+                       DAG.getSelect(dl, MVT::f128, IsNeg, NaN, X), S);
+}
+
+// Lower FP_TO_UINT of 256-element vectors.  Values below 2^63 are converted
+// directly, and larger ones are biased by 2^63 before the conversion.
+static SDValue LowerFP_TO_UINT(SDValue Op, SelectionDAG &DAG)
+{
+  SDLoc dl(Op);
+  EVT VT = Op.getValueType();
+  SDValue Src = Op.getOperand(0);
+  MVT IntVT = MVT::v256i64;
+  MVT FPVT = MVT::v256f64;
+
+  if (Src.getValueType() != FPVT)
+    Src = DAG.getNode(ISD::FP_EXTEND, dl, FPVT, Src);
+
+  // The result fits in 32 bits, so a signed 64-bit conversion is exact.
+  if (VT != IntVT)
+    return DAG.getNode(ISD::TRUNCATE, dl, VT,
+                       DAG.getNode(ISD::FP_TO_SINT, dl, IntVT, Src));
+
+  SDValue Bias = DAG.getNode(
+      VEISD::VEC_BROADCAST, dl, FPVT,
+      DAG.getConstantFP(9223372036854775808.0, dl, MVT::f64)); // 2^63
+  SDValue SignBit = DAG.getNode(VEISD::VEC_BROADCAST, dl, IntVT,
+                                DAG.getConstant(1ULL << 63, dl, MVT::i64));
+  SDValue Small = DAG.getNode(ISD::FP_TO_SINT, dl, IntVT, Src);
+  SDValue Large = DAG.getNode(
+      ISD::XOR, dl, IntVT, SignBit,
+      DAG.getNode(ISD::FP_TO_SINT, dl, IntVT,
+                  DAG.getNode(ISD::FSUB, dl, FPVT, Src, Bias)));
+  SDValue IsSmall = DAG.getSetCC(dl, MVT::v256i1, Src, Bias, ISD::SETOLT);
+  // VE selects only floating-point vectors.
+  SDValue Res = DAG.getNode(ISD::VSELECT, dl, FPVT, IsSmall,
+                            DAG.getBitcast(FPVT, Small),
+                            DAG.getBitcast(FPVT, Large));
+  return DAG.getBitcast(IntVT, Res);
+}
+
+// Lower UINT_TO_FP of 256-element vectors.
+static SDValue LowerUINT_TO_FP(SDValue Op, SelectionDAG &DAG)
+{
+  SDLoc dl(Op);
+  EVT VT = Op.getValueType();
+  SDValue Src = Op.getOperand(0);
+  MVT IntVT = MVT::v256i64;
+  MVT FPVT = MVT::v256f64;
+
+  if (Src.getValueType() != IntVT) {
+    // A zero extended 32-bit value is converted exactly by the signed
+    // 64-bit conversion, so there is only one rounding even for f32.
+    SDValue Res = DAG.getNode(ISD::SINT_TO_FP, dl, FPVT,
+                              DAG.getNode(ISD::ZERO_EXTEND, dl, IntVT, Src));
+    if (VT != FPVT)
+      Res = DAG.getNode(ISD::FP_ROUND, dl, VT, Res,
+                        DAG.getIntPtrConstant(0, dl));
+    return Res;
+  }
+
+  // Rounding i64 to f64 and then to f32 may round twice, so scalarize it.
+  if (VT != FPVT)
+    return DAG.UnrollVectorOp(Op.getNode());
+
+  // Convert both 32-bit halves exactly and add them with a single rounding.
+  SDValue Hi = DAG.getNode(
+      ISD::SRL, dl, IntVT, Src,
+      DAG.getNode(VEISD::VEC_BROADCAST, dl, IntVT,
+                  DAG.getConstant(32, dl, MVT::i64)));
+  SDValue Lo = DAG.getNode(
+      ISD::AND, dl, IntVT, Src,
+      DAG.getNode(VEISD::VEC_BROADCAST, dl, IntVT,
+                  DAG.getConstant(0xffffffffULL, dl, MVT::i64)));
+  SDValue FHi = DAG.getNode(
+      ISD::FMUL, dl, FPVT, DAG.getNode(ISD::SINT_TO_FP, dl, FPVT, Hi),
+      DAG.getNode(VEISD::VEC_BROADCAST, dl, FPVT,
+                  DAG.getConstantFP(4294967296.0, dl, MVT::f64))); // 2^32
+  SDValue FLo = DAG.getNode(ISD::SINT_TO_FP, dl, FPVT, Lo);
+  return DAG.getNode(ISD::FADD, dl, FPVT, FHi, FLo);
+}
+
 // Custom lower UMULO/SMULO for VE. This code is similar to ExpandNode()
 // in LegalizeDAG.cpp except the order of arguments to the library function.
 static SDValue LowerUMULO_SMULO(SDValue Op, SelectionDAG &DAG,
@@ -2381,6 +2891,47 @@ static SDValue LowerUMULO_SMULO(SDValue Op, SelectionDAG &DAG,
   return DAG.getMergeValues(Ops, dl);
 }
 
+// Lower 128-bit shifts of (lo, hi) pairs.  For shift amounts below 64 the
+// half receiving bits from the other half is a double shift, SLD or SRD.
+// Larger amounts move the other half shifted by the remaining amount.
+static SDValue LowerShiftParts(SDValue Op, SelectionDAG &DAG) {
+  unsigned Opc = Op.getOpcode();
+  SDLoc dl(Op);
+  EVT VT = Op.getValueType();
+  SDValue Lo = Op.getOperand(0);
+  SDValue Hi = Op.getOperand(1);
+  SDValue Amt = Op.getOperand(2);
+  EVT AmtVT = Amt.getValueType();
+  unsigned BitWidth = VT.getSizeInBits();
+
+  SDValue Mask = DAG.getConstant(BitWidth - 1, dl, AmtVT);
+  SDValue ShAmt = DAG.getNode(ISD::AND, dl, AmtVT, Amt, Mask);
+  SDValue Large = DAG.getNode(ISD::AND, dl, AmtVT, Amt,
+                              DAG.getConstant(BitWidth, dl, AmtVT));
+  SDValue Zero = DAG.getConstant(0, dl, AmtVT);
+
+  SDValue NewLo, NewHi;
+  if (Opc == ISD::SHL_PARTS) {
+    SDValue Dbl = DAG.getNode(VEISD::SLD, dl, VT, Hi, Lo, ShAmt);
+    SDValue Sh = DAG.getNode(ISD::SHL, dl, VT, Lo, ShAmt);
+    NewHi = DAG.getSelectCC(dl, Large, Zero, Sh, Dbl, ISD::SETNE);
+    NewLo = DAG.getSelectCC(dl, Large, Zero, DAG.getConstant(0, dl, VT), Sh,
+                            ISD::SETNE);
+  } else {
+    bool IsSRA = Opc == ISD::SRA_PARTS;
+    SDValue Dbl = DAG.getNode(VEISD::SRD, dl, VT, Hi, Lo, ShAmt);
+    SDValue Sh = DAG.getNode(IsSRA ? ISD::SRA : ISD::SRL, dl, VT, Hi, ShAmt);
+    SDValue Fill = IsSRA ? DAG.getNode(ISD::SRA, dl, VT, Hi,
+                                       DAG.getConstant(BitWidth - 1, dl, AmtVT))
+                         : DAG.getConstant(0, dl, VT);
+    NewLo = DAG.getSelectCC(dl, Large, Zero, Sh, Dbl, ISD::SETNE);
+    NewHi = DAG.getSelectCC(dl, Large, Zero, Fill, Sh, ISD::SETNE);
+  }
+
+  SDValue Ops[2] = { NewLo, NewHi };
+  return DAG.getMergeValues(Ops, dl);
+}
+
 SDValue VETargetLowering::LowerATOMIC_FENCE(SDValue Op,
                                             SelectionDAG &DAG) const {
   SDLoc DL(Op);
@@ -3258,6 +3809,8 @@ LowerOperation(SDValue Op, SelectionDAG &DAG) const {
   case ISD::GlobalTLSAddress:   return LowerGlobalTLSAddress(Op, DAG);
   case ISD::GlobalAddress:      return LowerGlobalAddress(Op, DAG);
   case ISD::BlockAddress:       return LowerBlockAddress(Op, DAG);
+  case ISD::BR_JT:              return LowerBR_JT(Op, DAG);
+  case ISD::PREFETCH:           return LowerPREFETCH(Op, DAG);
   case ISD::ConstantPool:       return LowerConstantPool(Op, DAG);
   case ISD::EH_SJLJ_SETJMP:     return LowerEH_SJLJ_SETJMP(Op, DAG);
   case ISD::EH_SJLJ_LONGJMP:    return LowerEH_SJLJ_LONGJMP(Op, DAG);
@@ -3268,8 +3821,15 @@ LowerOperation(SDValue Op, SelectionDAG &DAG) const {
 
   case ISD::LOAD:               return LowerLOAD(Op, DAG);
   case ISD::STORE:              return LowerSTORE(Op, DAG);
+  case ISD::FDIV:               return LowerF128FDIV(Op, DAG);
+  case ISD::FSQRT:              return LowerF128FSQRT(Op, DAG);
+  case ISD::FP_TO_UINT:         return LowerFP_TO_UINT(Op, DAG);
+  case ISD::UINT_TO_FP:         return LowerUINT_TO_FP(Op, DAG);
   case ISD::UMULO:
   case ISD::SMULO:              return LowerUMULO_SMULO(Op, DAG, *this);
+  case ISD::SHL_PARTS:
+  case ISD::SRA_PARTS:
+  case ISD::SRL_PARTS:          return LowerShiftParts(Op, DAG);
   case ISD::ATOMIC_FENCE:       return LowerATOMIC_FENCE(Op, DAG);
   case ISD::INTRINSIC_VOID:     return LowerINTRINSIC_VOID(Op, DAG);
   case ISD::INTRINSIC_W_CHAIN:  return LowerINTRINSIC_W_CHAIN(Op, DAG);
@@ -4052,6 +4612,26 @@ VETargetLowering::isOffsetFoldingLegal(const GlobalAddressSDNode *GA) const {
   return false;
 }
 
+bool VETargetLowering::allowsMisalignedMemoryAccesses(EVT VT,
+                                                      unsigned AddrSpace,
+                                                      unsigned Align,
+                                                      bool *Fast) const {
+  // Only full unpacked vectors are accepted.  Their loads and stores access
+  // every element separately with the element size as stride, so element
+  // alignment is enough.  Scalars, packed vectors (accessed as 64 bits
+  // elements) and shorter vectors (widened or split by legalization) keep
+  // the natural alignment requirement.
+  if (!isTypeLegal(VT) || !VT.isVector() ||
+      VT.getVectorNumElements() != 256)
+    return false;
+  unsigned EltBits = VT.getScalarSizeInBits();
+  if ((EltBits != 32 && EltBits != 64) || Align < EltBits / 8)
+    return false;
+  if (Fast)
+    *Fast = true;
+  return true;
+}
+
 void VETargetLowering::ReplaceNodeResults(SDNode *N,
                                              SmallVectorImpl<SDValue>& Results,
                                              SelectionDAG &DAG) const {
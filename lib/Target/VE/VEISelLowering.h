@@ -16,6 +16,7 @@
 #define LLVM_LIB_TARGET_VE_VEISELLOWERING_H
 
 #include "VE.h"
+#include "llvm/CodeGen/CallingConvLower.h"
 #include "llvm/CodeGen/TargetLowering.h"
 
 namespace llvm {
@@ -50,6 +51,9 @@ namespace llvm {
       FMAX,
       FMIN,
 
+      SLD,         // Upper 64 bits of the 128-bit (hi, lo) shifted left.
+      SRD,         // Lower 64 bits of the 128-bit (hi, lo) shifted right.
+
       GETFUNPLT,   // load function address through %plt insturction
       GETSTACKTOP, // retrieve address of stack top (first address of
                    // locals and temporaries)
@@ -450,6 +454,11 @@ namespace llvm {
       INT_LVS,          // for int_lvs_svs_u64, int_lvs_svs_f64, and
                         // int_ve_lvs_svs_f32
       INT_PFCHV,        // for int_ve_pfchv
+
+      // Memory opcodes start here.  These nodes are MemSDNodes and carry a
+      // memory operand.
+      VEC_VLD = ISD::FIRST_TARGET_MEMORY_OPCODE, // Strided vector load.
+      VEC_VST,                                    // Strided vector store.
     };
   }
 
@@ -531,6 +540,10 @@ namespace llvm {
     SDValue LowerCall_64(TargetLowering::CallLoweringInfo &CLI,
                          SmallVectorImpl<SDValue> &InVals) const;
 
+    /// Selects the correct CCAssignFn for a given CallingConvention value.
+    CCAssignFn *CCAssignFnForCall(CallingConv::ID CC, bool IsVarArg) const;
+    CCAssignFn *CCAssignFnForReturn(CallingConv::ID CC) const;
+
     bool CanLowerReturn(CallingConv::ID CallConv, MachineFunction &MF,
                         bool isVarArg,
                         const SmallVectorImpl<ISD::OutputArg> &ArgsFlags,
@@ -551,6 +564,8 @@ namespace llvm {
     SDValue LowerToTLSLocalExecModel(SDValue Op, SelectionDAG &DAG) const;
     SDValue LowerConstantPool(SDValue Op, SelectionDAG &DAG) const;
     SDValue LowerBlockAddress(SDValue Op, SelectionDAG &DAG) const;
+    SDValue LowerBR_JT(SDValue Op, SelectionDAG &DAG) const;
+    SDValue LowerPREFETCH(SDValue Op, SelectionDAG &DAG) const;
     SDValue LowerBUILD_VECTOR(SDValue Op, SelectionDAG &DAG) const;
 
     SDValue LowerBitcast(SDValue Op, SelectionDAG &DAG) const;
@@ -594,6 +609,10 @@ namespace llvm {
       return VT != MVT::f128;
     }
 
+    bool allowsMisalignedMemoryAccesses(EVT VT, unsigned AddrSpace,
+                                        unsigned Align,
+                                        bool *Fast) const override;
+
     unsigned getJumpTableEncoding() const override;
 
     const MCExpr *
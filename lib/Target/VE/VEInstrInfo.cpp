@@ -12,6 +12,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "VEInstrInfo.h"
+#include "MCTargetDesc/VEMCExpr.h"
 #include "VE.h"
 #include "VEMachineFunctionInfo.h"
 #include "VESubtarget.h"
@@ -21,6 +22,7 @@
 #include "llvm/CodeGen/MachineInstrBuilder.h"
 #include "llvm/CodeGen/MachineMemOperand.h"
 #include "llvm/CodeGen/MachineRegisterInfo.h"
+#include "llvm/MC/MCAsmInfo.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/TargetRegistry.h"
@@ -36,6 +38,20 @@ static cl::opt<bool> ShowSpillMessageVec(
   cl::desc("Enable diagnostic message for spill/restore of vector or vector mask registers."),
   cl::Hidden);
 
+// Branch displacements are 32 bits.  These options restrict the range for
+// testing branch relaxation.
+static cl::opt<unsigned> BCROffsetBits(
+  "ve-bcr-offset-bits",
+  cl::init(32),
+  cl::desc("Restrict range of conditional branch instructions (DEBUG)"),
+  cl::Hidden);
+
+static cl::opt<unsigned> BROffsetBits(
+  "ve-br-offset-bits",
+  cl::init(32),
+  cl::desc("Restrict range of unconditional branch instructions (DEBUG)"),
+  cl::Hidden);
+
 using namespace llvm;
 
 #define GET_INSTRINFO_CTOR_DTOR
@@ -152,10 +168,7 @@ static bool isCondBranchOpcode(int Opc) {
 }
 
 static bool isIndirectBranchOpcode(int Opc) {
-#if 0
-  return Opc == SP::BINDrr || Opc == SP::BINDri;
-#endif
-  report_fatal_error("isIndirectBranchOpcode is not implemented yet");
+  return Opc == VE::BArr || Opc == VE::BAri;
 }
 
 static void parseCondBranch(MachineInstr *LastInst, MachineBasicBlock *&Target,
@@ -258,11 +271,13 @@ unsigned VEInstrInfo::insertBranch(MachineBasicBlock &MBB,
   assert(TBB && "insertBranch must not be told to insert a fallthrough");
   assert((Cond.size() == 3 || Cond.size() == 0) &&
          "VE branch conditions should have three component!");
-  assert(!BytesAdded && "code size not handled");
+  // Every branch instruction is 8 bytes long.
   if (Cond.empty()) {
     // Uncondition branch
     assert(!FBB && "Unconditional branch with multiple successors!");
     BuildMI(&MBB, DL, get(VE::BCRLa)).addMBB(TBB);
+    if (BytesAdded)
+      *BytesAdded = 8;
     return 1;
   }
 
@@ -307,16 +322,19 @@ unsigned VEInstrInfo::insertBranch(MachineBasicBlock &MBB,
           .addMBB(TBB);
   }
 
-  if (!FBB)
+  if (!FBB) {
+    if (BytesAdded)
+      *BytesAdded = 8;
     return 1;
+  }
   BuildMI(&MBB, DL, get(VE::BCRLa)).addMBB(FBB);
+  if (BytesAdded)
+    *BytesAdded = 16;
   return 2;
 }
 
 unsigned VEInstrInfo::removeBranch(MachineBasicBlock &MBB,
                                       int *BytesRemoved) const {
-  assert(!BytesRemoved && "code size not handled");
-
   MachineBasicBlock::iterator I = MBB.end();
   unsigned Count = 0;
   while (I != MBB.begin()) {
@@ -333,6 +351,8 @@ unsigned VEInstrInfo::removeBranch(MachineBasicBlock &MBB,
     I = MBB.end();
     ++Count;
   }
+  if (BytesRemoved)
+    *BytesRemoved = Count * 8;
   return Count;
 
   //report_fatal_error("removeBranch is not implemented yet");
@@ -348,6 +368,209 @@ bool VEInstrInfo::reverseBranchCondition(
   return false;
 }
 
+unsigned VEInstrInfo::getInstSizeInBytes(const MachineInstr &MI) const {
+  switch (MI.getOpcode()) {
+  default:
+    // Labels, KILL, IMPLICIT_DEF and the like emit nothing.  Every real
+    // instruction is 8 bytes long.
+    return MI.isMetaInstruction() ? 0 : 8;
+  case TargetOpcode::INLINEASM: {
+    const MachineFunction *MF = MI.getParent()->getParent();
+    const char *AsmStr = MI.getOperand(0).getSymbolName();
+    return getInlineAsmLength(AsmStr, *MF->getTarget().getMCAsmInfo());
+  }
+  case VE::MEMBARRIER:
+    return 0;
+  // Pseudo instructions expanded by VEAsmPrinter.
+  case VE::GETGOT:
+  case VE::GETFUNPLT:
+  case VE::EH_SjLj_LongJmp:
+    return 32;
+  case VE::EH_SjLj_SetJmp:
+    return 48;
+  case TargetOpcode::PATCHABLE_FUNCTION_ENTER:
+  case TargetOpcode::PATCHABLE_FUNCTION_EXIT:
+  case TargetOpcode::PATCHABLE_TAIL_CALL:
+    return 56;
+  case VE::GETTLSADDR:
+  case VE::VM2V:
+  case VE::V2VM:
+    return 64;
+  case VE::VMP2V:
+  case VE::V2VMP:
+    return 128;
+  }
+}
+
+// A conditional branch out of range is inverted to jump over the expansion
+// of an unconditional one, which takes up to 40 bytes.  So it must reach at
+// least 48 bytes ahead, or relaxation never converges.  Narrower ranges
+// requested for testing are widened to the 7 bits that allow that.
+static const unsigned MinBranchOffsetBits = 7;
+
+bool VEInstrInfo::isBranchOffsetInRange(unsigned BranchOpc,
+                                        int64_t BrOffset) const {
+  if (isUncondBranchOpcode(BranchOpc))
+    return isIntN(std::max<unsigned>(BROffsetBits, MinBranchOffsetBits),
+                  BrOffset);
+  assert(isCondBranchOpcode(BranchOpc) && "Unexpected opcode!");
+  return isIntN(std::max<unsigned>(BCROffsetBits, MinBranchOffsetBits),
+                BrOffset);
+}
+
+MachineBasicBlock *
+VEInstrInfo::getBranchDestBlock(const MachineInstr &MI) const {
+  assert(MI.getDesc().isBranch() && "Unexpected opcode!");
+  // The branch target is always the last operand.
+  int NumOp = MI.getNumExplicitOperands();
+  return MI.getOperand(NumOp - 1).getMBB();
+}
+
+unsigned VEInstrInfo::insertIndirectBranch(MachineBasicBlock &MBB,
+                                           MachineBasicBlock &DestBB,
+                                           const DebugLoc &DL,
+                                           int64_t BrOffset,
+                                           RegScavenger *RS) const {
+  assert(MBB.empty() &&
+         "new block should be inserted for expanding unconditional branch");
+  assert(MBB.pred_size() == 1);
+
+  // %s12 holds the target address of calls and is never live across basic
+  // blocks, so it is free at the end of MBB.
+  const TargetMachine &TM = MBB.getParent()->getTarget();
+  if (TM.isPositionIndependent()) {
+    // lea %s12, DestBB@pc_lo(-24)
+    // and %s12, %s12, (32)0
+    // sic %plt
+    // lea.sl %s12, DestBB@pc_hi(%s12, %plt)
+    // b.l (,%s12)
+    BuildMI(&MBB, DL, get(VE::LEAzii), VE::SX12)
+        .addImm(-24).addMBB(&DestBB, VEMCExpr::VK_VE_PC_LO32);
+    BuildMI(&MBB, DL, get(VE::ANDrm0), VE::SX12)
+        .addReg(VE::SX12).addImm(32);
+    BuildMI(&MBB, DL, get(VE::SIC), VE::SW16);
+    BuildMI(&MBB, DL, get(VE::LEASLrri), VE::SX12)
+        .addReg(VE::SX16).addReg(VE::SX12)
+        .addMBB(&DestBB, VEMCExpr::VK_VE_PC_HI32);
+    BuildMI(&MBB, DL, get(VE::BAri)).addReg(VE::SX12).addImm(0);
+    return 40;
+  }
+
+  // lea %s12, DestBB@lo
+  // and %s12, %s12, (32)0
+  // lea.sl %s12, DestBB@hi(%s12)
+  // b.l (,%s12)
+  BuildMI(&MBB, DL, get(VE::LEAzzi), VE::SX12)
+      .addMBB(&DestBB, VEMCExpr::VK_VE_LO32);
+  BuildMI(&MBB, DL, get(VE::ANDrm0), VE::SX12)
+      .addReg(VE::SX12).addImm(32);
+  BuildMI(&MBB, DL, get(VE::LEASLrzi), VE::SX12)
+      .addReg(VE::SX12).addMBB(&DestBB, VEMCExpr::VK_VE_HI32);
+  BuildMI(&MBB, DL, get(VE::BAri)).addReg(VE::SX12).addImm(0);
+  return 32;
+}
+
+bool VEInstrInfo::getMemOperandWithOffset(
+    MachineInstr &MI, MachineOperand *&BaseOp, int64_t &Offset,
+    const TargetRegisterInfo *TRI) const {
+  unsigned AddrIdx;
+  switch (MI.getOpcode()) {
+  default:
+    return false;
+  case VE::LDSri:
+    AddrIdx = 1;
+    break;
+  case VE::STSri:
+    AddrIdx = 0;
+    break;
+  }
+  if (MI.hasOrderedMemoryRef())
+    return false;
+
+  MachineOperand &Base = MI.getOperand(AddrIdx);
+  const MachineOperand &Disp = MI.getOperand(AddrIdx + 1);
+  if ((!Base.isReg() && !Base.isFI()) || !Disp.isImm())
+    return false;
+  BaseOp = &Base;
+  Offset = Disp.getImm();
+  return true;
+}
+
+bool VEInstrInfo::shouldClusterMemOps(MachineOperand &BaseOp1,
+                                      MachineOperand &BaseOp2,
+                                      unsigned NumLoads) const {
+  // Only cluster pairs.
+  if (NumLoads > 1)
+    return false;
+  if (BaseOp1.getType() != BaseOp2.getType())
+    return false;
+  if (BaseOp1.isReg() ? BaseOp1.getReg() != BaseOp2.getReg()
+                      : BaseOp1.getIndex() != BaseOp2.getIndex())
+    return false;
+
+  MachineOperand *Base;
+  int64_t Offset1, Offset2;
+  if (!getMemOperandWithOffset(*BaseOp1.getParent(), Base, Offset1, &RI) ||
+      !getMemOperandWithOffset(*BaseOp2.getParent(), Base, Offset2, &RI))
+    return false;
+  return std::abs(Offset1 - Offset2) == 8;
+}
+
+bool VEInstrInfo::isAssociativeAndCommutative(const MachineInstr &Inst) const {
+  switch (Inst.getOpcode()) {
+  case VE::ADDrr:   // addu.l
+  case VE::ADXrr:   // adds.l
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool VEInstrInfo::getMachineCombinerPatterns(
+    MachineInstr &Root,
+    SmallVectorImpl<MachineCombinerPattern> &Patterns) const {
+  // Without a scheduling model, the MachineCombiner applies every pattern it
+  // is given.  Only reassociate at the end of a chain, so that
+  // ((a + b) + c) + d becomes (a + b) + (c + d) rather than a + ((b + c) + d).
+  if (!isAssociativeAndCommutative(Root))
+    return false;
+  const MachineRegisterInfo &MRI = Root.getMF()->getRegInfo();
+  unsigned Reg = Root.getOperand(0).getReg();
+  if (TargetRegisterInfo::isVirtualRegister(Reg) && MRI.hasOneNonDBGUse(Reg)) {
+    const MachineInstr &User = *MRI.use_instr_nodbg_begin(Reg);
+    if (User.getOpcode() == Root.getOpcode() &&
+        User.getParent() == Root.getParent())
+      return false;
+  }
+  unsigned NumPatterns = Patterns.size();
+  if (!TargetInstrInfo::getMachineCombinerPatterns(Root, Patterns))
+    return false;
+
+  // Likewise, only move the operand of the previous operation which is
+  // computed by the same operation, and is thus the deepest, to the end of the
+  // chain.  Otherwise (a + b) + carry would become (a + carry) + b.
+  auto IsChained = [&](MachineCombinerPattern P) {
+    bool PrevIsOp1 = P == MachineCombinerPattern::REASSOC_AX_BY ||
+                     P == MachineCombinerPattern::REASSOC_XA_BY;
+    bool AIsOp1 = P == MachineCombinerPattern::REASSOC_AX_BY ||
+                  P == MachineCombinerPattern::REASSOC_AX_YB;
+    const MachineInstr *Prev =
+        MRI.getUniqueVRegDef(Root.getOperand(PrevIsOp1 ? 1 : 2).getReg());
+    const MachineOperand &A = Prev->getOperand(AIsOp1 ? 1 : 2);
+    if (!A.isReg() || !TargetRegisterInfo::isVirtualRegister(A.getReg()))
+      return false;
+    const MachineInstr *Def = MRI.getUniqueVRegDef(A.getReg());
+    return Def && Def->getOpcode() == Root.getOpcode() &&
+           Def->getParent() == Root.getParent();
+  };
+  Patterns.erase(std::remove_if(Patterns.begin() + NumPatterns, Patterns.end(),
+                                [&](MachineCombinerPattern P) {
+                                  return !IsChained(P);
+                                }),
+                 Patterns.end());
+  return Patterns.size() != NumPatterns;
+}
+
 void VEInstrInfo::copyPhysReg(MachineBasicBlock &MBB,
                                  MachineBasicBlock::iterator I,
                                  const DebugLoc &DL, unsigned DestReg,
@@ -956,3 +1179,161 @@ bool VEInstrInfo::expandGetStackTopPseudo(MachineInstr &MI) const {
   MI.eraseFromParent(); // The pseudo instruction is gone now.
   return true;
 }
+
+bool VEInstrInfo::isFunctionSafeToOutlineFrom(
+    MachineFunction &MF, bool OutlineFromLinkOnceODRs) const {
+  const Function &F = MF.getFunction();
+
+  // Can F be deduplicated by the linker? If it can, don't outline from it.
+  if (!OutlineFromLinkOnceODRs && F.hasLinkOnceODRLinkage())
+    return false;
+
+  // Don't outline from functions with section markings; the program could
+  // expect that all the code is in the named section.
+  if (F.hasSection())
+    return false;
+
+  // An outlined call clobbers %lr.  Only functions saving %lr in their
+  // prologue and restoring it in their epilogue can afford that, which
+  // excludes leaf procedures and naked functions.
+  if (F.hasFnAttribute(Attribute::Naked) ||
+      MF.getInfo<VEMachineFunctionInfo>()->isLeafProc())
+    return false;
+
+  return true;
+}
+
+// Instructions emitted to call an outlined function.
+//   lea %s12, OUTLINED_FUNCTION@lo          (or GETFUNPLT in PIC mode)
+//   and %s12, %s12, (32)0
+//   lea.sl %s12, OUTLINED_FUNCTION@hi(%s12)
+//   bsic %lr, (,%s12)
+static unsigned getOutlinedCallOverhead(const MachineFunction &MF) {
+  return MF.getTarget().isPositionIndependent() ? 40 : 32;
+}
+
+enum MachineOutlinerConstructionID {
+  MachineOutlinerDefault
+};
+
+outliner::OutlinedFunction VEInstrInfo::getOutliningCandidateInfo(
+    std::vector<outliner::Candidate> &RepeatedSequenceLocs) const {
+
+  // The call clobbers %lr and %s12, so neither may be live across the
+  // candidate.  %lr is live between the restore in the epilogue and the
+  // return, for example.  Neither of them is ever live into or out of a
+  // block here, so their liveness is computed from the end of the block
+  // without the liveness tracking Candidate::initLRU relies on.
+  auto CannotInsertCall = [](outliner::Candidate &C) {
+    const TargetRegisterInfo *TRI = C.getMF()->getSubtarget().getRegisterInfo();
+    LiveRegUnits LRU(*TRI);
+    std::for_each(C.getMBB()->rbegin(),
+                  (MachineBasicBlock::reverse_iterator)C.front(),
+                  [&LRU](MachineInstr &MI) { LRU.stepBackward(MI); });
+    return !LRU.available(VE::SX10) || !LRU.available(VE::SX12);
+  };
+
+  RepeatedSequenceLocs.erase(std::remove_if(RepeatedSequenceLocs.begin(),
+                                            RepeatedSequenceLocs.end(),
+                                            CannotInsertCall),
+                             RepeatedSequenceLocs.end());
+
+  // If the sequence doesn't have enough candidates left, then we're done.
+  if (RepeatedSequenceLocs.size() < 2)
+    return outliner::OutlinedFunction();
+
+  unsigned SequenceSize = 0;
+  auto I = RepeatedSequenceLocs[0].front();
+  auto E = std::next(RepeatedSequenceLocs[0].back());
+  for (; I != E; ++I)
+    SequenceSize += getInstSizeInBytes(*I);
+
+  unsigned CallOverhead =
+      getOutlinedCallOverhead(*RepeatedSequenceLocs[0].getMF());
+  for (auto &C : RepeatedSequenceLocs)
+    C.setCallInfo(MachineOutlinerDefault, CallOverhead);
+
+  // The outlined function ends with "b.l (,%lr)".
+  unsigned FrameOverhead = 8;
+
+  return outliner::OutlinedFunction(RepeatedSequenceLocs, SequenceSize,
+                                    FrameOverhead, MachineOutlinerDefault);
+}
+
+outliner::InstrType
+VEInstrInfo::getOutliningType(MachineBasicBlock::iterator &MIT,
+                              unsigned Flags) const {
+  MachineInstr &MI = *MIT;
+  const TargetRegisterInfo *TRI = &getRegisterInfo();
+
+  // Don't allow debug values to impact outlining type.
+  if (MI.isDebugInstr() || MI.isIndirectDebugValue())
+    return outliner::InstrType::Invisible;
+
+  // KILLs don't really tell us much so we can go ahead and skip over them.
+  if (MI.isKill())
+    return outliner::InstrType::Invisible;
+
+  // The outlined function has no frame, so it can neither call nor return
+  // on behalf of its caller.
+  if (MI.isCall() || MI.isTerminator() || MI.isReturn())
+    return outliner::InstrType::Illegal;
+
+  // Don't move CFI instructions, labels and inline asm.
+  if (MI.isCFIInstruction() || MI.isPosition() || MI.isInlineAsm())
+    return outliner::InstrType::Illegal;
+
+  // These depend on their position in the caller.
+  switch (MI.getOpcode()) {
+  case VE::SIC:
+  case VE::EH_SjLj_SetJmp:
+  case VE::EH_SjLj_LongJmp:
+  case TargetOpcode::PATCHABLE_FUNCTION_ENTER:
+  case TargetOpcode::PATCHABLE_FUNCTION_EXIT:
+  case TargetOpcode::PATCHABLE_TAIL_CALL:
+    return outliner::InstrType::Illegal;
+  default:
+    break;
+  }
+
+  // Basic block addresses are relative to the caller.
+  for (const MachineOperand &MO : MI.operands())
+    if (MO.isMBB())
+      return outliner::InstrType::Illegal;
+
+  // The call sequence uses %lr and %s12.
+  if (MI.readsRegister(VE::SX10, TRI) || MI.modifiesRegister(VE::SX10, TRI) ||
+      MI.readsRegister(VE::SX12, TRI) || MI.modifiesRegister(VE::SX12, TRI))
+    return outliner::InstrType::Illegal;
+
+  return outliner::InstrType::Legal;
+}
+
+void VEInstrInfo::buildOutlinedFrame(
+    MachineBasicBlock &MBB, MachineFunction &MF,
+    const outliner::OutlinedFunction &OF) const {
+  // Return to the caller.
+  MBB.insert(MBB.end(), BuildMI(MF, DebugLoc(), get(VE::RET)));
+}
+
+MachineBasicBlock::iterator VEInstrInfo::insertOutlinedCall(
+    Module &M, MachineBasicBlock &MBB, MachineBasicBlock::iterator &It,
+    MachineFunction &MF, const outliner::Candidate &C) const {
+  DebugLoc DL;
+  const GlobalValue *Callee = M.getNamedValue(MF.getName());
+
+  if (MF.getTarget().isPositionIndependent()) {
+    BuildMI(MBB, It, DL, get(VE::GETFUNPLT), VE::SX12)
+        .addGlobalAddress(Callee);
+  } else {
+    BuildMI(MBB, It, DL, get(VE::LEAzzi), VE::SX12)
+        .addGlobalAddress(Callee, 0, VEMCExpr::VK_VE_LO32);
+    BuildMI(MBB, It, DL, get(VE::ANDrm0), VE::SX12)
+        .addReg(VE::SX12).addImm(32);
+    BuildMI(MBB, It, DL, get(VE::LEASLrzi), VE::SX12)
+        .addReg(VE::SX12).addGlobalAddress(Callee, 0, VEMCExpr::VK_VE_HI32);
+  }
+  It = MBB.insert(It, BuildMI(MF, DL, get(VE::CALLr))
+                          .addReg(VE::SX12, RegState::Kill));
+  return It;
+}
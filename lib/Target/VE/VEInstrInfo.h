@@ -81,6 +81,38 @@ public:
   bool
   reverseBranchCondition(SmallVectorImpl<MachineOperand> &Cond) const override;
 
+  /// getInstSizeInBytes - Return the number of bytes of code the specified
+  /// instruction may be.  Pseudo instructions expanded by the AsmPrinter
+  /// return the size of their expansion.
+  unsigned getInstSizeInBytes(const MachineInstr &MI) const override;
+
+  bool isBranchOffsetInRange(unsigned BranchOpc,
+                             int64_t BrOffset) const override;
+
+  MachineBasicBlock *getBranchDestBlock(const MachineInstr &MI) const override;
+
+  unsigned insertIndirectBranch(MachineBasicBlock &MBB,
+                                MachineBasicBlock &NewDestBB,
+                                const DebugLoc &DL, int64_t BrOffset = 0,
+                                RegScavenger *RS = nullptr) const override;
+
+  bool getMemOperandWithOffset(MachineInstr &MI, MachineOperand *&BaseOp,
+                               int64_t &Offset,
+                               const TargetRegisterInfo *TRI) const override;
+
+  /// shouldClusterMemOps - Keep 8-byte loads or stores of adjacent memory,
+  /// like the two halves of an f128 access, next to each other.
+  bool shouldClusterMemOps(MachineOperand &BaseOp1, MachineOperand &BaseOp2,
+                           unsigned NumLoads) const override;
+
+  /// useMachineCombiner - Reassociate chains of 64-bit additions, mostly
+  /// address arithmetic, to shorten their critical path.
+  bool useMachineCombiner() const override { return true; }
+  bool isAssociativeAndCommutative(const MachineInstr &Inst) const override;
+  bool getMachineCombinerPatterns(
+      MachineInstr &Root,
+      SmallVectorImpl<MachineCombinerPattern> &Patterns) const override;
+
   void copyPhysReg(MachineBasicBlock &MBB, MachineBasicBlock::iterator I,
                    const DebugLoc &DL, unsigned DestReg, unsigned SrcReg,
                    bool KillSrc) const override;
@@ -106,6 +138,25 @@ public:
 
   bool expandExtendStackPseudo(MachineInstr &MI) const;
   bool expandGetStackTopPseudo(MachineInstr &MI) const;
+
+  // MachineOutliner hooks.  An outlined function is called with
+  // "bsic %lr, (,%s12)" and returns with "b.l (,%lr)".
+  bool isFunctionSafeToOutlineFrom(MachineFunction &MF,
+                                   bool OutlineFromLinkOnceODRs) const override;
+
+  outliner::OutlinedFunction getOutliningCandidateInfo(
+      std::vector<outliner::Candidate> &RepeatedSequenceLocs) const override;
+
+  outliner::InstrType getOutliningType(MachineBasicBlock::iterator &MIT,
+                                       unsigned Flags) const override;
+
+  void buildOutlinedFrame(MachineBasicBlock &MBB, MachineFunction &MF,
+                          const outliner::OutlinedFunction &OF) const override;
+
+  MachineBasicBlock::iterator
+  insertOutlinedCall(Module &M, MachineBasicBlock &MBB,
+                     MachineBasicBlock::iterator &It, MachineFunction &MF,
+                     const outliner::Candidate &C) const override;
 };
 
 }
@@ -0,0 +1,474 @@
+//===-- VEInstructionSelector.cpp -------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+/// This file implements the targeting of the InstructionSelector class for
+/// VE.
+///
+/// Most arithmetic is selected by the patterns imported from the .td files.
+/// Instructions whose patterns rely on ComplexPatterns or C++ predicates
+/// (constants, addresses, loads and stores, branches) are selected by hand
+/// here using the same instruction sequences as VEISelDAGToDAG.
+//===----------------------------------------------------------------------===//
+
+#include "MCTargetDesc/VEMCExpr.h"
+#include "VE.h"
+#include "VEInstrInfo.h"
+#include "VERegisterBankInfo.h"
+#include "VESubtarget.h"
+#include "VETargetMachine.h"
+#include "llvm/CodeGen/GlobalISel/InstructionSelector.h"
+#include "llvm/CodeGen/GlobalISel/InstructionSelectorImpl.h"
+#include "llvm/CodeGen/GlobalISel/MachineIRBuilder.h"
+#include "llvm/CodeGen/GlobalISel/Utils.h"
+#include "llvm/CodeGen/MachineFunction.h"
+#include "llvm/CodeGen/MachineInstrBuilder.h"
+#include "llvm/CodeGen/MachineRegisterInfo.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "ve-isel"
+
+using namespace llvm;
+
+namespace {
+
+#define GET_GLOBALISEL_PREDICATE_BITSET
+#include "VEGenGlobalISel.inc"
+#undef GET_GLOBALISEL_PREDICATE_BITSET
+
+class VEInstructionSelector : public InstructionSelector {
+public:
+  VEInstructionSelector(const VETargetMachine &TM, const VESubtarget &STI,
+                        const VERegisterBankInfo &RBI);
+
+  bool select(MachineInstr &I, CodeGenCoverage &CoverageInfo) const override;
+  static const char *getName() { return DEBUG_TYPE; }
+
+private:
+  /// tblgen-erated 'select' implementation, used as the initial selector for
+  /// the patterns that don't require complex C++.
+  bool selectImpl(MachineInstr &I, CodeGenCoverage &CoverageInfo) const;
+
+  const TargetRegisterClass *getRegClass(LLT Ty,
+                                         const RegisterBank &RB) const;
+  const TargetRegisterClass *getRegClass(unsigned Reg,
+                                         MachineRegisterInfo &MRI) const;
+
+  bool selectCopy(MachineInstr &I, MachineRegisterInfo &MRI) const;
+  bool selectConstant(MachineInstr &I, MachineRegisterInfo &MRI) const;
+  bool selectGlobalValue(MachineInstr &I, MachineRegisterInfo &MRI) const;
+  bool selectGEP(MachineInstr &I, MachineRegisterInfo &MRI) const;
+  bool selectLoadStore(MachineInstr &I, MachineRegisterInfo &MRI) const;
+  bool selectBrCond(MachineInstr &I, MachineRegisterInfo &MRI) const;
+
+  /// Add the base and displacement operands of a MEMri address computing
+  /// \p Addr, folding frame indices and constant offsets.
+  void addAddressOperands(MachineInstrBuilder &MIB, unsigned Addr,
+                          MachineRegisterInfo &MRI) const;
+
+  const VETargetMachine &TM;
+  const VESubtarget &STI;
+  const VEInstrInfo &TII;
+  const VERegisterInfo &TRI;
+  const VERegisterBankInfo &RBI;
+
+#define GET_GLOBALISEL_PREDICATES_DECL
+#include "VEGenGlobalISel.inc"
+#undef GET_GLOBALISEL_PREDICATES_DECL
+
+#define GET_GLOBALISEL_TEMPORARIES_DECL
+#include "VEGenGlobalISel.inc"
+#undef GET_GLOBALISEL_TEMPORARIES_DECL
+};
+
+} // end anonymous namespace
+
+#define GET_GLOBALISEL_IMPL
+#include "VEGenGlobalISel.inc"
+#undef GET_GLOBALISEL_IMPL
+
+VEInstructionSelector::VEInstructionSelector(const VETargetMachine &TM,
+                                             const VESubtarget &STI,
+                                             const VERegisterBankInfo &RBI)
+    : InstructionSelector(), TM(TM), STI(STI), TII(*STI.getInstrInfo()),
+      TRI(*STI.getRegisterInfo()), RBI(RBI),
+#define GET_GLOBALISEL_PREDICATES_INIT
+#include "VEGenGlobalISel.inc"
+#undef GET_GLOBALISEL_PREDICATES_INIT
+#define GET_GLOBALISEL_TEMPORARIES_INIT
+#include "VEGenGlobalISel.inc"
+#undef GET_GLOBALISEL_TEMPORARIES_INIT
+{
+}
+
+const TargetRegisterClass *
+VEInstructionSelector::getRegClass(LLT Ty, const RegisterBank &RB) const {
+  switch (RB.getID()) {
+  case VE::GPRRegBankID:
+    if (Ty.getSizeInBits() <= 32)
+      return &VE::I32RegClass;
+    if (Ty.getSizeInBits() == 64)
+      return &VE::I64RegClass;
+    if (Ty.getSizeInBits() == 128)
+      return &VE::F128RegClass;
+    return nullptr;
+  case VE::VRRegBankID:
+    return &VE::V64RegClass;
+  case VE::VMRegBankID:
+    return Ty.getSizeInBits() == 512 ? &VE::VM512RegClass : &VE::VMRegClass;
+  }
+  return nullptr;
+}
+
+const TargetRegisterClass *
+VEInstructionSelector::getRegClass(unsigned Reg,
+                                   MachineRegisterInfo &MRI) const {
+  if (const TargetRegisterClass *RC = MRI.getRegClassOrNull(Reg))
+    return RC;
+  const RegisterBank *RB = RBI.getRegBank(Reg, MRI, TRI);
+  if (!RB)
+    return nullptr;
+  return getRegClass(MRI.getType(Reg), *RB);
+}
+
+bool VEInstructionSelector::selectCopy(MachineInstr &I,
+                                       MachineRegisterInfo &MRI) const {
+  unsigned DstReg = I.getOperand(0).getReg();
+  unsigned SrcReg = I.getOperand(1).getReg();
+
+  // Copies from and to physical registers take the class of the physical
+  // register, so that f32 arguments end up in F32 and i32 ones in I32.
+  const TargetRegisterClass *RC;
+  unsigned VReg = DstReg;
+  if (TargetRegisterInfo::isPhysicalRegister(DstReg)) {
+    if (TargetRegisterInfo::isPhysicalRegister(SrcReg))
+      return true;
+    RC = TRI.getMinimalPhysRegClass(DstReg);
+    VReg = SrcReg;
+  } else if (TargetRegisterInfo::isPhysicalRegister(SrcReg)) {
+    RC = TRI.getMinimalPhysRegClass(SrcReg);
+  } else {
+    RC = getRegClass(DstReg, MRI);
+  }
+
+  if (!RC || !RBI.constrainGenericRegister(VReg, *RC, MRI)) {
+    LLVM_DEBUG(dbgs() << "Failed to constrain " << TII.getName(I.getOpcode())
+                      << " operand\n");
+    return false;
+  }
+  return true;
+}
+
+bool VEInstructionSelector::selectConstant(MachineInstr &I,
+                                           MachineRegisterInfo &MRI) const {
+  unsigned DstReg = I.getOperand(0).getReg();
+  unsigned Size = MRI.getType(DstReg).getSizeInBits();
+  const RegisterBank &RB = *RBI.getRegBank(DstReg, MRI, TRI);
+  if (RB.getID() != VE::GPRRegBankID || (Size != 32 && Size != 64))
+    return false;
+
+  int64_t Imm = I.getOperand(1).getCImm()->getSExtValue();
+  MachineIRBuilder B(I);
+  SmallVector<MachineInstr *, 3> Insts;
+
+  if (Size == 32) {
+    // Same as the (i32 simm7) and (i32 simm32) patterns.
+    if (isInt<7>(Imm))
+      Insts.push_back(B.buildInstr(VE::OR32im1, {DstReg}, {})
+                          .addImm(Imm)
+                          .addImm(0));
+    else
+      Insts.push_back(B.buildInstr(VE::LEA32zzi, {DstReg}, {}).addImm(Imm));
+  } else if (isInt<7>(Imm)) {
+    Insts.push_back(
+        B.buildInstr(VE::ORim1, {DstReg}, {}).addImm(Imm).addImm(0));
+  } else if (isInt<32>(Imm)) {
+    Insts.push_back(B.buildInstr(VE::LEAzzi, {DstReg}, {}).addImm(Imm));
+  } else {
+    // lea    %tmp, lo(imm)
+    // and    %tmp, %tmp, (32)0
+    // lea.sl %dst, hi(imm)(%tmp)    (only if the upper half is needed)
+    unsigned Lo = MRI.createVirtualRegister(&VE::I64RegClass);
+    Insts.push_back(B.buildInstr(VE::LEAzzi, {Lo}, {}).addImm(LO32(Imm)));
+    if (isUInt<32>(Imm)) {
+      Insts.push_back(
+          B.buildInstr(VE::ANDrm0, {DstReg}, {Lo}).addImm(32));
+    } else {
+      unsigned And = MRI.createVirtualRegister(&VE::I64RegClass);
+      Insts.push_back(B.buildInstr(VE::ANDrm0, {And}, {Lo}).addImm(32));
+      Insts.push_back(
+          B.buildInstr(VE::LEASLrzi, {DstReg}, {And}).addImm(HI32(Imm)));
+    }
+  }
+
+  for (MachineInstr *MI : Insts)
+    if (!constrainSelectedInstRegOperands(*MI, TII, TRI, RBI))
+      return false;
+  I.eraseFromParent();
+  return true;
+}
+
+bool VEInstructionSelector::selectGlobalValue(MachineInstr &I,
+                                              MachineRegisterInfo &MRI) const {
+  // PIC and TLS addresses need the GOT and the TLS helpers, which are only
+  // implemented in SelectionDAG.
+  const GlobalValue *GV = I.getOperand(1).getGlobal();
+  if (TM.isPositionIndependent() || GV->isThreadLocal())
+    return false;
+
+  unsigned DstReg = I.getOperand(0).getReg();
+  int64_t Offset = I.getOperand(1).getOffset();
+  unsigned Lo = MRI.createVirtualRegister(&VE::I64RegClass);
+  unsigned And = MRI.createVirtualRegister(&VE::I64RegClass);
+
+  MachineIRBuilder B(I);
+  auto LEA = B.buildInstr(VE::LEAzzi, {Lo}, {})
+                 .addGlobalAddress(GV, Offset, VEMCExpr::VK_VE_LO32);
+  auto AND = B.buildInstr(VE::ANDrm0, {And}, {Lo}).addImm(32);
+  auto LEASL = B.buildInstr(VE::LEASLrzi, {DstReg}, {And})
+                   .addGlobalAddress(GV, Offset, VEMCExpr::VK_VE_HI32);
+
+  if (!constrainSelectedInstRegOperands(*LEA, TII, TRI, RBI) ||
+      !constrainSelectedInstRegOperands(*AND, TII, TRI, RBI) ||
+      !constrainSelectedInstRegOperands(*LEASL, TII, TRI, RBI))
+    return false;
+  I.eraseFromParent();
+  return true;
+}
+
+bool VEInstructionSelector::selectGEP(MachineInstr &I,
+                                      MachineRegisterInfo &MRI) const {
+  unsigned DstReg = I.getOperand(0).getReg();
+  unsigned BaseReg = I.getOperand(1).getReg();
+  unsigned OffReg = I.getOperand(2).getReg();
+
+  MachineIRBuilder B(I);
+  MachineInstrBuilder MIB;
+  if (auto Off = getConstantVRegVal(OffReg, MRI)) {
+    if (isInt<32>(*Off))
+      MIB = B.buildInstr(VE::LEArzi, {DstReg}, {BaseReg}).addImm(*Off);
+  }
+  if (!MIB)
+    MIB = B.buildInstr(VE::ADXrr, {DstReg}, {BaseReg, OffReg});
+
+  if (!constrainSelectedInstRegOperands(*MIB, TII, TRI, RBI))
+    return false;
+  I.eraseFromParent();
+  return true;
+}
+
+void VEInstructionSelector::addAddressOperands(MachineInstrBuilder &MIB,
+                                               unsigned Addr,
+                                               MachineRegisterInfo &MRI) const {
+  int64_t Disp = 0;
+  MachineInstr *Def = MRI.getVRegDef(Addr);
+  if (Def && Def->getOpcode() == TargetOpcode::G_GEP) {
+    auto Off = getConstantVRegVal(Def->getOperand(2).getReg(), MRI);
+    if (Off && isInt<32>(*Off)) {
+      Disp = *Off;
+      Addr = Def->getOperand(1).getReg();
+      Def = MRI.getVRegDef(Addr);
+    }
+  }
+
+  if (Def && Def->getOpcode() == TargetOpcode::G_FRAME_INDEX) {
+    MIB.addFrameIndex(Def->getOperand(1).getIndex()).addImm(Disp);
+    return;
+  }
+  MIB.addUse(Addr).addImm(Disp);
+}
+
+bool VEInstructionSelector::selectLoadStore(MachineInstr &I,
+                                            MachineRegisterInfo &MRI) const {
+  using namespace TargetOpcode;
+
+  unsigned ValReg = I.getOperand(0).getReg();
+  unsigned AddrReg = I.getOperand(1).getReg();
+  if (RBI.getRegBank(ValReg, MRI, TRI)->getID() != VE::GPRRegBankID)
+    return false;
+
+  unsigned MemSize = (*I.memoperands_begin())->getSize() * 8;
+  unsigned Opc;
+  switch (I.getOpcode()) {
+  case G_LOAD:
+    switch (MemSize) {
+    case 8:   Opc = VE::LD1BUri; break;
+    case 16:  Opc = VE::LD2BUri; break;
+    case 32:  Opc = VE::LDLri; break;
+    case 64:  Opc = VE::LDSri; break;
+    case 128: Opc = VE::LDQri; break;
+    default:  return false;
+    }
+    break;
+  case G_SEXTLOAD:
+  case G_ZEXTLOAD: {
+    bool Signed = I.getOpcode() == G_SEXTLOAD;
+    switch (MemSize) {
+    case 8:  Opc = Signed ? VE::LD1Bri : VE::LD1BUri; break;
+    case 16: Opc = Signed ? VE::LD2Bri : VE::LD2BUri; break;
+    default: return false;
+    }
+    break;
+  }
+  case G_STORE:
+    switch (MemSize) {
+    case 8:   Opc = VE::ST1Bri; break;
+    case 16:  Opc = VE::ST2Bri; break;
+    case 32:  Opc = VE::STLri; break;
+    case 64:  Opc = VE::STSri; break;
+    case 128: Opc = VE::STQri; break;
+    default:  return false;
+    }
+    break;
+  default:
+    llvm_unreachable("Unexpected memory opcode");
+  }
+
+  MachineInstrBuilder MIB =
+      BuildMI(*I.getParent(), I, I.getDebugLoc(), TII.get(Opc));
+  if (I.getOpcode() == G_STORE) {
+    addAddressOperands(MIB, AddrReg, MRI);
+    MIB.addUse(ValReg);
+  } else {
+    MIB.addDef(ValReg);
+    addAddressOperands(MIB, AddrReg, MRI);
+  }
+  MIB.cloneMemRefs(I);
+
+  I.eraseFromParent();
+  return constrainSelectedInstRegOperands(*MIB, TII, TRI, RBI);
+}
+
+static VECC::CondCodes intCondCode(CmpInst::Predicate Pred) {
+  switch (Pred) {
+  default:
+    llvm_unreachable("Unknown integer condition code!");
+  case CmpInst::ICMP_EQ:  return VECC::CC_IEQ;
+  case CmpInst::ICMP_NE:  return VECC::CC_INE;
+  case CmpInst::ICMP_SLT:
+  case CmpInst::ICMP_ULT: return VECC::CC_IL;
+  case CmpInst::ICMP_SGT:
+  case CmpInst::ICMP_UGT: return VECC::CC_IG;
+  case CmpInst::ICMP_SLE:
+  case CmpInst::ICMP_ULE: return VECC::CC_ILE;
+  case CmpInst::ICMP_SGE:
+  case CmpInst::ICMP_UGE: return VECC::CC_IGE;
+  }
+}
+
+bool VEInstructionSelector::selectBrCond(MachineInstr &I,
+                                         MachineRegisterInfo &MRI) const {
+  // VE has no condition flags, so only branches on an integer compare are
+  // handled, by folding the compare into the branch like the brcc patterns.
+  unsigned CondReg = I.getOperand(0).getReg();
+  MachineBasicBlock *DestMBB = I.getOperand(1).getMBB();
+  MachineInstr *CmpMI = MRI.getVRegDef(CondReg);
+  if (!CmpMI || CmpMI->getOpcode() != TargetOpcode::G_ICMP)
+    return false;
+
+  auto Pred = static_cast<CmpInst::Predicate>(
+      CmpMI->getOperand(1).getPredicate());
+  unsigned LHS = CmpMI->getOperand(2).getReg();
+  unsigned RHS = CmpMI->getOperand(3).getReg();
+  bool Is64 = MRI.getType(LHS).getSizeInBits() == 64;
+  VECC::CondCodes CC = intCondCode(Pred);
+
+  MachineIRBuilder B(I);
+  SmallVector<MachineInstr *, 2> Insts;
+  if (CmpInst::isUnsigned(Pred)) {
+    // br.cc 0, (cmpu %r, %l)
+    unsigned Tmp = MRI.createVirtualRegister(Is64 ? &VE::I64RegClass
+                                                  : &VE::I32RegClass);
+    Insts.push_back(
+        B.buildInstr(Is64 ? VE::CMPrr : VE::CMPUWrr, {Tmp}, {RHS, LHS}));
+    Insts.push_back(B.buildInstr(Is64 ? VE::BCRLir : VE::BCRWir)
+                        .addImm(CC)
+                        .addImm(0)
+                        .addUse(Tmp)
+                        .addMBB(DestMBB));
+  } else {
+    Insts.push_back(B.buildInstr(Is64 ? VE::BCRLrr : VE::BCRWrr)
+                        .addImm(CC)
+                        .addUse(LHS)
+                        .addUse(RHS)
+                        .addMBB(DestMBB));
+  }
+
+  for (MachineInstr *MI : Insts)
+    if (!constrainSelectedInstRegOperands(*MI, TII, TRI, RBI))
+      return false;
+  I.eraseFromParent();
+  return true;
+}
+
+bool VEInstructionSelector::select(MachineInstr &I,
+                                   CodeGenCoverage &CoverageInfo) const {
+  MachineBasicBlock &MBB = *I.getParent();
+  MachineFunction &MF = *MBB.getParent();
+  MachineRegisterInfo &MRI = MF.getRegInfo();
+
+  if (!isPreISelGenericOpcode(I.getOpcode())) {
+    if (I.isCopy())
+      return selectCopy(I, MRI);
+    return true;
+  }
+
+  if (selectImpl(I, CoverageInfo))
+    return true;
+
+  using namespace TargetOpcode;
+
+  switch (I.getOpcode()) {
+  case G_CONSTANT:
+    return selectConstant(I, MRI);
+  case G_GLOBAL_VALUE:
+    return selectGlobalValue(I, MRI);
+  case G_GEP:
+    return selectGEP(I, MRI);
+  case G_LOAD:
+  case G_SEXTLOAD:
+  case G_ZEXTLOAD:
+  case G_STORE:
+    return selectLoadStore(I, MRI);
+  case G_BRCOND:
+    return selectBrCond(I, MRI);
+  case G_FRAME_INDEX: {
+    MachineInstr *MI =
+        BuildMI(MBB, I, I.getDebugLoc(), TII.get(VE::LEAasx))
+            .add(I.getOperand(0))
+            .add(I.getOperand(1))
+            .addImm(0);
+    I.eraseFromParent();
+    return constrainSelectedInstRegOperands(*MI, TII, TRI, RBI);
+  }
+  case G_PTRTOINT:
+  case G_INTTOPTR:
+    I.setDesc(TII.get(COPY));
+    return selectCopy(I, MRI);
+  case G_IMPLICIT_DEF:
+  case G_PHI: {
+    unsigned DstReg = I.getOperand(0).getReg();
+    const TargetRegisterClass *RC = getRegClass(DstReg, MRI);
+    if (!RC)
+      return false;
+    I.setDesc(TII.get(I.getOpcode() == G_PHI ? PHI : IMPLICIT_DEF));
+    return RBI.constrainGenericRegister(DstReg, *RC, MRI);
+  }
+  default:
+    return false;
+  }
+}
+
+namespace llvm {
+InstructionSelector *createVEInstructionSelector(const VETargetMachine &TM,
+                                                 VESubtarget &Subtarget,
+                                                 VERegisterBankInfo &RBI) {
+  return new VEInstructionSelector(TM, Subtarget, RBI);
+}
+} // end namespace llvm
@@ -0,0 +1,183 @@
+//===-- VEIntrinsicsToIR.cpp - Rewrite VE intrinsics to generic IR --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// VE vector intrinsics are opaque to the middle-end.  InstCombine, GVN, LICM
+// and friends cannot fold or hoist a vfaddd, even when it computes exactly
+// what an fadd on <256 x double> computes.  This pass rewrites unmasked
+// arithmetic and logical intrinsics into generic vector instructions when the
+// vector length is known to be 256, which is what the generic instruction
+// patterns select with.  Intrinsics executed under another vector length are
+// left untouched.
+//
+// The vector length is tracked per basic block: llvm.ve.lvl(256) makes it
+// known, while any other llvm.ve.lvl or any call to a function which may set
+// VL makes it unknown again.
+//
+//===----------------------------------------------------------------------===//
+
+#include "VE.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "ve-intrinsics-to-ir"
+
+STATISTIC(NumRewritten, "Number of VE intrinsics rewritten to generic IR");
+
+static cl::opt<bool> DisableIntrinsicsToIR(
+  "disable-ve-intrinsics-to-ir",
+  cl::init(false),
+  cl::desc("Don't rewrite VE vector intrinsics to generic IR."),
+  cl::Hidden);
+
+namespace {
+  struct VEIntrinsicsToIR : public FunctionPass {
+    static char ID;
+    VEIntrinsicsToIR() : FunctionPass(ID) {
+      initializeVEIntrinsicsToIRPass(*PassRegistry::getPassRegistry());
+    }
+
+    StringRef getPassName() const override {
+      return "VE intrinsics to generic IR";
+    }
+
+    void getAnalysisUsage(AnalysisUsage &AU) const override {
+      AU.setPreservesCFG();
+    }
+
+    bool runOnFunction(Function &F) override;
+
+  private:
+    Value *rewrite(IntrinsicInst *II);
+  };
+} // end anonymous namespace
+
+char VEIntrinsicsToIR::ID = 0;
+
+INITIALIZE_PASS(VEIntrinsicsToIR, DEBUG_TYPE,
+                "VE intrinsics to generic IR", false, false)
+
+static const unsigned FullVL = 256;
+
+// Returns the generic opcode computing the same as the unmasked intrinsic ID,
+// and sets IsFP if it works on doubles rather than on 64-bit integers.
+static Instruction::BinaryOps getBinaryOpcode(Intrinsic::ID ID, bool &IsFP) {
+  IsFP = false;
+  switch (ID) {
+  default: return Instruction::BinaryOpsEnd;
+#define VE_BINOP(NAME, OPC, FP)                                          \
+  case Intrinsic::ve_##NAME##_vsv:                                       \
+  case Intrinsic::ve_##NAME##_vvv:                                       \
+    IsFP = FP;                                                           \
+    return Instruction::OPC;
+  VE_BINOP(vfaddd, FAdd, true)
+  VE_BINOP(vfsubd, FSub, true)
+  VE_BINOP(vfmuld, FMul, true)
+  VE_BINOP(vfdivd, FDiv, true)
+  VE_BINOP(vaddul, Add, false)
+  VE_BINOP(vaddsl, Add, false)
+  VE_BINOP(vsubul, Sub, false)
+  VE_BINOP(vsubsl, Sub, false)
+  VE_BINOP(vmulul, Mul, false)
+  VE_BINOP(vmulsl, Mul, false)
+  VE_BINOP(vand, And, false)
+  VE_BINOP(vor, Or, false)
+  VE_BINOP(vxor, Xor, false)
+#undef VE_BINOP
+  }
+}
+
+Value *VEIntrinsicsToIR::rewrite(IntrinsicInst *II) {
+  IRBuilder<> Builder(II);
+  Type *VTy = II->getType();
+  Type *I64VTy = VectorType::get(Builder.getInt64Ty(), FullVL);
+
+  switch (II->getIntrinsicID()) {
+  case Intrinsic::ve_vbrd_vs_f64:
+    return Builder.CreateVectorSplat(FullVL, II->getArgOperand(0));
+  case Intrinsic::ve_vbrd_vs_i64:
+    return Builder.CreateBitCast(
+        Builder.CreateVectorSplat(FullVL, II->getArgOperand(0)), VTy);
+  default:
+    break;
+  }
+
+  bool IsFP;
+  Instruction::BinaryOps Opc = getBinaryOpcode(II->getIntrinsicID(), IsFP);
+  if (Opc == Instruction::BinaryOpsEnd)
+    return nullptr;
+
+  // Intrinsics pass integer vectors as <256 x double>, and the scalar operand
+  // of the vsv forms comes first.
+  auto ToOperand = [&](Value *V) -> Value * {
+    if (V->getType()->isVectorTy())
+      return IsFP ? V : Builder.CreateBitCast(V, I64VTy);
+    return Builder.CreateVectorSplat(FullVL, V);
+  };
+  Value *LHS = ToOperand(II->getArgOperand(0));
+  Value *RHS = ToOperand(II->getArgOperand(1));
+  Value *Res = Builder.CreateBinOp(Opc, LHS, RHS);
+  return IsFP ? Res : Builder.CreateBitCast(Res, VTy);
+}
+
+bool VEIntrinsicsToIR::runOnFunction(Function &F) {
+  if (DisableIntrinsicsToIR || skipFunction(F))
+    return false;
+
+  bool Changed = false;
+  for (BasicBlock &BB : F) {
+    bool KnownFullVL = false;
+    for (auto It = BB.begin(); It != BB.end();) {
+      Instruction &I = *It++;
+      auto *CI = dyn_cast<CallInst>(&I);
+      if (!CI)
+        continue;
+
+      auto *II = dyn_cast<IntrinsicInst>(CI);
+      if (II && II->getIntrinsicID() == Intrinsic::ve_lvl) {
+        auto *Len = dyn_cast<ConstantInt>(II->getArgOperand(0));
+        KnownFullVL = Len && Len->getZExtValue() == FullVL;
+        continue;
+      }
+      // Any other function may change VL behind our back.
+      if (!II) {
+        KnownFullVL = false;
+        continue;
+      }
+      if (!KnownFullVL)
+        continue;
+
+      Value *New = rewrite(II);
+      if (!New)
+        continue;
+      LLVM_DEBUG(dbgs() << "VE: rewrite " << *II << " to " << *New << "\n");
+      New->takeName(II);
+      II->replaceAllUsesWith(New);
+      II->eraseFromParent();
+      ++NumRewritten;
+      Changed = true;
+    }
+  }
+  return Changed;
+}
+
+/// createVEIntrinsicsToIRPass - Returns a pass that rewrites VE vector
+/// intrinsics executed with the full vector length to generic vector IR.
+///
+FunctionPass *llvm::createVEIntrinsicsToIRPass() {
+  return new VEIntrinsicsToIR();
+}
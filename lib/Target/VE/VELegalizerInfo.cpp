@@ -0,0 +1,107 @@
+//===-- VELegalizerInfo.cpp - VE Legalizer ----------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+/// This file implements the targeting of the Machinelegalizer class for VE.
+//===----------------------------------------------------------------------===//
+
+#include "VELegalizerInfo.h"
+#include "VESubtarget.h"
+#include "llvm/CodeGen/GlobalISel/LegalizerHelper.h"
+
+using namespace llvm;
+
+VELegalizerInfo::VELegalizerInfo(const VESubtarget &ST) {
+  using namespace TargetOpcode;
+
+  const LLT s1 = LLT::scalar(1);
+  const LLT s32 = LLT::scalar(32);
+  const LLT s64 = LLT::scalar(64);
+  const LLT s128 = LLT::scalar(128);
+  const LLT p0 = LLT::pointer(0, 64);
+
+  // Vector registers hold 256 elements of 64 bits or 512 packed elements of
+  // 32 bits.  Vector mask registers hold 256 bits, or 512 bits as a pair.
+  const LLT v256s32 = LLT::vector(256, 32);
+  const LLT v256s64 = LLT::vector(256, 64);
+  const LLT v512s32 = LLT::vector(512, 32);
+  const LLT v256s1 = LLT::vector(256, 1);
+  const LLT v512s1 = LLT::vector(512, 1);
+
+  getActionDefinitionsBuilder({G_IMPLICIT_DEF, G_PHI})
+      .legalFor({s32, s64, s128, p0, v256s32, v256s64, v512s32, v256s1,
+                 v512s1})
+      .clampScalar(0, s32, s64);
+
+  getActionDefinitionsBuilder({G_ADD, G_SUB, G_MUL, G_AND, G_OR, G_XOR})
+      .legalFor({s32, s64})
+      .clampScalar(0, s32, s64);
+
+  getActionDefinitionsBuilder({G_SDIV, G_UDIV})
+      .legalFor({s32, s64})
+      .clampScalar(0, s32, s64);
+
+  // Shift amounts are always i32, see getScalarShiftAmountTy.
+  getActionDefinitionsBuilder({G_SHL, G_ASHR, G_LSHR})
+      .legalFor({{s32, s32}, {s64, s32}})
+      .clampScalar(1, s32, s32)
+      .clampScalar(0, s32, s64);
+
+  getActionDefinitionsBuilder(G_ICMP)
+      .legalForCartesianProduct({s1}, {s32, s64, p0})
+      .clampScalar(1, s32, s64);
+
+  getActionDefinitionsBuilder(G_BRCOND).legalFor({s1});
+
+  getActionDefinitionsBuilder(G_CONSTANT)
+      .legalFor({s32, s64, p0})
+      .clampScalar(0, s32, s64);
+
+  getActionDefinitionsBuilder(G_TRUNC).legalFor({{s32, s64}});
+  getActionDefinitionsBuilder({G_ANYEXT, G_SEXT, G_ZEXT})
+      .legalFor({{s64, s32}});
+
+  // Narrow loads are any-extending loads into a 32 bit register.
+  getActionDefinitionsBuilder(G_LOAD)
+      .legalForTypesWithMemSize({{s32, p0, 8},
+                                 {s32, p0, 16},
+                                 {s32, p0, 32},
+                                 {s64, p0, 64},
+                                 {p0, p0, 64},
+                                 {s128, p0, 128}})
+      .clampScalar(0, s32, s64);
+  getActionDefinitionsBuilder({G_SEXTLOAD, G_ZEXTLOAD})
+      .legalForTypesWithMemSize({{s32, p0, 8}, {s32, p0, 16}})
+      .lower();
+  getActionDefinitionsBuilder(G_STORE)
+      .legalForTypesWithMemSize({{s32, p0, 8},
+                                 {s32, p0, 16},
+                                 {s32, p0, 32},
+                                 {s64, p0, 64},
+                                 {p0, p0, 64},
+                                 {s128, p0, 128}})
+      .clampScalar(0, s32, s64);
+
+  getActionDefinitionsBuilder(G_GEP)
+      .legalFor({{p0, s64}})
+      .clampScalar(1, s64, s64);
+
+  getActionDefinitionsBuilder({G_PTRTOINT, G_INTTOPTR})
+      .legalFor({{s64, p0}, {p0, s64}});
+
+  getActionDefinitionsBuilder({G_FRAME_INDEX, G_GLOBAL_VALUE}).legalFor({p0});
+
+  // s32 is selected to the lower half of a scalar register, which is where
+  // i32 lives.  f32 operations use the upper half, so they are not legal.
+  getActionDefinitionsBuilder({G_FADD, G_FSUB, G_FMUL})
+      .legalFor({s64, s128});
+  getActionDefinitionsBuilder(G_FDIV).legalFor({s64});
+
+  computeTables();
+  verify(*ST.getInstrInfo());
+}
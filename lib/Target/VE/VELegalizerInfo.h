@@ -0,0 +1,28 @@
+//===-- VELegalizerInfo.h - VE Legalizer ------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+/// This file declares the targeting of the Machinelegalizer class for VE.
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIB_TARGET_VE_VEMACHINELEGALIZER_H
+#define LLVM_LIB_TARGET_VE_VEMACHINELEGALIZER_H
+
+#include "llvm/CodeGen/GlobalISel/LegalizerInfo.h"
+
+namespace llvm {
+
+class VESubtarget;
+
+/// This class provides legalization strategies.
+class VELegalizerInfo : public LegalizerInfo {
+public:
+  VELegalizerInfo(const VESubtarget &ST);
+};
+} // end namespace llvm
+#endif
@@ -0,0 +1,171 @@
+//===-- VEMachineScheduler.cpp - VE Scheduler Strategy --------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// The GenericScheduler only considers a pressure set once it exceeds its
+// limit, and favors latency until then.  On VE that trade-off is wrong for
+// vector registers: a spilled vector register is a 2KB store and reload,
+// while the latency saved by issuing a vector instruction early is a few
+// cycles.  VESchedStrategy therefore compares the vector and the vector mask
+// register pressure of the candidates first whenever the pressure of either
+// set is within a margin of its limit.  The two sets are tracked separately
+// because the 16 mask registers run out independently of the 64 vector
+// registers.
+//
+// Decisions are printed with -debug-only=ve-machine-scheduler, and regions
+// close to the limits are reported with
+// -pass-remarks-analysis=ve-machine-scheduler.
+//
+//===----------------------------------------------------------------------===//
+
+#include "VEMachineScheduler.h"
+#include "VERegisterInfo.h"
+#include "llvm/CodeGen/MachineOptimizationRemarkEmitter.h"
+#include "llvm/CodeGen/MachineRegisterInfo.h"
+#include "llvm/CodeGen/RegisterClassInfo.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "ve-machine-scheduler"
+
+static cl::opt<unsigned> VRegPressureMargin(
+  "ve-sched-vreg-pressure-margin",
+  cl::init(4),
+  cl::desc("Prefer lower vector register pressure over latency once the "
+           "pressure is within this many registers of the limit."),
+  cl::Hidden);
+
+// Returns true if MI defines or reads a virtual vector or mask register.
+static bool usesVectorRegs(const MachineInstr &MI,
+                           const MachineRegisterInfo &MRI) {
+  for (const MachineOperand &MO : MI.operands()) {
+    if (!MO.isReg() || !TargetRegisterInfo::isVirtualRegister(MO.getReg()))
+      continue;
+    const TargetRegisterClass *RC = MRI.getRegClass(MO.getReg());
+    if (VE::V64RegClass.hasSubClassEq(RC) ||
+        VE::VMRegClass.hasSubClassEq(RC) ||
+        VE::VM512RegClass.hasSubClassEq(RC))
+      return true;
+  }
+  return false;
+}
+
+void VESchedStrategy::initPolicy(MachineBasicBlock::iterator Begin,
+                                 MachineBasicBlock::iterator End,
+                                 unsigned NumRegionInstrs) {
+  GenericScheduler::initPolicy(Begin, End, NumRegionInstrs);
+
+  // GenericScheduler doesn't track pressure in regions which are small
+  // compared to the scalar register file, but a handful of vector
+  // instructions may already exhaust the vector registers.
+  if (RegionPolicy.ShouldTrackPressure)
+    return;
+  const MachineRegisterInfo &MRI = Begin->getMF()->getRegInfo();
+  for (MachineBasicBlock::iterator I = Begin; I != End; ++I) {
+    if (!I->isDebugInstr() && usesVectorRegs(*I, MRI)) {
+      RegionPolicy.ShouldTrackPressure = true;
+      return;
+    }
+  }
+}
+
+void VESchedStrategy::initialize(ScheduleDAGMI *dag) {
+  GenericScheduler::initialize(dag);
+
+  const VERegisterInfo *RI = static_cast<const VERegisterInfo *>(TRI);
+  VPSet = RI->getVectorPressureSet();
+  VMPSet = RI->getVectorMaskPressureSet();
+}
+
+void VESchedStrategy::registerRoots() {
+  GenericScheduler::registerRoots();
+
+  if (!DAG->isTrackingPressure())
+    return;
+
+  // Report regions whose vector register demand is close to the limits.
+  MachineOptimizationRemarkEmitter ORE(DAG->MF, nullptr);
+  const std::vector<unsigned> &MaxPressure =
+      DAG->getRegPressure().MaxSetPressure;
+  for (unsigned PSet : {VPSet, VMPSet}) {
+    unsigned Limit = Context->RegClassInfo->getRegPressureSetLimit(PSet);
+    if (MaxPressure[PSet] + VRegPressureMargin < Limit)
+      continue;
+    LLVM_DEBUG(dbgs() << "VE: region needs " << MaxPressure[PSet] << " of "
+                      << Limit << " " << TRI->getRegPressureSetName(PSet)
+                      << " registers\n");
+    ORE.emit([&]() {
+      const MachineInstr &MI = *DAG->begin();
+      return MachineOptimizationRemarkAnalysis(DEBUG_TYPE, "VectorRegPressure",
+                                               MI.getDebugLoc(),
+                                               MI.getParent())
+             << "region needs "
+             << ore::NV("Pressure", MaxPressure[PSet]) << " of "
+             << ore::NV("Limit", Limit) << " "
+             << TRI->getRegPressureSetName(PSet) << " registers";
+    });
+  }
+}
+
+// Returns the pressure of PSet after scheduling SU at the top or the bottom
+// of the region.
+unsigned VESchedStrategy::getPressureAfter(const SUnit *SU, bool AtTop,
+                                           unsigned PSet) const {
+  // The trackers restore their state after computing the pressure.
+  RegPressureTracker &Tracker = const_cast<RegPressureTracker &>(
+      AtTop ? DAG->getTopRPTracker() : DAG->getBotRPTracker());
+  std::vector<unsigned> Pressure, MaxPressure;
+  if (AtTop)
+    Tracker.getDownwardPressure(SU->getInstr(), Pressure, MaxPressure);
+  else
+    Tracker.getUpwardPressure(SU->getInstr(), Pressure, MaxPressure);
+  return Pressure[PSet];
+}
+
+// Prefers the candidate resulting in lower pressure of PSet if the pressure
+// is close to its limit.  Returns true if this decided between the two.
+bool VESchedStrategy::tryVectorPressure(SchedCandidate &Cand,
+                                        SchedCandidate &TryCand,
+                                        SchedBoundary &Zone,
+                                        unsigned PSet) const {
+  bool AtTop = Zone.isTop();
+  const RegPressureTracker &Tracker =
+      AtTop ? DAG->getTopRPTracker() : DAG->getBotRPTracker();
+  unsigned Limit = Context->RegClassInfo->getRegPressureSetLimit(PSet);
+  if (Tracker.getRegSetPressureAtPos()[PSet] + VRegPressureMargin < Limit)
+    return false;
+
+  unsigned TryPressure = getPressureAfter(TryCand.SU, AtTop, PSet);
+  unsigned CandPressure = getPressureAfter(Cand.SU, AtTop, PSet);
+  if (!tryLess(TryPressure, CandPressure, TryCand, Cand, RegExcess))
+    return false;
+
+  LLVM_DEBUG(const SchedCandidate &Best =
+                 TryCand.Reason != NoCand ? TryCand : Cand;
+             dbgs() << "VE: prefer SU(" << Best.SU->NodeNum << ") for "
+                    << TRI->getRegPressureSetName(PSet) << " pressure "
+                    << std::min(TryPressure, CandPressure) << " over "
+                    << std::max(TryPressure, CandPressure) << " (limit "
+                    << Limit << ")\n");
+  return true;
+}
+
+void VESchedStrategy::tryCandidate(SchedCandidate &Cand,
+                                   SchedCandidate &TryCand,
+                                   SchedBoundary *Zone) const {
+  // Vector pressure only matters within one boundary; the generic heuristics
+  // compare the top and the bottom candidate.
+  if (Cand.isValid() && Zone && DAG->isTrackingPressure()) {
+    if (tryVectorPressure(Cand, TryCand, *Zone, VPSet) ||
+        tryVectorPressure(Cand, TryCand, *Zone, VMPSet))
+      return;
+  }
+  GenericScheduler::tryCandidate(Cand, TryCand, Zone);
+}
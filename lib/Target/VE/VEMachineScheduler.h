@@ -0,0 +1,55 @@
+//===-- VEMachineScheduler.h - VE Scheduler Strategy -*- C++ -*------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares the machine scheduler strategy of VE.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIB_TARGET_VE_VEMACHINESCHEDULER_H
+#define LLVM_LIB_TARGET_VE_VEMACHINESCHEDULER_H
+
+#include "llvm/CodeGen/MachineScheduler.h"
+
+namespace llvm {
+
+/// VESchedStrategy - The GenericScheduler with vector register pressure
+/// ranked above latency.  A vector register holds 256 x 64 bits, so spilling
+/// one costs a 2KB store and reload.  The generic heuristics only react to
+/// pressure once a set exceeds its limit, which is too late for the 64 vector
+/// registers.  This strategy prefers the candidate keeping the vector and
+/// the vector mask register pressure lower as soon as either gets close to
+/// its limit.
+class VESchedStrategy : public GenericScheduler {
+public:
+  VESchedStrategy(const MachineSchedContext *C) : GenericScheduler(C) {}
+
+  void initPolicy(MachineBasicBlock::iterator Begin,
+                  MachineBasicBlock::iterator End,
+                  unsigned NumRegionInstrs) override;
+
+  void initialize(ScheduleDAGMI *dag) override;
+
+  void registerRoots() override;
+
+protected:
+  void tryCandidate(SchedCandidate &Cand, SchedCandidate &TryCand,
+                    SchedBoundary *Zone) const override;
+
+private:
+  unsigned VPSet = 0;
+  unsigned VMPSet = 0;
+
+  bool tryVectorPressure(SchedCandidate &Cand, SchedCandidate &TryCand,
+                         SchedBoundary &Zone, unsigned PSet) const;
+  unsigned getPressureAfter(const SUnit *SU, bool AtTop, unsigned PSet) const;
+};
+
+} // end namespace llvm
+
+#endif
@@ -0,0 +1,78 @@
+//===-- VERegisterBankInfo.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+/// This file implements the targeting of the RegisterBankInfo class for VE.
+//===----------------------------------------------------------------------===//
+
+#include "VERegisterBankInfo.h"
+#include "MCTargetDesc/VEMCTargetDesc.h"
+#include "VEInstrInfo.h"
+#include "llvm/CodeGen/GlobalISel/RegisterBank.h"
+#include "llvm/CodeGen/MachineRegisterInfo.h"
+
+#define GET_TARGET_REGBANK_IMPL
+
+#define DEBUG_TYPE "registerbankinfo"
+
+#include "VEGenRegisterBank.inc"
+
+using namespace llvm;
+
+VERegisterBankInfo::VERegisterBankInfo(const TargetRegisterInfo &TRI)
+    : VEGenRegisterBankInfo() {}
+
+const RegisterBank &VERegisterBankInfo::getRegBankFromRegClass(
+    const TargetRegisterClass &RC) const {
+  if (VE::I64RegClass.hasSubClassEq(&RC) ||
+      VE::I32RegClass.hasSubClassEq(&RC) ||
+      VE::F32RegClass.hasSubClassEq(&RC) ||
+      VE::F128RegClass.hasSubClassEq(&RC))
+    return getRegBank(VE::GPRRegBankID);
+  if (VE::V64RegClass.hasSubClassEq(&RC))
+    return getRegBank(VE::VRRegBankID);
+  if (VE::VMRegClass.hasSubClassEq(&RC) ||
+      VE::VM512RegClass.hasSubClassEq(&RC))
+    return getRegBank(VE::VMRegBankID);
+  llvm_unreachable("Register class not supported");
+}
+
+const RegisterBank &VERegisterBankInfo::getRegBankForType(LLT Ty) const {
+  if (Ty.isVector())
+    return getRegBank(Ty.getElementType() == LLT::scalar(1)
+                          ? VE::VMRegBankID
+                          : VE::VRRegBankID);
+  return getRegBank(VE::GPRRegBankID);
+}
+
+const RegisterBankInfo::InstructionMapping &
+VERegisterBankInfo::getInstrMapping(const MachineInstr &MI) const {
+  const RegisterBankInfo::InstructionMapping &Mapping = getInstrMappingImpl(MI);
+  if (Mapping.isValid())
+    return Mapping;
+
+  const MachineFunction &MF = *MI.getParent()->getParent();
+  const MachineRegisterInfo &MRI = MF.getRegInfo();
+
+  // Every register operand stays on the bank its type implies.
+  unsigned NumOperands = MI.getNumOperands();
+  SmallVector<const ValueMapping *, 4> OpdsMapping(NumOperands, nullptr);
+  for (unsigned Idx = 0; Idx < NumOperands; ++Idx) {
+    const MachineOperand &MO = MI.getOperand(Idx);
+    if (!MO.isReg() || !MO.getReg())
+      continue;
+    LLT Ty = MRI.getType(MO.getReg());
+    if (!Ty.isValid())
+      continue;
+    OpdsMapping[Idx] =
+        &getValueMapping(0, Ty.getSizeInBits(), getRegBankForType(Ty));
+  }
+
+  return getInstructionMapping(DefaultMappingID, /*Cost=*/1,
+                               getOperandsMapping(OpdsMapping), NumOperands);
+}
@@ -0,0 +1,51 @@
+//===-- VERegisterBankInfo.h ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+/// \file
+/// This file declares the targeting of the RegisterBankInfo class for VE.
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_LIB_TARGET_VE_VEREGISTERBANKINFO_H
+#define LLVM_LIB_TARGET_VE_VEREGISTERBANKINFO_H
+
+#include "llvm/CodeGen/GlobalISel/RegisterBankInfo.h"
+
+#define GET_REGBANK_DECLARATIONS
+#include "VEGenRegisterBank.inc"
+
+namespace llvm {
+
+class LLT;
+class TargetRegisterInfo;
+
+class VEGenRegisterBankInfo : public RegisterBankInfo {
+#define GET_TARGET_REGBANK_CLASS
+#include "VEGenRegisterBank.inc"
+};
+
+/// This class provides the information for the target register banks.
+///
+/// Scalars and pointers live in the GPR bank, vectors in the VR bank, and
+/// vectors of i1 (masks) in the VM bank.  Values never move between banks,
+/// so every instruction has exactly one mapping.
+class VERegisterBankInfo final : public VEGenRegisterBankInfo {
+public:
+  VERegisterBankInfo(const TargetRegisterInfo &TRI);
+
+  const RegisterBank &
+  getRegBankFromRegClass(const TargetRegisterClass &RC) const override;
+
+  const InstructionMapping &
+  getInstrMapping(const MachineInstr &MI) const override;
+
+private:
+  /// Returns the register bank used to hold a value of type \p Ty.
+  const RegisterBank &getRegBankForType(LLT Ty) const;
+};
+} // end namespace llvm
+#endif
@@ -39,6 +39,16 @@ VERegisterInfo::VERegisterInfo() : VEGenRegisterInfo(VE::SX10) {
   assert(*PSet != -1);
   VLSPSetID = *PSet++;
   assert(*PSet == -1);
+
+  // Initialize VPSetID and VMPSetID
+  PSet = getRegClassPressureSets(&VE::V64RegClass);
+  assert(*PSet != -1);
+  VPSetID = *PSet++;
+  assert(*PSet == -1);
+  PSet = getRegClassPressureSets(&VE::VMRegClass);
+  assert(*PSet != -1);
+  VMPSetID = *PSet++;
+  assert(*PSet == -1);
 }
 
 bool VERegisterInfo::requiresRegisterScavenging(
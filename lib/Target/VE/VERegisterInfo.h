@@ -24,10 +24,16 @@ struct VERegisterInfo : public VEGenRegisterInfo {
 private:
   // VLS register class's Pressure Set ID.
   unsigned VLSPSetID;
+  // V64 and VM register classes' Pressure Set IDs.
+  unsigned VPSetID;
+  unsigned VMPSetID;
 
 public:
   VERegisterInfo();
 
+  unsigned getVectorPressureSet() const { return VPSetID; }
+  unsigned getVectorMaskPressureSet() const { return VMPSetID; }
+
   /// Code Generation virtual methods...
   const MCPhysReg *getCalleeSavedRegs(const MachineFunction *MF) const override;
   const uint32_t *getCallPreservedMask(const MachineFunction &MF,
@@ -0,0 +1,232 @@
+//===-- VESelectionDAGInfo.cpp - VE SelectionDAG Info ---------------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the VESelectionDAGInfo class.  Constant sized memcpy,
+// memmove and memset which are too large for the generic scalar expansion
+// are lowered inline to strip-mined VLD/VST sequences.  Each strip moves up
+// to 256 8-byte words with the vector length set to the number of words in
+// the strip, and the last few bytes are handled by scalar loads and stores.
+//
+// Operations of variable size are left to the library call.  Expanding them
+// inline needs a loop, which SelectionDAG can't build.  memcmp isn't lowered
+// here either: a vector compare of the strips would still need a scalar
+// search for the first differing byte to compute the result.
+//
+//===----------------------------------------------------------------------===//
+
+#include "VESelectionDAGInfo.h"
+#include "VEISelLowering.h"
+#include "llvm/CodeGen/SelectionDAG.h"
+#include "llvm/Support/CommandLine.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "ve-selectiondag-info"
+
+static cl::opt<unsigned> MaxInlineStrips(
+    "ve-max-inline-mem-strips", cl::Hidden, cl::init(16),
+    cl::desc("Maximum number of vector strips emitted for an inline "
+             "memcpy/memmove/memset on VE"));
+
+/// Maximum vector length.  A strip moves up to this many 8-byte words.
+static const unsigned MaxVL = 256;
+
+namespace {
+/// A piece of an inline memory operation.  NumElts != 0 means a strip of
+/// NumElts 8-byte words moved by VLD/VST.  Otherwise the piece is a scalar
+/// of MemVT used for the tail.
+struct MemPiece {
+  uint64_t Offset;
+  unsigned NumElts;
+  MVT MemVT;
+};
+} // end anonymous namespace
+
+/// Split \p Size bytes into vector strips followed by scalar pieces.  Return
+/// false if the operation needs more than MaxInlineStrips strips.
+static bool splitMemOp(uint64_t Size, SmallVectorImpl<MemPiece> &Pieces) {
+  uint64_t Words = Size / 8;
+  if (Words == 0 || (Words + MaxVL - 1) / MaxVL > MaxInlineStrips)
+    return false;
+
+  uint64_t Offset = 0;
+  while (Words != 0) {
+    unsigned NumElts = std::min<uint64_t>(Words, MaxVL);
+    Pieces.push_back({Offset, NumElts, MVT::v256f64});
+    Offset += NumElts * 8;
+    Words -= NumElts;
+  }
+  for (MVT VT : {MVT::i32, MVT::i16, MVT::i8}) {
+    unsigned Bytes = VT.getStoreSize();
+    if (Size - Offset >= Bytes) {
+      Pieces.push_back({Offset, 0, VT});
+      Offset += Bytes;
+    }
+  }
+  assert(Offset == Size && "Pieces don't cover the whole operation");
+  return true;
+}
+
+/// The memory type of the strip \p P.  Only its first NumElts words are
+/// accessed.
+static EVT getStripVT(SelectionDAG &DAG, const MemPiece &P) {
+  return EVT::getVectorVT(*DAG.getContext(), MVT::f64, P.NumElts);
+}
+
+static SDValue emitLoad(SelectionDAG &DAG, const SDLoc &dl, SDValue Chain,
+                        SDValue Base, const MemPiece &P,
+                        MachinePointerInfo PtrInfo, unsigned Align,
+                        bool isVolatile) {
+  SDValue Ptr = DAG.getMemBasePlusOffset(Base, P.Offset, dl);
+  PtrInfo = PtrInfo.getWithOffset(P.Offset);
+  Align = MinAlign(Align, P.Offset);
+  MachineMemOperand::Flags Flags =
+      isVolatile ? MachineMemOperand::MOVolatile : MachineMemOperand::MONone;
+
+  if (P.NumElts == 0)
+    return DAG.getExtLoad(ISD::EXTLOAD, dl, MVT::i32, Chain, Ptr, PtrInfo,
+                          P.MemVT, Align, Flags);
+
+  SDValue Ops[] = {Chain, DAG.getConstant(8, dl, MVT::i64), Ptr,
+                   DAG.getConstant(P.NumElts, dl, MVT::i32)};
+  return DAG.getMemIntrinsicNode(
+      VEISD::VEC_VLD, dl, DAG.getVTList(MVT::v256f64, MVT::Other), Ops,
+      getStripVT(DAG, P), PtrInfo, Align, MachineMemOperand::MOLoad | Flags);
+}
+
+static SDValue emitStore(SelectionDAG &DAG, const SDLoc &dl, SDValue Chain,
+                         SDValue Val, SDValue Base, const MemPiece &P,
+                         MachinePointerInfo PtrInfo, unsigned Align,
+                         bool isVolatile) {
+  SDValue Ptr = DAG.getMemBasePlusOffset(Base, P.Offset, dl);
+  PtrInfo = PtrInfo.getWithOffset(P.Offset);
+  Align = MinAlign(Align, P.Offset);
+  MachineMemOperand::Flags Flags =
+      isVolatile ? MachineMemOperand::MOVolatile : MachineMemOperand::MONone;
+
+  if (P.NumElts == 0)
+    return DAG.getTruncStore(Chain, dl, Val, Ptr, PtrInfo, P.MemVT, Align,
+                             Flags);
+
+  SDValue Ops[] = {Chain, Val, DAG.getConstant(8, dl, MVT::i64), Ptr,
+                   DAG.getConstant(P.NumElts, dl, MVT::i32)};
+  return DAG.getMemIntrinsicNode(VEISD::VEC_VST, dl,
+                                 DAG.getVTList(MVT::Other), Ops,
+                                 getStripVT(DAG, P), PtrInfo, Align,
+                                 MachineMemOperand::MOStore | Flags);
+}
+
+/// Copy \p Size bytes from \p Src to \p Dst.  If \p LoadFirst is set, every
+/// piece is loaded before anything is stored so that overlapping operands
+/// are handled correctly.
+static SDValue emitCopy(SelectionDAG &DAG, const SDLoc &dl, SDValue Chain,
+                        SDValue Dst, SDValue Src, uint64_t Size, unsigned Align,
+                        bool isVolatile, bool LoadFirst,
+                        MachinePointerInfo DstPtrInfo,
+                        MachinePointerInfo SrcPtrInfo) {
+  // Every 8-byte word is moved by a single element access, so both operands
+  // must be 8-byte aligned.
+  if (Align < 8)
+    return SDValue();
+
+  SmallVector<MemPiece, 16> Pieces;
+  if (!splitMemOp(Size, Pieces))
+    return SDValue();
+  // Every piece of a memmove is live in a register at once, so allow half
+  // as many.
+  if (LoadFirst && Pieces.size() > MaxInlineStrips / 2)
+    return SDValue();
+
+  if (!LoadFirst) {
+    // The strips share the VL register, so keep them in order.
+    for (const MemPiece &P : Pieces) {
+      SDValue Val = emitLoad(DAG, dl, Chain, Src, P, SrcPtrInfo, Align,
+                             isVolatile);
+      Chain = emitStore(DAG, dl, Val.getValue(1), Val, Dst, P, DstPtrInfo,
+                        Align, isVolatile);
+    }
+    return Chain;
+  }
+
+  SmallVector<SDValue, 16> Vals;
+  SmallVector<SDValue, 16> Chains;
+  for (const MemPiece &P : Pieces) {
+    SDValue Val = emitLoad(DAG, dl, Chain, Src, P, SrcPtrInfo, Align,
+                           isVolatile);
+    Vals.push_back(Val);
+    Chains.push_back(Val.getValue(1));
+  }
+  Chain = DAG.getNode(ISD::TokenFactor, dl, MVT::Other, Chains);
+  Chains.clear();
+  for (unsigned i = 0, e = Pieces.size(); i != e; ++i)
+    Chains.push_back(emitStore(DAG, dl, Chain, Vals[i], Dst, Pieces[i],
+                               DstPtrInfo, Align, isVolatile));
+  return DAG.getNode(ISD::TokenFactor, dl, MVT::Other, Chains);
+}
+
+SDValue VESelectionDAGInfo::EmitTargetCodeForMemcpy(
+    SelectionDAG &DAG, const SDLoc &dl, SDValue Chain, SDValue Dst, SDValue Src,
+    SDValue Size, unsigned Align, bool isVolatile, bool AlwaysInline,
+    MachinePointerInfo DstPtrInfo, MachinePointerInfo SrcPtrInfo) const {
+  ConstantSDNode *ConstantSize = dyn_cast<ConstantSDNode>(Size);
+  if (!ConstantSize)
+    return SDValue();
+
+  return emitCopy(DAG, dl, Chain, Dst, Src, ConstantSize->getZExtValue(),
+                  Align, isVolatile, false, DstPtrInfo, SrcPtrInfo);
+}
+
+SDValue VESelectionDAGInfo::EmitTargetCodeForMemmove(
+    SelectionDAG &DAG, const SDLoc &dl, SDValue Chain, SDValue Dst, SDValue Src,
+    SDValue Size, unsigned Align, bool isVolatile,
+    MachinePointerInfo DstPtrInfo, MachinePointerInfo SrcPtrInfo) const {
+  ConstantSDNode *ConstantSize = dyn_cast<ConstantSDNode>(Size);
+  if (!ConstantSize)
+    return SDValue();
+
+  return emitCopy(DAG, dl, Chain, Dst, Src, ConstantSize->getZExtValue(),
+                  Align, isVolatile, true, DstPtrInfo, SrcPtrInfo);
+}
+
+SDValue VESelectionDAGInfo::EmitTargetCodeForMemset(
+    SelectionDAG &DAG, const SDLoc &dl, SDValue Chain, SDValue Dst,
+    SDValue Byte, SDValue Size, unsigned Align, bool isVolatile,
+    MachinePointerInfo DstPtrInfo) const {
+  ConstantSDNode *ConstantSize = dyn_cast<ConstantSDNode>(Size);
+  if (!ConstantSize || Align < 8)
+    return SDValue();
+
+  SmallVector<MemPiece, 16> Pieces;
+  if (!splitMemOp(ConstantSize->getZExtValue(), Pieces))
+    return SDValue();
+
+  // Replicate the byte into all 8 bytes of a word.
+  const uint64_t Splat = 0x0101010101010101ULL;
+  SDValue Pattern;
+  if (ConstantSDNode *C = dyn_cast<ConstantSDNode>(Byte)) {
+    Pattern = DAG.getConstant((C->getZExtValue() & 0xff) * Splat, dl,
+                              MVT::i64);
+  } else {
+    Pattern = DAG.getZExtOrTrunc(Byte, dl, MVT::i64);
+    if (Byte.getValueType() != MVT::i8)
+      Pattern = DAG.getZeroExtendInReg(Pattern, dl, MVT::i8);
+    Pattern = DAG.getNode(ISD::MUL, dl, MVT::i64, Pattern,
+                          DAG.getConstant(Splat, dl, MVT::i64));
+  }
+  SDValue Vec = DAG.getBitcast(
+      MVT::v256f64, DAG.getNode(VEISD::VEC_BROADCAST, dl, MVT::v256i64,
+                                Pattern));
+  SDValue Scalar = DAG.getNode(ISD::TRUNCATE, dl, MVT::i32, Pattern);
+
+  // The strips share the VL register, so keep them in order.
+  for (const MemPiece &P : Pieces)
+    Chain = emitStore(DAG, dl, Chain, P.NumElts ? Vec : Scalar, Dst, P,
+                      DstPtrInfo, Align, isVolatile);
+  return Chain;
+}
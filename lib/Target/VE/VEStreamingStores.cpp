@@ -0,0 +1,171 @@
+//===-- VEStreamingStores.cpp - Mark streaming stores nontemporal ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Streaming kernels like copy or triad write large arrays which are not read
+// again soon.  Caching such write-once data only evicts useful lines from the
+// LLC.  This pass finds vector stores in innermost loops which
+//   - write consecutive memory,
+//   - cover more bytes than the threshold in total, and
+//   - write an object which no load in the loop reads,
+// and marks them !nontemporal so that they are selected to VST.nc.
+//
+//===----------------------------------------------------------------------===//
+
+#include "VE.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "ve-streaming-stores"
+
+STATISTIC(NumNTStores, "Number of stores marked nontemporal");
+
+static cl::opt<bool> DisableStreamingStores(
+  "disable-ve-streaming-stores",
+  cl::init(false),
+  cl::desc("Don't mark large streaming stores nontemporal."),
+  cl::Hidden);
+
+// The LLC of VE is 16MB, so the default threshold is the size of the LLC.
+static cl::opt<uint64_t> StreamingStoreThreshold(
+  "ve-streaming-store-threshold",
+  cl::init(16 << 20),
+  cl::desc("Minimum number of bytes written by a loop store to mark it "
+           "nontemporal."),
+  cl::Hidden);
+
+namespace {
+  struct VEStreamingStores : public FunctionPass {
+    static char ID;
+    VEStreamingStores() : FunctionPass(ID) {
+      initializeVEStreamingStoresPass(*PassRegistry::getPassRegistry());
+    }
+
+    StringRef getPassName() const override {
+      return "VE streaming store marking";
+    }
+
+    void getAnalysisUsage(AnalysisUsage &AU) const override {
+      AU.addRequired<LoopInfoWrapperPass>();
+      AU.addRequired<ScalarEvolutionWrapperPass>();
+      AU.setPreservesAll();
+    }
+
+    bool runOnFunction(Function &F) override;
+
+  private:
+    ScalarEvolution *SE;
+
+    bool isStreamingStore(StoreInst *SI, Loop *L, unsigned TripCount,
+                          const SmallPtrSetImpl<Value *> &ReadObjects);
+    bool runOnLoop(Loop *L);
+  };
+} // end anonymous namespace
+
+char VEStreamingStores::ID = 0;
+
+INITIALIZE_PASS_BEGIN(VEStreamingStores, DEBUG_TYPE,
+                      "VE streaming store marking", false, false)
+INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(ScalarEvolutionWrapperPass)
+INITIALIZE_PASS_END(VEStreamingStores, DEBUG_TYPE,
+                    "VE streaming store marking", false, false)
+
+bool VEStreamingStores::isStreamingStore(
+    StoreInst *SI, Loop *L, unsigned TripCount,
+    const SmallPtrSetImpl<Value *> &ReadObjects) {
+  if (!SI->isSimple() || SI->getMetadata(LLVMContext::MD_nontemporal) ||
+      !SI->getValueOperand()->getType()->isVectorTy())
+    return false;
+
+  const DataLayout &DL = SI->getModule()->getDataLayout();
+  Value *Ptr = SI->getPointerOperand();
+  uint64_t Size = DL.getTypeStoreSize(SI->getValueOperand()->getType());
+
+  // The store must write consecutive memory on consecutive iterations.
+  const auto *AR = dyn_cast<SCEVAddRecExpr>(SE->getSCEV(Ptr));
+  if (!AR || AR->getLoop() != L || !AR->isAffine())
+    return false;
+  const auto *Step = dyn_cast<SCEVConstant>(AR->getStepRecurrence(*SE));
+  if (!Step || Step->getAPInt().abs() != Size)
+    return false;
+
+  if (Size * TripCount < StreamingStoreThreshold)
+    return false;
+
+  // Data read in the same loop is better kept in the cache.
+  Value *Obj = GetUnderlyingObject(Ptr, DL);
+  return !ReadObjects.count(Obj);
+}
+
+bool VEStreamingStores::runOnLoop(Loop *L) {
+  unsigned TripCount = SE->getSmallConstantMaxTripCount(L);
+  if (TripCount == 0)
+    return false;
+
+  const DataLayout &DL = L->getHeader()->getModule()->getDataLayout();
+  SmallPtrSet<Value *, 8> ReadObjects;
+  SmallVector<StoreInst *, 8> Stores;
+  for (BasicBlock *BB : L->blocks()) {
+    for (Instruction &I : *BB) {
+      if (auto *LI = dyn_cast<LoadInst>(&I))
+        ReadObjects.insert(GetUnderlyingObject(LI->getPointerOperand(), DL));
+      else if (auto *SI = dyn_cast<StoreInst>(&I))
+        Stores.push_back(SI);
+      else if (I.mayReadFromMemory())
+        return false; // Calls may read anything.
+    }
+  }
+
+  bool Changed = false;
+  LLVMContext &Ctx = L->getHeader()->getContext();
+  for (StoreInst *SI : Stores) {
+    if (!isStreamingStore(SI, L, TripCount, ReadObjects))
+      continue;
+    LLVM_DEBUG(dbgs() << "VE: mark streaming store nontemporal: " << *SI
+                      << "\n");
+    SI->setMetadata(LLVMContext::MD_nontemporal,
+                    MDNode::get(Ctx, ConstantAsMetadata::get(ConstantInt::get(
+                                         Type::getInt32Ty(Ctx), 1))));
+    ++NumNTStores;
+    Changed = true;
+  }
+  return Changed;
+}
+
+bool VEStreamingStores::runOnFunction(Function &F) {
+  if (DisableStreamingStores || skipFunction(F))
+    return false;
+
+  LoopInfo &LI = getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+  SE = &getAnalysis<ScalarEvolutionWrapperPass>().getSE();
+
+  bool Changed = false;
+  for (Loop *L : LI.getLoopsInPreorder())
+    if (L->empty())
+      Changed |= runOnLoop(L);
+  return Changed;
+}
+
+/// createVEStreamingStoresPass - Returns a pass that marks large streaming
+/// stores in loops nontemporal.
+///
+FunctionPass *llvm::createVEStreamingStoresPass() {
+  return new VEStreamingStores();
+}
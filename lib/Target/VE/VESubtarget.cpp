@@ -13,6 +13,10 @@
 
 #include "VESubtarget.h"
 #include "VE.h"
+#include "VECallLowering.h"
+#include "VELegalizerInfo.h"
+#include "VERegisterBankInfo.h"
+#include "VETargetMachine.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/TargetRegistry.h"
 
@@ -43,7 +47,31 @@ VESubtarget::VESubtarget(const Triple &TT, const std::string &CPU,
                          const std::string &FS, const TargetMachine &TM)
     : VEGenSubtargetInfo(TT, CPU, FS), TargetTriple(TT),
       InstrInfo(initializeSubtargetDependencies(CPU, FS)), TLInfo(TM, *this),
-      FrameLowering(*this) {}
+      FrameLowering(*this) {
+  CallLoweringInfo.reset(new VECallLowering(*getTargetLowering()));
+  Legalizer.reset(new VELegalizerInfo(*this));
+
+  auto *RBI = new VERegisterBankInfo(*getRegisterInfo());
+  RegBankInfo.reset(RBI);
+  InstSelector.reset(createVEInstructionSelector(
+      *static_cast<const VETargetMachine *>(&TM), *this, *RBI));
+}
+
+const CallLowering *VESubtarget::getCallLowering() const {
+  return CallLoweringInfo.get();
+}
+
+const InstructionSelector *VESubtarget::getInstructionSelector() const {
+  return InstSelector.get();
+}
+
+const LegalizerInfo *VESubtarget::getLegalizerInfo() const {
+  return Legalizer.get();
+}
+
+const RegisterBankInfo *VESubtarget::getRegBankInfo() const {
+  return RegBankInfo.get();
+}
 
 int VESubtarget::getAdjustedFrameSize(int frameSize) const {
 
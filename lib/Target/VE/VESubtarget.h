@@ -17,7 +17,11 @@
 #include "VEFrameLowering.h"
 #include "VEISelLowering.h"
 #include "VEInstrInfo.h"
-#include "llvm/CodeGen/SelectionDAGTargetInfo.h"
+#include "VESelectionDAGInfo.h"
+#include "llvm/CodeGen/GlobalISel/CallLowering.h"
+#include "llvm/CodeGen/GlobalISel/InstructionSelector.h"
+#include "llvm/CodeGen/GlobalISel/LegalizerInfo.h"
+#include "llvm/CodeGen/GlobalISel/RegisterBankInfo.h"
 #include "llvm/CodeGen/TargetFrameLowering.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
 #include "llvm/IR/DataLayout.h"
@@ -35,9 +39,15 @@ class VESubtarget : public VEGenSubtargetInfo {
 
   VEInstrInfo InstrInfo;
   VETargetLowering TLInfo;
-  SelectionDAGTargetInfo TSInfo;
+  VESelectionDAGInfo TSInfo;
   VEFrameLowering FrameLowering;
 
+  /// GlobalISel related APIs.
+  std::unique_ptr<CallLowering> CallLoweringInfo;
+  std::unique_ptr<LegalizerInfo> Legalizer;
+  std::unique_ptr<RegisterBankInfo> RegBankInfo;
+  std::unique_ptr<InstructionSelector> InstSelector;
+
 public:
   VESubtarget(const Triple &TT, const std::string &CPU,
               const std::string &FS, const TargetMachine &TM);
@@ -52,12 +62,22 @@ public:
   const VETargetLowering *getTargetLowering() const override {
     return &TLInfo;
   }
-  const SelectionDAGTargetInfo *getSelectionDAGInfo() const override {
+  const VESelectionDAGInfo *getSelectionDAGInfo() const override {
     return &TSInfo;
   }
 
+  const CallLowering *getCallLowering() const override;
+  const InstructionSelector *getInstructionSelector() const override;
+  const LegalizerInfo *getLegalizerInfo() const override;
+  const RegisterBankInfo *getRegBankInfo() const override;
+
   bool enableMachineScheduler() const override;
 
+  bool isXRaySupported() const override { return true; }
+
+  /// Line size of the last level cache in bytes.
+  unsigned getCacheLineSize() const { return 128; }
+
   /// ParseSubtargetFeatures - Parses features string setting specified
   /// subtarget options.  Definition of function is auto generated by tblgen.
   void ParseSubtargetFeatures(StringRef CPU, StringRef FS);
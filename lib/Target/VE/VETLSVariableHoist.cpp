@@ -0,0 +1,172 @@
+//===-- VETLSVariableHoist.cpp - Compute TLS addresses once ---------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// VE accesses every thread-local variable through the general dynamic model,
+// i.e. a call to __tls_get_addr, because nld doesn't accept the other models.
+// SelectionDAG lowers each reference in each basic block separately, so a
+// thread-local variable used in a loop costs a call per iteration.
+//
+// The address of a thread-local variable doesn't change within a thread, so
+// this pass computes it once per function.  It materializes the address in
+// a no-op bitcast placed at the nearest common dominator of all uses, hoists
+// it out of loops into their preheaders, and rewrites the uses.  CodeGenPrepare
+// doesn't sink casts of constants, so the address is lowered only once.
+//
+//===----------------------------------------------------------------------===//
+
+#include "VE.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/Pass.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Debug.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "ve-tls-hoist"
+
+STATISTIC(NumHoisted, "Number of thread-local addresses hoisted");
+
+static cl::opt<bool> DisableTLSHoist(
+  "disable-ve-tls-hoist",
+  cl::init(false),
+  cl::desc("Don't compute the address of thread-local variables once per "
+           "function."),
+  cl::Hidden);
+
+namespace {
+  struct VETLSVariableHoist : public FunctionPass {
+    static char ID;
+    VETLSVariableHoist() : FunctionPass(ID) {
+      initializeVETLSVariableHoistPass(*PassRegistry::getPassRegistry());
+    }
+
+    StringRef getPassName() const override {
+      return "VE thread-local address hoisting";
+    }
+
+    void getAnalysisUsage(AnalysisUsage &AU) const override {
+      AU.addRequired<DominatorTreeWrapperPass>();
+      AU.addRequired<LoopInfoWrapperPass>();
+      AU.setPreservesCFG();
+    }
+
+    bool runOnFunction(Function &F) override;
+
+  private:
+    DominatorTree *DT;
+    LoopInfo *LI;
+
+    bool hoist(GlobalVariable *GV, ArrayRef<Use *> Uses);
+  };
+} // end anonymous namespace
+
+char VETLSVariableHoist::ID = 0;
+
+INITIALIZE_PASS_BEGIN(VETLSVariableHoist, DEBUG_TYPE,
+                      "VE thread-local address hoisting", false, false)
+INITIALIZE_PASS_DEPENDENCY(DominatorTreeWrapperPass)
+INITIALIZE_PASS_DEPENDENCY(LoopInfoWrapperPass)
+INITIALIZE_PASS_END(VETLSVariableHoist, DEBUG_TYPE,
+                    "VE thread-local address hoisting", false, false)
+
+// Returns the thread-local variable referenced by operand U, either directly
+// or as the base of a constant expression like a GEP.
+static GlobalVariable *getThreadLocal(Use &U) {
+  Value *V = U.get();
+  if (auto *CE = dyn_cast<ConstantExpr>(V))
+    V = CE->getOperand(0);
+  auto *GV = dyn_cast<GlobalVariable>(V);
+  return GV && GV->isThreadLocal() ? GV : nullptr;
+}
+
+// Returns the instruction before which operand U is computed.
+static Instruction *getUsePoint(Use &U) {
+  auto *User = cast<Instruction>(U.getUser());
+  if (auto *PN = dyn_cast<PHINode>(User))
+    return PN->getIncomingBlock(U)->getTerminator();
+  return User;
+}
+
+bool VETLSVariableHoist::hoist(GlobalVariable *GV, ArrayRef<Use *> Uses) {
+  BasicBlock *BB = getUsePoint(*Uses.front())->getParent();
+  for (Use *U : Uses.drop_front())
+    BB = DT->findNearestCommonDominator(BB, getUsePoint(*U)->getParent());
+
+  // A single reference outside of loops is already computed only once.
+  Loop *L = LI->getLoopFor(BB);
+  if (Uses.size() == 1 && !L)
+    return false;
+
+  // Move out of loops as far as preheaders allow.
+  for (; L; L = L->getParentLoop()) {
+    BasicBlock *Preheader = L->getLoopPreheader();
+    if (!Preheader)
+      break;
+    BB = Preheader;
+  }
+
+  BasicBlock::iterator InsertPt = BB->getFirstInsertionPt();
+  if (InsertPt == BB->end())
+    return false;
+
+  auto *Addr = new BitCastInst(GV, GV->getType(), GV->getName() + ".addr",
+                               &*InsertPt);
+  LLVM_DEBUG(dbgs() << "VE: hoist address of " << GV->getName() << " to "
+                    << BB->getName() << "\n");
+  for (Use *U : Uses) {
+    if (auto *CE = dyn_cast<ConstantExpr>(U->get())) {
+      Instruction *I = CE->getAsInstruction();
+      I->insertBefore(getUsePoint(*U));
+      I->replaceUsesOfWith(GV, Addr);
+      U->set(I);
+    } else {
+      U->set(Addr);
+    }
+  }
+  ++NumHoisted;
+  return true;
+}
+
+bool VETLSVariableHoist::runOnFunction(Function &F) {
+  if (DisableTLSHoist || skipFunction(F))
+    return false;
+
+  DT = &getAnalysis<DominatorTreeWrapperPass>().getDomTree();
+  LI = &getAnalysis<LoopInfoWrapperPass>().getLoopInfo();
+
+  MapVector<GlobalVariable *, SmallVector<Use *, 4>> TLSUses;
+  for (BasicBlock &BB : F) {
+    if (!DT->isReachableFromEntry(&BB))
+      continue;
+    for (Instruction &I : BB)
+      for (Use &U : I.operands())
+        if (GlobalVariable *GV = getThreadLocal(U))
+          if (!isa<PHINode>(I) ||
+              DT->isReachableFromEntry(getUsePoint(U)->getParent()))
+            TLSUses[GV].push_back(&U);
+  }
+
+  bool Changed = false;
+  for (auto &Entry : TLSUses)
+    Changed |= hoist(Entry.first, Entry.second);
+  return Changed;
+}
+
+/// createVETLSVariableHoistPass - Returns a pass that computes the address of
+/// each thread-local variable once per function.
+///
+FunctionPass *llvm::createVETLSVariableHoistPass() {
+  return new VETLSVariableHoist();
+}
@@ -12,18 +12,46 @@
 
 #include "VETargetMachine.h"
 #include "VE.h"
+#include "VEMachineScheduler.h"
 // #include "VETargetObjectFile.h"
 #include "VETargetTransformInfo.h"
+#include "llvm/CodeGen/GlobalISel/IRTranslator.h"
+#include "llvm/CodeGen/GlobalISel/InstructionSelect.h"
+#include "llvm/CodeGen/GlobalISel/Legalizer.h"
+#include "llvm/CodeGen/GlobalISel/RegBankSelect.h"
+#include "llvm/CodeGen/MachineScheduler.h"
 #include "llvm/CodeGen/Passes.h"
 #include "llvm/CodeGen/TargetLoweringObjectFileImpl.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/IR/LegacyPassManager.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/TargetRegistry.h"
+#include "llvm/Transforms/IPO/PassManagerBuilder.h"
+#include "llvm/Transforms/Scalar.h"
 using namespace llvm;
 
+static cl::opt<bool> EnableMachineCombiner(
+  "ve-machine-combiner",
+  cl::init(true),
+  cl::desc("Reassociate chains of additions with the machine combiner."),
+  cl::Hidden);
+
+static cl::opt<bool> EnableChunkLoopOpt(
+  "ve-enable-chunk-loop-opt",
+  cl::init(false),
+  cl::desc("Optimize loops processing VL-sized chunks."),
+  cl::Hidden);
+
 extern "C" void LLVMInitializeVETarget() {
   // Register the target.
   RegisterTargetMachine<VETargetMachine> X(getTheVETarget());
+
+  PassRegistry &PR = *PassRegistry::getPassRegistry();
+  initializeGlobalISel(PR);
+  initializeVEIntrinsicsToIRPass(PR);
+  initializeVEChunkLoopOptPass(PR);
+  initializeVEStreamingStoresPass(PR);
+  initializeVETLSVariableHoistPass(PR);
 }
 
 static std::string computeDataLayout(const Triple &T) {
@@ -90,6 +118,9 @@ VETargetMachine::VETargetMachine(
       TLOF(createTLOF()),
       Subtarget(TT, CPU, FS, *this) {
   initAsmInfo();
+
+  // The MachineOutliner runs with -enable-machine-outliner.
+  setMachineOutliner(true);
 }
 
 VETargetMachine::~VETargetMachine() {}
@@ -98,6 +129,16 @@ TargetTransformInfo VETargetMachine::getTargetTransformInfo(const Function &F) {
   return TargetTransformInfo(VETTIImpl(this, F));
 }
 
+void VETargetMachine::adjustPassManager(PassManagerBuilder &Builder) {
+  // Rewrite intrinsics before the first InstCombine so that the whole
+  // optimization pipeline sees generic vector IR.
+  Builder.addExtension(
+      PassManagerBuilder::EP_EarlyAsPossible,
+      [](const PassManagerBuilder &, legacy::PassManagerBase &PM) {
+        PM.add(createVEIntrinsicsToIRPass());
+      });
+}
+
 namespace {
 /// VE Code Generator Pass Configuration Options.
 class VEPassConfig : public TargetPassConfig {
@@ -109,8 +150,23 @@ public:
     return getTM<VETargetMachine>();
   }
 
+  ScheduleDAGInstrs *
+  createMachineScheduler(MachineSchedContext *C) const override {
+    ScheduleDAGMILive *DAG =
+        new ScheduleDAGMILive(C, llvm::make_unique<VESchedStrategy>(C));
+    DAG->addMutation(createCopyConstrainDAGMutation(DAG->TII, DAG->TRI));
+    DAG->addMutation(createLoadClusterDAGMutation(DAG->TII, DAG->TRI));
+    DAG->addMutation(createStoreClusterDAGMutation(DAG->TII, DAG->TRI));
+    return DAG;
+  }
+
   void addIRPasses() override;
   bool addInstSelector() override;
+  bool addIRTranslator() override;
+  bool addLegalizeMachineIR() override;
+  bool addRegBankSelect() override;
+  bool addGlobalInstructionSelect() override;
+  bool addILPOpts() override;
   void addPreRegAlloc() override;
   void addPreEmitPass() override;
 };
@@ -122,7 +178,22 @@ TargetPassConfig *VETargetMachine::createPassConfig(PassManagerBase &PM) {
 
 void VEPassConfig::addIRPasses() {
   addPass(createAtomicExpandPass());
+
+  // Clean up loops processing VL chunks, mark streaming stores and insert
+  // prefetches before LSR rewrites their address computations. The chunk loop
+  // optimization duplicates the loops it versions, so it is opt-in.
+  if (getOptLevel() != CodeGenOpt::None) {
+    if (EnableChunkLoopOpt)
+      addPass(createVEChunkLoopOptPass());
+    addPass(createVEStreamingStoresPass());
+    addPass(createLoopDataPrefetchPass());
+  }
+
   TargetPassConfig::addIRPasses();
+
+  // Call __tls_get_addr once per function and thread-local variable.
+  if (getOptLevel() != CodeGenOpt::None)
+    addPass(createVETLSVariableHoistPass());
 }
 
 bool VEPassConfig::addInstSelector() {
@@ -130,11 +201,40 @@ bool VEPassConfig::addInstSelector() {
   return false;
 }
 
+bool VEPassConfig::addIRTranslator() {
+  addPass(new IRTranslator());
+  return false;
+}
+
+bool VEPassConfig::addLegalizeMachineIR() {
+  addPass(new Legalizer());
+  return false;
+}
+
+bool VEPassConfig::addRegBankSelect() {
+  addPass(new RegBankSelect());
+  return false;
+}
+
+bool VEPassConfig::addGlobalInstructionSelect() {
+  addPass(new InstructionSelect());
+  return false;
+}
+
+bool VEPassConfig::addILPOpts() {
+  // Shorten the critical path of address computations like
+  // ((base + i) + j) + k by computing base + i and j + k in parallel.
+  if (EnableMachineCombiner)
+    addPass(&MachineCombinerID);
+  return EnableMachineCombiner;
+}
+
 void VEPassConfig::addPreRegAlloc() {
   addPass(createVEPromoteToI1Pass());
 }
 
 void VEPassConfig::addPreEmitPass(){
+  addPass(&BranchRelaxationPassID);
 #if 0
   addPass(createVEDelaySlotFillerPass());
 #endif
@@ -53,6 +53,7 @@ public:
   }
 
   TargetTransformInfo getTargetTransformInfo(const Function &F) override;
+  void adjustPassManager(PassManagerBuilder &) override;
 };
 
 } // end namespace llvm
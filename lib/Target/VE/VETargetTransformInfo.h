@@ -60,6 +60,16 @@ public:
 
   unsigned getMinVectorRegisterBitWidth() const { return 256*64; }
 
+  /// Parameters for LoopDataPrefetch.  A data prefetch fetches several
+  /// cache lines (see -ve-prefetch-lines), so only streams advancing by at
+  /// least a full vector of doubles per iteration are prefetched.  Each
+  /// vector instruction works on up to 256 elements, so the distance in
+  /// instructions is small.
+  unsigned getCacheLineSize() { return ST->getCacheLineSize(); }
+  unsigned getPrefetchDistance() { return 64; }
+  unsigned getMinPrefetchStride() { return 2048; }
+  unsigned getMaxPrefetchIterationsAhead() { return 16; }
+
   bool isLegalMaskedLoad(Type *DataType) {
     return true;
   }
@@ -78,6 +88,26 @@ public:
       return true;
   };
 
+  /// Vector loads and stores of 32-bit and 64-bit elements have .nc forms
+  /// bypassing the LLC.  They access memory element by element, so only the
+  /// element alignment is needed.
+  bool isLegalNTVectorAccess(Type *DataType, unsigned Alignment) const {
+    if (!DataType->isVectorTy())
+      return true;
+    unsigned EltSize =
+        DataType->getVectorElementType()->getPrimitiveSizeInBits() / 8;
+    if (DataType->getVectorElementType()->isPointerTy())
+      EltSize = 8;
+    return (EltSize == 4 || EltSize == 8) && Alignment >= EltSize;
+  }
+
+  bool isLegalNTStore(Type *DataType, unsigned Alignment) {
+    return isLegalNTVectorAccess(DataType, Alignment);
+  }
+
+  bool isLegalNTLoad(Type *DataType, unsigned Alignment) {
+    return isLegalNTVectorAccess(DataType, Alignment);
+  }
 };
 
 }
@@ -39,9 +39,13 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/EndianStream.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
@@ -72,6 +76,8 @@ STATISTIC(NumImportedFunctions, "Number of functions imported in backend");
 STATISTIC(NumImportedGlobalVars,
           "Number of global variables imported in backend");
 STATISTIC(NumImportedModules, "Number of modules imported from");
+STATISTIC(NumReusedImportLists,
+          "Number of modules reusing the import lists of a previous thin link");
 STATISTIC(NumDeadSymbols, "Number of dead stripped symbols in index");
 STATISTIC(NumLiveSymbols, "Number of live symbols in index");
 
@@ -513,7 +519,8 @@ static void computeImportForFunction(
 
     const auto AdjThreshold = GetAdjustedThreshold(Threshold, IsHotCallsite);
 
-    ImportCount++;
+    if (ImportCutoff >= 0)
+      ImportCount++;
 
     // Insert the newly imported function to the worklist.
     Worklist.emplace_back(ResolvedCalleeSummary, AdjThreshold, VI.getGUID());
@@ -615,20 +622,265 @@ static unsigned numGlobalVarSummaries(const ModuleSummaryIndex &Index,
 }
 #endif
 
+// Hashes the import options and the index flags the import lists depend on.
+static uint64_t hashImportOptions(const ModuleSummaryIndex &Index) {
+  MD5 Hasher;
+  auto AddFloat = [&](float F) {
+    Hasher.update(ArrayRef<uint8_t>((const uint8_t *)&F, sizeof(F)));
+  };
+  uint64_t Flags[] = {ImportInstrLimit, Index.withGlobalValueDeadStripping()};
+  Hasher.update(ArrayRef<uint8_t>((const uint8_t *)Flags, sizeof(Flags)));
+  AddFloat(ImportInstrFactor);
+  AddFloat(ImportHotInstrFactor);
+  AddFloat(ImportHotMultiplier);
+  AddFloat(ImportCriticalMultiplier);
+  AddFloat(ImportColdMultiplier);
+  MD5::MD5Result Result;
+  Hasher.final(Result);
+  return Result.low();
+}
+
+// Hashes the summaries of a module, including the flags the thin link derived
+// from the symbol resolutions and the dead symbol analysis. Returns None for a
+// module without a module hash, whose summaries can't be compared across
+// links.
+static Optional<uint64_t>
+hashModuleSummaries(const ModuleSummaryIndex &Index, StringRef ModulePath,
+                    const GVSummaryMapTy &DefinedGVSummaries) {
+  auto It = Index.modulePaths().find(ModulePath);
+  if (It == Index.modulePaths().end())
+    return None;
+  const ModuleHash &ModHash = It->second.second;
+  if (all_of(ModHash, [](uint32_t V) { return V == 0; }))
+    return None;
+
+  MD5 Hasher;
+  Hasher.update(ArrayRef<uint8_t>((const uint8_t *)&ModHash[0],
+                                  sizeof(ModHash)));
+  for (auto &GVS : DefinedGVSummaries) {
+    const GlobalValueSummary *S = GVS.second;
+    bool ReadOnly = false;
+    if (auto *GVar = dyn_cast<GlobalVarSummary>(S))
+      ReadOnly = GVar->isReadOnly();
+    uint64_t Data[] = {GVS.first, S->linkage(), S->isLive(), S->isDSOLocal(),
+                       S->notEligibleToImport(), ReadOnly};
+    Hasher.update(ArrayRef<uint8_t>((const uint8_t *)Data, sizeof(Data)));
+  }
+  MD5::MD5Result Result;
+  Hasher.final(Result);
+  return Result.low();
+}
+
+// Records in Entry what the import computation for the module read from the
+// Index: the callees and references of the functions defined in the module and
+// of the functions it imports, and the modules defining any of them. Returns
+// false if one of these modules has no hash in ModuleHashes.
+static bool
+recordImportDependencies(const ModuleSummaryIndex &Index, StringRef ModulePath,
+                         const GVSummaryMapTy &DefinedGVSummaries,
+                         const FunctionImporter::ImportMapTy &ImportList,
+                         const StringMap<uint64_t> &ModuleHashes,
+                         ThinLinkImportCache::ModuleEntry &Entry) {
+  auto AddEdges = [&](const GlobalValueSummary *S) {
+    auto *FS = dyn_cast<FunctionSummary>(S->getBaseObject());
+    if (!FS)
+      return;
+    for (auto &Ref : FS->refs())
+      Entry.Consulted.push_back(Ref.getGUID());
+    for (auto &Edge : FS->calls()) {
+      GlobalValue::GUID GUID = Edge.first.getGUID();
+      Entry.Consulted.push_back(GUID);
+      // See updateValueInfoForIndirectCalls.
+      if (!Edge.first.getSummaryList().empty())
+        continue;
+      GlobalValue::GUID Resolved = Index.getGUIDFromOriginalID(GUID);
+      Entry.OriginalIDs.push_back(std::make_pair(GUID, Resolved));
+      if (Resolved)
+        Entry.Consulted.push_back(Resolved);
+    }
+  };
+  for (auto &GVS : DefinedGVSummaries)
+    AddEdges(GVS.second);
+  for (auto &Src : ImportList)
+    for (GlobalValue::GUID GUID : Src.second)
+      if (auto *S = Index.findSummaryInModule(GUID, Src.first()))
+        AddEdges(S);
+
+  llvm::sort(Entry.Consulted);
+  Entry.Consulted.erase(
+      std::unique(Entry.Consulted.begin(), Entry.Consulted.end()),
+      Entry.Consulted.end());
+  llvm::sort(Entry.OriginalIDs);
+  Entry.OriginalIDs.erase(
+      std::unique(Entry.OriginalIDs.begin(), Entry.OriginalIDs.end()),
+      Entry.OriginalIDs.end());
+
+  StringSet<> Dependencies;
+  Dependencies.insert(ModulePath);
+  for (GlobalValue::GUID GUID : Entry.Consulted)
+    if (ValueInfo VI = Index.getValueInfo(GUID))
+      for (auto &S : VI.getSummaryList())
+        Dependencies.insert(S->modulePath());
+  for (auto &Dep : Dependencies) {
+    auto It = ModuleHashes.find(Dep.first());
+    if (It == ModuleHashes.end())
+      return false;
+    Entry.Dependencies.push_back(std::make_pair(Dep.first().str(), It->second));
+  }
+  llvm::sort(Entry.Dependencies);
+  return true;
+}
+
+// Returns true if the lists recorded in Entry are still valid: the modules
+// the import computation read from are unchanged, none of the ChangedGUIDs
+// defined by a changed module was consulted, and the callees without summary
+// are mapped to the same GUIDs.
+static bool isReusable(const ThinLinkImportCache::ModuleEntry &Entry,
+                       const ModuleSummaryIndex &Index,
+                       const StringMap<uint64_t> &ModuleHashes,
+                       ArrayRef<GlobalValue::GUID> ChangedGUIDs) {
+  for (auto &Dep : Entry.Dependencies) {
+    auto It = ModuleHashes.find(Dep.first);
+    if (It == ModuleHashes.end() || It->second != Dep.second)
+      return false;
+  }
+  for (auto &OID : Entry.OriginalIDs)
+    if (Index.getGUIDFromOriginalID(OID.first) != OID.second)
+      return false;
+
+  // Both lists are sorted, look up the elements of the shorter one.
+  ArrayRef<GlobalValue::GUID> Short = ChangedGUIDs;
+  ArrayRef<GlobalValue::GUID> Long = Entry.Consulted;
+  if (Short.size() > Long.size())
+    std::swap(Short, Long);
+  return none_of(Short, [&](GlobalValue::GUID GUID) {
+    return std::binary_search(Long.begin(), Long.end(), GUID);
+  });
+}
+
 /// Compute all the import and export for every module using the Index.
 void llvm::ComputeCrossModuleImport(
     const ModuleSummaryIndex &Index,
     const StringMap<GVSummaryMapTy> &ModuleToDefinedGVSummaries,
     StringMap<FunctionImporter::ImportMapTy> &ImportLists,
-    StringMap<FunctionImporter::ExportSetTy> &ExportLists) {
+    StringMap<FunctionImporter::ExportSetTy> &ExportLists,
+    ThinLinkImportCache *Cache) {
   // For each module that has function defined, compute the import/export lists.
-  for (auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
-    auto &ImportList = ImportLists[DefinedGVSummaries.first()];
-    LLVM_DEBUG(dbgs() << "Computing import for Module '"
-                      << DefinedGVSummaries.first() << "'\n");
-    ComputeImportForModule(DefinedGVSummaries.second, Index,
-                           DefinedGVSummaries.first(), ImportList,
-                           &ExportLists);
+  // The import of a module only depends on the read-only Index, so modules are
+  // processed in parallel, each recording its exports in a private map. The
+  // maps are merged in module order afterwards. Diagnostics are printed per
+  // module, so keep them readable by computing serially when they are enabled.
+  // -import-cutoff counts the imports across all modules and needs a serial
+  // computation as well.
+  struct ModuleImport {
+    const StringMapEntry<GVSummaryMapTy> *DefinedGVSummaries;
+    FunctionImporter::ImportMapTy *ImportList;
+    StringMap<FunctionImporter::ExportSetTy> ExportLists;
+    // The hash of the module's summaries, and the lists to record in the
+    // cache for the next link. Only used with a Cache.
+    Optional<uint64_t> Hash;
+    bool Reused;
+    std::unique_ptr<ThinLinkImportCache::ModuleEntry> NewEntry;
+  };
+  std::vector<ModuleImport> Modules;
+  Modules.reserve(ModuleToDefinedGVSummaries.size());
+  for (auto &DefinedGVSummaries : ModuleToDefinedGVSummaries)
+    Modules.push_back({&DefinedGVSummaries,
+                       &ImportLists[DefinedGVSummaries.first()],
+                       StringMap<FunctionImporter::ExportSetTy>(), None, false,
+                       nullptr});
+
+  // With -import-cutoff the lists of a module depend on the modules computed
+  // before it, so they can't be reused.
+  bool UseCache = Cache && ImportCutoff < 0;
+  StringMap<uint64_t> ModuleHashes;
+  std::vector<GlobalValue::GUID> ChangedGUIDs;
+  if (UseCache) {
+    uint64_t OptionsHash = hashImportOptions(Index);
+    if (Cache->OptionsHash != OptionsHash) {
+      Cache->OptionsHash = OptionsHash;
+      Cache->ModuleHashes.clear();
+      Cache->Modules.clear();
+    }
+    parallel::for_each_n(
+        parallel::par, size_t(0), Modules.size(), [&](size_t I) {
+          ModuleImport &MI = Modules[I];
+          MI.Hash = hashModuleSummaries(Index, MI.DefinedGVSummaries->first(),
+                                        MI.DefinedGVSummaries->second);
+        });
+    // A module without a hash is considered changed in every link.
+    for (ModuleImport &MI : Modules) {
+      StringRef ModulePath = MI.DefinedGVSummaries->first();
+      if (MI.Hash)
+        ModuleHashes[ModulePath] = *MI.Hash;
+      auto It = Cache->ModuleHashes.find(ModulePath);
+      if (!MI.Hash || It == Cache->ModuleHashes.end() || It->second != *MI.Hash)
+        for (auto &GVS : MI.DefinedGVSummaries->second)
+          ChangedGUIDs.push_back(GVS.first);
+    }
+    llvm::sort(ChangedGUIDs);
+    ChangedGUIDs.erase(std::unique(ChangedGUIDs.begin(), ChangedGUIDs.end()),
+                       ChangedGUIDs.end());
+  }
+
+  auto ComputeModule = [&](size_t I) {
+    ModuleImport &MI = Modules[I];
+    StringRef ModulePath = MI.DefinedGVSummaries->first();
+    if (UseCache) {
+      auto It = Cache->Modules.find(ModulePath);
+      if (It != Cache->Modules.end() &&
+          isReusable(It->second, Index, ModuleHashes, ChangedGUIDs)) {
+        LLVM_DEBUG(dbgs() << "Reusing import for Module '" << ModulePath
+                          << "'\n");
+        *MI.ImportList = It->second.ImportList;
+        MI.ExportLists = It->second.ExportLists;
+        MI.Reused = true;
+        return;
+      }
+    }
+
+    LLVM_DEBUG(dbgs() << "Computing import for Module '" << ModulePath
+                      << "'\n");
+    ComputeImportForModule(MI.DefinedGVSummaries->second, Index, ModulePath,
+                           *MI.ImportList, &MI.ExportLists);
+
+    if (UseCache && MI.Hash) {
+      auto Entry = llvm::make_unique<ThinLinkImportCache::ModuleEntry>();
+      if (recordImportDependencies(Index, ModulePath,
+                                   MI.DefinedGVSummaries->second,
+                                   *MI.ImportList, ModuleHashes, *Entry)) {
+        Entry->ImportList = *MI.ImportList;
+        Entry->ExportLists = MI.ExportLists;
+        MI.NewEntry = std::move(Entry);
+      }
+    }
+  };
+  bool Serial = PrintImportFailures || ImportCutoff >= 0;
+  LLVM_DEBUG(Serial = true);
+  if (Serial)
+    for (size_t I = 0, E = Modules.size(); I != E; ++I)
+      ComputeModule(I);
+  else
+    parallel::for_each_n(parallel::par, size_t(0), Modules.size(),
+                         ComputeModule);
+
+  for (ModuleImport &MI : Modules)
+    for (auto &ELI : MI.ExportLists)
+      ExportLists[ELI.first()].insert(ELI.second.begin(), ELI.second.end());
+
+  if (UseCache) {
+    StringMap<ThinLinkImportCache::ModuleEntry> Entries;
+    for (ModuleImport &MI : Modules) {
+      StringRef ModulePath = MI.DefinedGVSummaries->first();
+      if (MI.Reused) {
+        ++NumReusedImportLists;
+        Entries[ModulePath] = std::move(Cache->Modules[ModulePath]);
+      } else if (MI.NewEntry) {
+        Entries[ModulePath] = std::move(*MI.NewEntry);
+      }
+    }
+    Cache->Modules = std::move(Entries);
+    Cache->ModuleHashes = std::move(ModuleHashes);
   }
 
   // When computing imports we added all GUIDs referenced by anything
@@ -670,6 +922,176 @@ void llvm::ComputeCrossModuleImport(
 #endif
 }
 
+static const char ThinLinkImportCacheMagic[] = {'T', 'L', 'I', 'C'};
+static const uint32_t ThinLinkImportCacheVersion = 1;
+
+namespace {
+
+/// Reads the little-endian fields written by ThinLinkImportCache::save. Once a
+/// read runs past the end of the data, all further reads fail.
+class ThinLinkImportCacheReader {
+  StringRef Data;
+  bool Failed = false;
+
+public:
+  ThinLinkImportCacheReader(StringRef Data) : Data(Data) {}
+
+  bool failed() const { return Failed; }
+
+  StringRef readBytes(size_t Size) {
+    if (Failed || Data.size() < Size) {
+      Failed = true;
+      return StringRef();
+    }
+    StringRef Bytes = Data.take_front(Size);
+    Data = Data.drop_front(Size);
+    return Bytes;
+  }
+
+  uint32_t read32() {
+    StringRef Bytes = readBytes(4);
+    return Failed ? 0 : support::endian::read32le(Bytes.data());
+  }
+
+  uint64_t read64() {
+    StringRef Bytes = readBytes(8);
+    return Failed ? 0 : support::endian::read64le(Bytes.data());
+  }
+
+  StringRef readString() { return readBytes(read32()); }
+
+  template <typename SetTy> void readGUIDs(SetTy &GUIDs) {
+    for (uint32_t I = 0, N = read32(); I != N && !Failed; ++I)
+      GUIDs.insert(GUIDs.end(), read64());
+  }
+
+  template <typename MapTy> void readGUIDMap(MapTy &Map) {
+    for (uint32_t I = 0, N = read32(); I != N && !Failed; ++I)
+      readGUIDs(Map[readString()]);
+  }
+};
+
+} // end anonymous namespace
+
+template <typename T>
+static std::vector<StringRef> getSortedKeys(const StringMap<T> &Map) {
+  std::vector<StringRef> Keys;
+  Keys.reserve(Map.size());
+  for (auto &E : Map)
+    Keys.push_back(E.first());
+  llvm::sort(Keys);
+  return Keys;
+}
+
+ThinLinkImportCache ThinLinkImportCache::load(StringRef Path) {
+  ThinLinkImportCache Cache;
+  ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr = MemoryBuffer::getFile(Path);
+  if (!MBOrErr)
+    return Cache;
+
+  ThinLinkImportCacheReader R((*MBOrErr)->getBuffer());
+  if (R.readBytes(sizeof(ThinLinkImportCacheMagic)) !=
+          StringRef(ThinLinkImportCacheMagic,
+                    sizeof(ThinLinkImportCacheMagic)) ||
+      R.read32() != ThinLinkImportCacheVersion)
+    return Cache;
+  Cache.OptionsHash = R.read64();
+  for (uint32_t I = 0, N = R.read32(); I != N && !R.failed(); ++I) {
+    StringRef ModulePath = R.readString();
+    Cache.ModuleHashes[ModulePath] = R.read64();
+  }
+  for (uint32_t I = 0, N = R.read32(); I != N && !R.failed(); ++I) {
+    ModuleEntry &Entry = Cache.Modules[R.readString()];
+    for (uint32_t J = 0, M = R.read32(); J != M && !R.failed(); ++J) {
+      std::string Dep = R.readString();
+      Entry.Dependencies.push_back(std::make_pair(Dep, R.read64()));
+    }
+    R.readGUIDs(Entry.Consulted);
+    for (uint32_t J = 0, M = R.read32(); J != M && !R.failed(); ++J) {
+      GlobalValue::GUID OriginalID = R.read64();
+      Entry.OriginalIDs.push_back(std::make_pair(OriginalID, R.read64()));
+    }
+    R.readGUIDMap(Entry.ImportList);
+    R.readGUIDMap(Entry.ExportLists);
+  }
+
+  if (R.failed())
+    return ThinLinkImportCache();
+  return Cache;
+}
+
+Error ThinLinkImportCache::save(StringRef Path) const {
+  SmallString<0> Buffer;
+  raw_svector_ostream OS(Buffer);
+  support::endian::Writer W(OS, support::little);
+  auto WriteString = [&](StringRef S) {
+    W.write<uint32_t>(S.size());
+    OS << S;
+  };
+  // The sets are unordered, write them sorted to get a stable file.
+  auto WriteGUIDs = [&](const std::unordered_set<GlobalValue::GUID> &Set) {
+    std::vector<GlobalValue::GUID> GUIDs(Set.begin(), Set.end());
+    llvm::sort(GUIDs);
+    W.write<uint32_t>(GUIDs.size());
+    for (GlobalValue::GUID GUID : GUIDs)
+      W.write<uint64_t>(GUID);
+  };
+  auto WriteGUIDMap =
+      [&](const StringMap<std::unordered_set<GlobalValue::GUID>> &Map) {
+    std::vector<StringRef> Keys = getSortedKeys(Map);
+    W.write<uint32_t>(Keys.size());
+    for (StringRef Key : Keys) {
+      WriteString(Key);
+      WriteGUIDs(Map.find(Key)->second);
+    }
+  };
+
+  OS.write(ThinLinkImportCacheMagic, sizeof(ThinLinkImportCacheMagic));
+  W.write<uint32_t>(ThinLinkImportCacheVersion);
+  W.write<uint64_t>(OptionsHash);
+
+  std::vector<StringRef> Keys = getSortedKeys(ModuleHashes);
+  W.write<uint32_t>(Keys.size());
+  for (StringRef Key : Keys) {
+    WriteString(Key);
+    W.write<uint64_t>(ModuleHashes.lookup(Key));
+  }
+
+  Keys = getSortedKeys(Modules);
+  W.write<uint32_t>(Keys.size());
+  for (StringRef Key : Keys) {
+    const ModuleEntry &Entry = Modules.find(Key)->second;
+    WriteString(Key);
+    W.write<uint32_t>(Entry.Dependencies.size());
+    for (auto &Dep : Entry.Dependencies) {
+      WriteString(Dep.first);
+      W.write<uint64_t>(Dep.second);
+    }
+    W.write<uint32_t>(Entry.Consulted.size());
+    for (GlobalValue::GUID GUID : Entry.Consulted)
+      W.write<uint64_t>(GUID);
+    W.write<uint32_t>(Entry.OriginalIDs.size());
+    for (auto &OID : Entry.OriginalIDs) {
+      W.write<uint64_t>(OID.first);
+      W.write<uint64_t>(OID.second);
+    }
+    WriteGUIDMap(Entry.ImportList);
+    WriteGUIDMap(Entry.ExportLists);
+  }
+
+  // Write to a temporary file and rename it, so that a concurrent link never
+  // reads a partially written cache.
+  Expected<sys::fs::TempFile> Temp =
+      sys::fs::TempFile::create(Path + ".%%%%%%.tmp");
+  if (!Temp)
+    return Temp.takeError();
+  {
+    raw_fd_ostream TempOS(Temp->FD, /*shouldClose=*/false);
+    TempOS << Buffer;
+  }
+  return Temp->keep(Path);
+}
+
 #ifndef NDEBUG
 static void dumpImportListForModule(const ModuleSummaryIndex &Index,
                                     StringRef ModulePath,
@@ -842,7 +842,10 @@ void PassManagerBuilder::addLTOOptimizationPasses(legacy::PassManagerBase &PM) {
   // If we didn't decide to inline a function, check to see if we can
   // transform it to pass arguments by value instead of by reference.
   PM.add(createArgumentPromotionPass());
+}
 
+void PassManagerBuilder::addLTOFunctionOptimizationPasses(
+    legacy::PassManagerBase &PM) {
   // The IPO passes may leave cruft around.  Clean up after them.
   addInstructionCombiningPass(PM);
   addExtensionsToPM(EP_Peephole, PM);
@@ -952,16 +955,19 @@ void PassManagerBuilder::populateThinLTOPassManager(
   PerformThinLTO = false;
 }
 
-void PassManagerBuilder::populateLTOPassManager(legacy::PassManagerBase &PM) {
+void PassManagerBuilder::addLTOPasses(legacy::PassManagerBase &PM,
+                                      bool RunFunctionPasses) {
   if (LibraryInfo)
     PM.add(new TargetLibraryInfoWrapperPass(*LibraryInfo));
 
   if (VerifyInput)
     PM.add(createVerifierPass());
 
-  if (OptLevel != 0)
+  if (OptLevel != 0) {
     addLTOOptimizationPasses(PM);
-  else {
+    if (OptLevel > 1 && RunFunctionPasses)
+      addLTOFunctionOptimizationPasses(PM);
+  } else {
     // The whole-program-devirt pass needs to run at -O0 because only it knows
     // about the llvm.type.checked.load intrinsic: it needs to both lower the
     // intrinsic itself and handle it in the summary.
@@ -984,6 +990,34 @@ void PassManagerBuilder::populateLTOPassManager(legacy::PassManagerBase &PM) {
     PM.add(createVerifierPass());
 }
 
+void PassManagerBuilder::populateLTOPassManager(legacy::PassManagerBase &PM) {
+  addLTOPasses(PM, /*RunFunctionPasses=*/true);
+}
+
+void PassManagerBuilder::populateLTOModulePassManager(
+    legacy::PassManagerBase &PM) {
+  addLTOPasses(PM, /*RunFunctionPasses=*/false);
+}
+
+void PassManagerBuilder::populateLTOPartitionPassManager(
+    legacy::PassManagerBase &PM) {
+  if (LibraryInfo)
+    PM.add(new TargetLibraryInfoWrapperPass(*LibraryInfo));
+
+  if (OptLevel > 1) {
+    addInitialAliasAnalysisPasses(PM);
+    addLTOFunctionOptimizationPasses(PM);
+  }
+
+  // The partition still holds the bodies of available externally functions
+  // and functions which became dead after inlining within the partition.
+  if (OptLevel != 0)
+    addLateLTOOptimizationPasses(PM);
+
+  if (VerifyOutput)
+    PM.add(createVerifierPass());
+}
+
 inline PassManagerBuilder *unwrap(LLVMPassManagerBuilderRef P) {
     return reinterpret_cast<PassManagerBuilder*>(P);
 }
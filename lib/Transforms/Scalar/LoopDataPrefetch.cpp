@@ -27,7 +27,9 @@
 #include "llvm/IR/CFG.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Module.h"
+#include "llvm/IR/PatternMatch.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Transforms/Scalar.h"
@@ -138,6 +140,47 @@ FunctionPass *llvm::createLoopDataPrefetchPass() {
   return new LoopDataPrefetchLegacyPass();
 }
 
+/// Return the address of the first lane of the vector of pointers \p Ptrs if
+/// it is a recurrence in \p L.  This handles the "gep %base, %vec.ind"
+/// pattern the loop vectorizer emits for strided gathers and scatters, where
+/// %vec.ind is a vector induction.
+static const SCEVAddRecExpr *getFirstLaneAddRec(Value *Ptrs, Loop *L,
+                                                ScalarEvolution *SE) {
+  using namespace PatternMatch;
+
+  auto *GEP = dyn_cast<GetElementPtrInst>(Ptrs);
+  if (!GEP || GEP->getNumIndices() != 1 ||
+      GEP->getPointerOperandType()->isVectorTy())
+    return nullptr;
+  auto *Phi = dyn_cast<PHINode>(GEP->getOperand(1));
+  BasicBlock *Preheader = L->getLoopPreheader();
+  BasicBlock *Latch = L->getLoopLatch();
+  if (!Phi || Phi->getParent() != L->getHeader() || !Preheader || !Latch)
+    return nullptr;
+
+  auto *Start = dyn_cast<Constant>(Phi->getIncomingValueForBlock(Preheader));
+  Constant *Step;
+  if (!Start || !match(Phi->getIncomingValueForBlock(Latch),
+                       m_Add(m_Specific(Phi), m_Constant(Step))))
+    return nullptr;
+  auto *Start0 = dyn_cast_or_null<ConstantInt>(Start->getAggregateElement(0u));
+  auto *StepC = dyn_cast_or_null<ConstantInt>(Step->getSplatValue());
+  if (!Start0 || !StepC)
+    return nullptr;
+
+  const DataLayout &DL = GEP->getModule()->getDataLayout();
+  Type *IntPtrTy = DL.getIntPtrType(GEP->getPointerOperandType());
+  const SCEV *Idx = SE->getAddRecExpr(SE->getConstant(Start0),
+                                      SE->getConstant(StepC), L,
+                                      SCEV::FlagAnyWrap);
+  Idx = SE->getTruncateOrSignExtend(Idx, IntPtrTy);
+  const SCEV *Offset = SE->getMulExpr(
+      Idx, SE->getConstant(IntPtrTy,
+                           DL.getTypeAllocSize(GEP->getSourceElementType())));
+  return dyn_cast<SCEVAddRecExpr>(
+      SE->getAddExpr(SE->getSCEV(GEP->getPointerOperand()), Offset));
+}
+
 bool LoopDataPrefetch::isStrideLargeEnough(const SCEVAddRecExpr *AR) {
   unsigned TargetMinStride = getMinPrefetchStride();
   // No need to check if any stride goes.
@@ -261,6 +304,18 @@ bool LoopDataPrefetch::runOnLoop(Loop *L) {
         if (!PrefetchWrites) continue;
         MemI = SMemI;
         PtrValue = SMemI->getPointerOperand();
+      } else if (IntrinsicInst *II = dyn_cast<IntrinsicInst>(&I)) {
+        // Strided gathers and scatters access a window starting at the
+        // address of their first lane, so prefetch the stream of that
+        // address.
+        if (II->getIntrinsicID() == Intrinsic::masked_gather)
+          PtrValue = II->getArgOperand(0);
+        else if (II->getIntrinsicID() == Intrinsic::masked_scatter &&
+                 PrefetchWrites)
+          PtrValue = II->getArgOperand(1);
+        else
+          continue;
+        MemI = II;
       } else continue;
 
       unsigned PtrAddrSpace = PtrValue->getType()->getPointerAddressSpace();
@@ -270,8 +325,15 @@ bool LoopDataPrefetch::runOnLoop(Loop *L) {
       if (L->isLoopInvariant(PtrValue))
         continue;
 
-      const SCEV *LSCEV = SE->getSCEV(PtrValue);
-      const SCEVAddRecExpr *LSCEVAddRec = dyn_cast<SCEVAddRecExpr>(LSCEV);
+      const SCEV *LSCEV;
+      const SCEVAddRecExpr *LSCEVAddRec;
+      if (PtrValue->getType()->isVectorTy()) {
+        LSCEVAddRec = getFirstLaneAddRec(PtrValue, L, SE);
+        LSCEV = LSCEVAddRec;
+      } else {
+        LSCEV = SE->getSCEV(PtrValue);
+        LSCEVAddRec = dyn_cast<SCEVAddRecExpr>(LSCEV);
+      }
       if (!LSCEVAddRec)
         continue;
 
@@ -314,10 +376,16 @@ bool LoopDataPrefetch::runOnLoop(Loop *L) {
       Module *M = BB->getParent()->getParent();
       Type *I32 = Type::getInt32Ty(BB->getContext());
       Value *PrefetchFunc = Intrinsic::getDeclaration(M, Intrinsic::prefetch);
+      // A masked scatter only writes, although as an intrinsic call it may
+      // read memory as well.
+      bool IsWrite = isa<IntrinsicInst>(MemI)
+                         ? cast<IntrinsicInst>(MemI)->getIntrinsicID() ==
+                               Intrinsic::masked_scatter
+                         : !MemI->mayReadFromMemory();
       Builder.CreateCall(
           PrefetchFunc,
           {PrefPtrValue,
-           ConstantInt::get(I32, MemI->mayReadFromMemory() ? 0 : 1),
+           ConstantInt::get(I32, IsWrite ? 1 : 0),
            ConstantInt::get(I32, 3), ConstantInt::get(I32, 1)});
       ++NumPrefetches;
       LLVM_DEBUG(dbgs() << "  Access: " << *PtrValue << ", SCEV: " << *LSCEV
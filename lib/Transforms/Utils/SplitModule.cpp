@@ -43,6 +43,7 @@
 #include <cassert>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -92,12 +93,140 @@ static void addAllGlobalValueUsers(ClusterMapType &GVtoClusterMap,
   }
 }
 
+// Returns an estimate of the cost of generating code for GV.
+static uint64_t getCodeGenCost(const GlobalValue *GV) {
+  if (const Function *F = dyn_cast<Function>(GV))
+    return F->getInstructionCount() + 1;
+  return 1;
+}
+
+// Calls Fn for each global value which the definition of GV refers to,
+// looking through constant expressions and aggregates.
+static void
+forEachReferencedGlobal(const GlobalValue *GV,
+                        function_ref<void(const GlobalValue *)> Fn) {
+  SmallVector<const User *, 16> Worklist;
+  SmallPtrSet<const Constant *, 16> Visited;
+  Worklist.push_back(GV);
+  if (const Function *F = dyn_cast<Function>(GV))
+    for (const BasicBlock &BB : *F)
+      for (const Instruction &I : BB)
+        Worklist.push_back(&I);
+
+  while (!Worklist.empty()) {
+    const User *U = Worklist.pop_back_val();
+    for (const Value *Op : U->operands()) {
+      if (const GlobalValue *Ref = dyn_cast<GlobalValue>(Op))
+        Fn(Ref);
+      else if (const Constant *C = dyn_cast<Constant>(Op))
+        if (Visited.insert(C).second)
+          Worklist.push_back(C);
+    }
+  }
+}
+
+// Assigns the clusters in GVtoClusterMap to N partitions, such that the cost
+// of generating code for each partition is about the same and as few
+// references as possible cross partitions.
+//
+// The clusters are placed greedily, largest first: each goes to the partition
+// which it has the most references with, among those which stay within their
+// share of the total cost, and to the least loaded partition if it fits none.
+static void balancePartitions(ClusterMapType &GVtoClusterMap,
+                              ClusterIDMapType &ClusterIDMap, unsigned N) {
+  struct Cluster {
+    ClusterMapType::iterator Leader;
+    uint64_t Cost = 0;
+    // The number of references between this and each other cluster.
+    DenseMap<unsigned, unsigned> Refs;
+  };
+  std::vector<Cluster> Clusters;
+  DenseMap<const GlobalValue *, unsigned> ClusterOf;
+  uint64_t TotalCost = 0;
+
+  for (ClusterMapType::iterator I = GVtoClusterMap.begin(),
+                                E = GVtoClusterMap.end(); I != E; ++I) {
+    if (!I->isLeader())
+      continue;
+    unsigned ID = Clusters.size();
+    Clusters.emplace_back();
+    Clusters[ID].Leader = I;
+    for (ClusterMapType::member_iterator MI = GVtoClusterMap.member_begin(I);
+         MI != GVtoClusterMap.member_end(); ++MI) {
+      ClusterOf[*MI] = ID;
+      Clusters[ID].Cost += getCodeGenCost(*MI);
+    }
+    TotalCost += Clusters[ID].Cost;
+  }
+
+  for (const auto &Entry : ClusterOf) {
+    unsigned From = Entry.second;
+    forEachReferencedGlobal(Entry.first, [&](const GlobalValue *Ref) {
+      auto It = ClusterOf.find(Ref);
+      if (It == ClusterOf.end() || It->second == From)
+        return;
+      ++Clusters[From].Refs[It->second];
+      ++Clusters[It->second].Refs[From];
+    });
+  }
+
+  // To guarantee determinism, visit the clusters by decreasing cost, and by
+  // the leader's name if the cost is the same.
+  std::vector<unsigned> Order(Clusters.size());
+  std::iota(Order.begin(), Order.end(), 0);
+  llvm::sort(Order, [&](unsigned A, unsigned B) {
+    if (Clusters[A].Cost != Clusters[B].Cost)
+      return Clusters[A].Cost > Clusters[B].Cost;
+    return Clusters[A].Leader->getData()->getName() <
+           Clusters[B].Leader->getData()->getName();
+  });
+
+  // Allow a partition to exceed its even share of the cost by 1/16 if that
+  // keeps references within the partition.
+  uint64_t Capacity = (TotalCost + N - 1) / N;
+  Capacity += Capacity / 16;
+
+  const unsigned Unassigned = ~0u;
+  std::vector<unsigned> PartitionOf(Clusters.size(), Unassigned);
+  std::vector<uint64_t> Load(N), Affinity(N);
+  for (unsigned ID : Order) {
+    const Cluster &C = Clusters[ID];
+    std::fill(Affinity.begin(), Affinity.end(), 0);
+    for (const auto &Ref : C.Refs)
+      if (PartitionOf[Ref.first] != Unassigned)
+        Affinity[PartitionOf[Ref.first]] += Ref.second;
+
+    unsigned Best = 0;
+    for (unsigned P = 1; P < N; ++P)
+      if (Load[P] < Load[Best])
+        Best = P;
+    for (unsigned P = 0; P < N; ++P) {
+      if (Load[P] + C.Cost > Capacity)
+        continue;
+      if (Affinity[P] > Affinity[Best] ||
+          (Affinity[P] == Affinity[Best] && Load[P] < Load[Best]))
+        Best = P;
+    }
+
+    LLVM_DEBUG(dbgs() << "Root[" << Best << "] cost(" << C.Cost
+                      << ") affinity(" << Affinity[Best] << ") ----> "
+                      << C.Leader->getData()->getName() << "\n");
+    PartitionOf[ID] = Best;
+    Load[Best] += C.Cost;
+    for (ClusterMapType::member_iterator MI =
+             GVtoClusterMap.member_begin(C.Leader);
+         MI != GVtoClusterMap.member_end(); ++MI)
+      ClusterIDMap[*MI] = Best;
+  }
+}
+
 // Find partitions for module in the way that no locals need to be
 // globalized.
 // Try to balance pack those partitions into N files since this roughly equals
 // thread balancing for the backend codegen step.
+// If BalanceBySize is set, every definition is assigned to a partition here.
 static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
-                           unsigned N) {
+                           unsigned N, bool BalanceBySize) {
   // At this point module should have the proper mix of globals and locals.
   // As we attempt to partition this module, we must not change any
   // locals to globals.
@@ -149,6 +278,15 @@ static void findPartitions(Module *M, ClusterIDMapType &ClusterIDMap,
   llvm::for_each(M->globals(), recordGVSet);
   llvm::for_each(M->aliases(), recordGVSet);
 
+  if (BalanceBySize) {
+    llvm::for_each(M->ifuncs(), recordGVSet);
+    for (const GlobalValue &GV : M->global_values())
+      if (!GV.isDeclaration())
+        GVtoClusterMap.insert(&GV);
+    balancePartitions(GVtoClusterMap, ClusterIDMap, N);
+    return;
+  }
+
   // Assigned all GVs to merged clusters while balancing number of objects in
   // each.
   auto CompareClusters = [](const std::pair<unsigned, unsigned> &a,
@@ -250,7 +388,7 @@ static bool isInPartition(const GlobalValue *GV, unsigned I, unsigned N) {
 void llvm::SplitModule(
     std::unique_ptr<Module> M, unsigned N,
     function_ref<void(std::unique_ptr<Module> MPart)> ModuleCallback,
-    bool PreserveLocals) {
+    bool PreserveLocals, bool BalanceBySize) {
   if (!PreserveLocals) {
     for (Function &F : *M)
       externalize(&F);
@@ -265,7 +403,7 @@ void llvm::SplitModule(
   // This performs splitting without a need for externalization, which might not
   // always be possible.
   ClusterIDMapType ClusterIDMap;
-  findPartitions(M.get(), ClusterIDMap, N);
+  findPartitions(M.get(), ClusterIDMap, N, BalanceBySize);
 
   // FIXME: We should be able to reuse M as the last partition instead of
   // cloning it.
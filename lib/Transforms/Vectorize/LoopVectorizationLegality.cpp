@@ -15,6 +15,7 @@
 // is a need (but D45420 needs to happen first).
 //
 #include "llvm/Transforms/Vectorize/LoopVectorizationLegality.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/Analysis/VectorUtils.h"
 #include "llvm/IR/IntrinsicInst.h"
 
@@ -609,6 +610,19 @@ bool LoopVectorizationLegality::setupOuterLoopInductions() {
     return false;
 }
 
+/// Return true if the target supports a vector version of the nontemporal
+/// load or store \p I of \p ScalarTy.
+static bool isLegalNTAccess(const TargetTransformInfo *TTI, Instruction *I,
+                            Type *ScalarTy, bool IsStore) {
+  // Arbitrarily try a vector of 2 elements.
+  Type *VecTy = VectorType::get(ScalarTy, /*NumElements=*/2);
+  unsigned Alignment = getLoadStoreAlignment(I);
+  if (!Alignment)
+    Alignment = I->getModule()->getDataLayout().getABITypeAlignment(ScalarTy);
+  return IsStore ? TTI->isLegalNTStore(VecTy, Alignment)
+                 : TTI->isLegalNTLoad(VecTy, Alignment);
+}
+
 bool LoopVectorizationLegality::canVectorizeInstrs() {
   BasicBlock *Header = TheLoop->getHeader();
 
@@ -754,6 +768,23 @@ bool LoopVectorizationLegality::canVectorizeInstrs() {
           return false;
         }
 
+        // For nontemporal stores, check that a nontemporal vector version is
+        // supported on the target, or the hint would be lost.
+        if (ST->getMetadata(LLVMContext::MD_nontemporal) &&
+            !isLegalNTAccess(TTI, ST, T, /*IsStore=*/true)) {
+          ORE->emit(createMissedAnalysis("CantVectorizeNontemporalStore", ST)
+                    << "nontemporal store instruction cannot be vectorized");
+          return false;
+        }
+      } else if (auto *LD = dyn_cast<LoadInst>(&I)) {
+        // Likewise for nontemporal loads.
+        if (LD->getMetadata(LLVMContext::MD_nontemporal) &&
+            !isLegalNTAccess(TTI, LD, LD->getType(), /*IsStore=*/false)) {
+          ORE->emit(createMissedAnalysis("CantVectorizeNontemporalLoad", LD)
+                    << "nontemporal load instruction cannot be vectorized");
+          return false;
+        }
+
         // FP instructions can allow unsafe algebra, thus vectorizable by
         // non-IEEE-754 compliant SIMD units.
         // This applies to floating-point math operations and calls, not memory
@@ -0,0 +1,67 @@
+; RUN: llc -mtriple=ve-unknown-unknown -global-isel -stop-after=irtranslator \
+; RUN:   -verify-machineinstrs < %s | FileCheck %s
+
+define i64 @args_i64(i64 %a, i64 %b) {
+; CHECK-LABEL: name: args_i64
+; CHECK:      liveins: $sx0, $sx1
+; CHECK:      [[A:%[0-9]+]]:_(s64) = COPY $sx0
+; CHECK-NEXT: [[B:%[0-9]+]]:_(s64) = COPY $sx1
+; CHECK-NEXT: [[R:%[0-9]+]]:_(s64) = G_ADD [[A]], [[B]]
+; CHECK-NEXT: $sx0 = COPY [[R]](s64)
+; CHECK-NEXT: RET implicit $sx10, implicit $sx0
+  %r = add i64 %a, %b
+  ret i64 %r
+}
+
+define i32 @args_i32(i32 %a, i32 %b) {
+; CHECK-LABEL: name: args_i32
+; CHECK:      liveins: $sw0, $sw1
+; CHECK:      [[A:%[0-9]+]]:_(s32) = COPY $sw0
+; CHECK-NEXT: [[B:%[0-9]+]]:_(s32) = COPY $sw1
+; CHECK-NEXT: [[R:%[0-9]+]]:_(s32) = G_SUB [[A]], [[B]]
+; CHECK-NEXT: $sw0 = COPY [[R]](s32)
+; CHECK-NEXT: RET implicit $sx10, implicit $sw0
+  %r = sub i32 %a, %b
+  ret i32 %r
+}
+
+define double @args_fp(double %a, fp128 %b) {
+; CHECK-LABEL: name: args_fp
+; CHECK:      [[A:%[0-9]+]]:_(s64) = COPY $sx0
+; CHECK-NEXT: [[B:%[0-9]+]]:_(s128) = COPY $q1
+; CHECK:      $sx0 = COPY [[A]](s64)
+; CHECK-NEXT: RET implicit $sx10, implicit $sx0
+  ret double %a
+}
+
+define i64* @args_ptr(i64* %p) {
+; CHECK-LABEL: name: args_ptr
+; CHECK:      [[P:%[0-9]+]]:_(p0) = COPY $sx0
+; CHECK-NEXT: $sx0 = COPY [[P]](p0)
+; CHECK-NEXT: RET implicit $sx10, implicit $sx0
+  ret i64* %p
+}
+
+define i8 @args_i8(i8 %a) {
+; CHECK-LABEL: name: args_i8
+; CHECK:      [[COPY:%[0-9]+]]:_(s32) = COPY $sw0
+; CHECK-NEXT: [[A:%[0-9]+]]:_(s8) = G_TRUNC [[COPY]](s32)
+; CHECK-NEXT: [[EXT:%[0-9]+]]:_(s32) = G_ANYEXT [[A]](s8)
+; CHECK-NEXT: $sw0 = COPY [[EXT]](s32)
+; CHECK-NEXT: RET implicit $sx10, implicit $sw0
+  ret i8 %a
+}
+
+; The ninth argument is passed on the stack after the 64 byte register
+; save area of the argument area at 176(%fp).
+define i64 @args_stack(i64 %a0, i64 %a1, i64 %a2, i64 %a3, i64 %a4, i64 %a5,
+                       i64 %a6, i64 %a7, i64 %a8) {
+; CHECK-LABEL: name: args_stack
+; CHECK:      fixedStack:
+; CHECK:      id: [[SLOT:[0-9]+]], type: default, offset: 240, size: 8
+; CHECK:      [[FI:%[0-9]+]]:_(p0) = G_FRAME_INDEX %fixed-stack.[[SLOT]]
+; CHECK-NEXT: [[A8:%[0-9]+]]:_(s64) = G_LOAD [[FI]](p0) :: (invariant load 8 from %fixed-stack.[[SLOT]]
+; CHECK-NEXT: $sx0 = COPY [[A8]](s64)
+; CHECK-NEXT: RET implicit $sx10, implicit $sx0
+  ret i64 %a8
+}
@@ -0,0 +1,73 @@
+; RUN: llc -mtriple=ve-unknown-unknown -global-isel -global-isel-abort=2 \
+; RUN:   -verify-machineinstrs < %s | FileCheck %s
+; RUN: llc -mtriple=ve-unknown-unknown -global-isel -global-isel-abort=2 \
+; RUN:   < %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=FALLBACK
+
+define i64 @add_i64(i64 %a, i64 %b) {
+; CHECK-LABEL: add_i64:
+; CHECK:       adds.l %s0, %s0, %s1
+  %r = add i64 %a, %b
+  ret i64 %r
+}
+
+define i32 @mul_i32(i32 %a, i32 %b) {
+; CHECK-LABEL: mul_i32:
+; CHECK:       muls.w.sx %s0, %s0, %s1
+  %r = mul i32 %a, %b
+  ret i32 %r
+}
+
+define i64 @const_small() {
+; CHECK-LABEL: const_small:
+; CHECK:       or %s0, 12, (0)1
+  ret i64 12
+}
+
+define i64 @const_medium() {
+; CHECK-LABEL: const_medium:
+; CHECK:       lea %s0, 123456
+  ret i64 123456
+}
+
+define i64 @const_large() {
+; CHECK-LABEL: const_large:
+; CHECK:       lea [[R:%s[0-9]+]], 1
+; CHECK-NEXT:  and [[R]], [[R]], (32)0
+; CHECK-NEXT:  lea.sl %s0, 1([[R]])
+  ret i64 4294967297
+}
+
+define i64 @load_gep(i64* %p) {
+; CHECK-LABEL: load_gep:
+; CHECK:       ld %s0, 16(,%s0)
+  %q = getelementptr i64, i64* %p, i64 2
+  %v = load i64, i64* %q
+  ret i64 %v
+}
+
+define void @store_i32(i32* %p, i32 %v) {
+; CHECK-LABEL: store_i32:
+; CHECK:       stl %s1, (,%s0)
+  store i32 %v, i32* %p
+  ret void
+}
+
+define i64 @branch(i64 %a, i64 %b) {
+; CHECK-LABEL: branch:
+; CHECK:       brlt.l %s0, %s1, .LBB{{[0-9]+}}_{{[0-9]+}}
+entry:
+  %c = icmp slt i64 %a, %b
+  br i1 %c, label %then, label %else
+then:
+  ret i64 %a
+else:
+  ret i64 %b
+}
+
+; Calls are not lowered by GlobalISel yet and fall back to SelectionDAG.
+; FALLBACK: warning: Instruction selection used fallback path for call
+define void @call() {
+  call void @callee()
+  ret void
+}
+declare void @callee()
@@ -0,0 +1,63 @@
+; RUN: llc -mtriple=ve-unknown-unknown -global-isel -global-isel-abort=2 \
+; RUN:   -verify-machineinstrs < %s | FileCheck %s
+; RUN: llc -mtriple=ve-unknown-unknown -global-isel -global-isel-abort=2 \
+; RUN:   < %s -o /dev/null 2>&1 | FileCheck %s --check-prefix=FALLBACK
+
+; f32 lives in the upper half of a scalar register, but GlobalISel selects
+; s32 to the lower half.  Functions with f32 arguments, returns or
+; arithmetic fall back to SelectionDAG, which uses the upper half.
+
+; FALLBACK: warning: Instruction selection used fallback path for arg_f32
+define double @arg_f32(float %a) {
+; CHECK-LABEL: arg_f32:
+; CHECK:       cvt.d.s %s0, %s0
+  %r = fpext float %a to double
+  ret double %r
+}
+
+; FALLBACK: warning: Instruction selection used fallback path for ret_f32
+define float @ret_f32(double %a) {
+; CHECK-LABEL: ret_f32:
+; CHECK:       cvt.s.d %s0, %s0
+  %r = fptrunc double %a to float
+  ret float %r
+}
+
+; FALLBACK: warning: Instruction selection used fallback path for fadd_f32
+define void @fadd_f32(float* %p, float* %q) {
+; CHECK-LABEL: fadd_f32:
+; CHECK:       ldu [[A:%s[0-9]+]], (,%s0)
+; CHECK:       ldu [[B:%s[0-9]+]], (,%s1)
+; CHECK:       fadd.s [[R:%s[0-9]+]], [[A]], [[B]]
+; CHECK:       stu [[R]], (,%s0)
+  %a = load float, float* %p
+  %b = load float, float* %q
+  %r = fadd float %a, %b
+  store float %r, float* %p
+  ret void
+}
+
+; f64 and f128 arithmetic is selected by GlobalISel.
+; FALLBACK-NOT: fallback path
+define void @fmul_f64(double* %p, double* %q) {
+; CHECK-LABEL: fmul_f64:
+; CHECK:       ld [[A:%s[0-9]+]], (,%s0)
+; CHECK:       ld [[B:%s[0-9]+]], (,%s1)
+; CHECK:       fmul.d [[R:%s[0-9]+]], [[A]], [[B]]
+; CHECK:       st [[R]], (,%s0)
+  %a = load double, double* %p
+  %b = load double, double* %q
+  %r = fmul double %a, %b
+  store double %r, double* %p
+  ret void
+}
+
+; Copying an f32 through memory only moves bits, so it stays in GlobalISel.
+define void @load_store_f32(float* %p, float* %q) {
+; CHECK-LABEL: load_store_f32:
+; CHECK:       ldl.sx [[V:%s[0-9]+]], (,%s1)
+; CHECK:       stl [[V]], (,%s0)
+  %v = load float, float* %q
+  store float %v, float* %p
+  ret void
+}
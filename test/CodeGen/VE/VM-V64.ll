@@ -50,25 +50,25 @@ declare void @llvm.ve.vstl.vss(<256 x double>, i64, i8*)
 ; Function Attrs: nounwind
 define void @VM256V64_test2(i32) {
 ; ENABLE-LABEL:   VM256V64_test2:
-; ENABLE:         .LBB{{[0-9]+}}_6:
+; ENABLE:         .LBB{{[0-9]+}}_2:
 ; ENABLE-NEXT:      lea.sl %s34, pIn@hi
 ; ENABLE-NEXT:      ld %s34, pIn@lo(,%s34)
 ; ENABLE-NEXT:      vldu %v0,4,%s34
 ; ENABLE-NEXT:      lea %s35, -1(%s0)
 ; ENABLE-NEXT:      or %s36, 1, (0)1
 ; ENABLE-NEXT:      vfmk.s.eq %vm2,%v0
-; ENABLE-NEXT:      brlt.w %s35, %s36, .LBB1_1
-; ENABLE:         .LBB{{[0-9]+}}_3:
+; ENABLE-NEXT:      brlt.w %s35, %s36, .LBB1_5
+; ENABLE:         .LBB{{[0-9]+}}_4:
 ; ENABLE-NEXT:      nndm %vm1,%vm2,%vm1
-; ENABLE-NEXT:      brgt.w %s35, %s36, .LBB1_3
-; ENABLE-NEXT:      br.l .LBB1_4
-; ENABLE:         .LBB{{[0-9]+}}_1:
+; ENABLE-NEXT:      brgt.w %s35, %s36, .LBB1_4
+; ENABLE-NEXT:      br.l .LBB1_6
+; ENABLE:         .LBB{{[0-9]+}}_5:
 ; ENABLE-NEXT:      andm %vm1,%vm0,%vm2
-; ENABLE:         .LBB{{[0-9]+}}_4:
+; ENABLE:         .LBB{{[0-9]+}}_6:
 ; ENABLE-NEXT:      vadds.l %v0,%v0,%v0,%vm1
 ; ENABLE-NEXT:      vstl %v0,4,%s34
 ; DISABLE-LABEL:  VM256V64_test2:
-; DISABLE:        .LBB{{[0-9]+}}_6:
+; DISABLE:        .LBB{{[0-9]+}}_2:
 ; DISABLE-NEXT:     lea.sl %s34, pIn@hi
 ; DISABLE-NEXT:     ld %s34, pIn@lo(,%s34)
 ; DISABLE-NEXT:     vldu %v0,4,%s34
@@ -83,8 +83,8 @@ define void @VM256V64_test2(i32) {
 ; DISABLE-NEXT:     lsv %v1(2),%s16
 ; DISABLE-NEXT:     svm %s16,%vm1,3
 ; DISABLE-NEXT:     lsv %v1(3),%s16
-; DISABLE-NEXT:     brlt.w %s35, %s36, .LBB1_1
-; DISABLE:        .LBB{{[0-9]+}}_3:
+; DISABLE-NEXT:     brlt.w %s35, %s36, .LBB1_5
+; DISABLE:        .LBB{{[0-9]+}}_4:
 ; DISABLE-NEXT:     lvs %s16,%v2(0)
 ; DISABLE-NEXT:     lvm %vm1,0,%s16
 ; DISABLE-NEXT:     lvs %s16,%v2(1)
@@ -110,11 +110,11 @@ define void @VM256V64_test2(i32) {
 ; DISABLE-NEXT:     lsv %v2(2),%s16
 ; DISABLE-NEXT:     svm %s16,%vm1,3
 ; DISABLE-NEXT:     lsv %v2(3),%s16
-; DISABLE-NEXT:     brgt.w %s35, %s36, .LBB1_3
-; DISABLE-NEXT:     br.l .LBB1_4
-; DISABLE:        .LBB{{[0-9]+}}_1:
+; DISABLE-NEXT:     brgt.w %s35, %s36, .LBB1_4
+; DISABLE-NEXT:     br.l .LBB1_6
+; DISABLE:        .LBB{{[0-9]+}}_5:
 ; DISABLE-NEXT:     vor %v2,(0)1,%v1
-; DISABLE:        .LBB{{[0-9]+}}_4:
+; DISABLE:        .LBB{{[0-9]+}}_6:
 ; DISABLE-NEXT:     lvs %s16,%v2(0)
 ; DISABLE-NEXT:     lvm %vm1,0,%s16
 ; DISABLE-NEXT:     lvs %s16,%v2(1)
@@ -189,7 +189,7 @@ declare <256 x double> @llvm.ve.pvadds.vvvMv(<256 x double>, <256 x double>, <8
 ; Function Attrs: nounwind
 define void @VM512V64_test2(i32) {
 ; ENABLE-LABEL:   VM512V64_test2:
-; ENABLE:         .LBB{{[0-9]+}}_4:
+; ENABLE:         .LBB{{[0-9]+}}_2:
 ; ENABLE-NEXT:      lea.sl %s34, pIn@hi
 ; ENABLE-NEXT:      ld %s34, pIn@lo(,%s34)
 ; ENABLE-NEXT:      vldu %v0,4,%s34
@@ -198,16 +198,16 @@ define void @VM512V64_test2(i32) {
 ; ENABLE-NEXT:      or %s35, 1, (0)1
 ; ENABLE-NEXT:      nndm %vm2,%vm4,%vm4
 ; ENABLE-NEXT:      nndm %vm3,%vm5,%vm5
-; ENABLE-NEXT:      brlt.w %s0, %s35, .LBB3_2
-; ENABLE:         .LBB{{[0-9]+}}_1:
+; ENABLE-NEXT:      brlt.w %s0, %s35, .LBB3_4
+; ENABLE:         .LBB{{[0-9]+}}_3:
 ; ENABLE-NEXT:      nndm %vm2,%vm4,%vm2
 ; ENABLE-NEXT:      nndm %vm3,%vm5,%vm3
-; ENABLE-NEXT:      brlt.w %s0, %s35, .LBB3_1
-; ENABLE:         .LBB{{[0-9]+}}_2:
+; ENABLE-NEXT:      brlt.w %s0, %s35, .LBB3_3
+; ENABLE:         .LBB{{[0-9]+}}_4:
 ; ENABLE-NEXT:      pvadds %v0,%v0,%v0,%vm2
 ; ENABLE-NEXT:      vstl %v0,4,%s34
 ; DISABLE-LABEL:  VM512V64_test2:
-; DISABLE:        .LBB{{[0-9]+}}_5:
+; DISABLE:        .LBB{{[0-9]+}}_2:
 ; DISABLE-NEXT:     lea.sl %s34, pIn@hi
 ; DISABLE-NEXT:     ld %s34, pIn@lo(,%s34)
 ; DISABLE-NEXT:     vldu %v0,4,%s34
@@ -232,8 +232,8 @@ define void @VM512V64_test2(i32) {
 ; DISABLE-NEXT:     lsv %v1(6),%s16
 ; DISABLE-NEXT:     svm %s16,%vm5,3
 ; DISABLE-NEXT:     lsv %v1(7),%s16
-; DISABLE-NEXT:     brlt.w %s0, %s35, .LBB{{[0-9]+}}_3
-; DISABLE:        .LBB{{[0-9]+}}_2:
+; DISABLE-NEXT:     brlt.w %s0, %s35, .LBB{{[0-9]+}}_5
+; DISABLE:        .LBB{{[0-9]+}}_4:
 ; DISABLE-NEXT:     lvs %s16,%v1(0)
 ; DISABLE-NEXT:     lvm %vm4,0,%s16
 ; DISABLE-NEXT:     lvs %s16,%v1(1)
@@ -268,8 +268,8 @@ define void @VM512V64_test2(i32) {
 ; DISABLE-NEXT:     lsv %v1(6),%s16
 ; DISABLE-NEXT:     svm %s16,%vm5,3
 ; DISABLE-NEXT:     lsv %v1(7),%s16
-; DISABLE-NEXT:     brlt.w %s0, %s35, .LBB{{[0-9]+}}_2
-; DISABLE:        .LBB{{[0-9]+}}_3:
+; DISABLE-NEXT:     brlt.w %s0, %s35, .LBB{{[0-9]+}}_4
+; DISABLE:        .LBB{{[0-9]+}}_5:
 ; DISABLE-NEXT:     lvs %s16,%v1(0)
 ; DISABLE-NEXT:     lvm %vm2,0,%s16
 ; DISABLE-NEXT:     lvs %s16,%v1(1)
@@ -0,0 +1,72 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown | FileCheck %s
+; RUN: llc < %s -mtriple=ve-unknown-unknown -ve-machine-combiner=0 \
+; RUN:   | FileCheck %s --check-prefix=NOCOMB
+
+; Loads and stores use the full disp(index, base) form of the ASX format.
+
+define i64 @ld_base_index(i64* %p, i64 %i) {
+; CHECK-LABEL: ld_base_index:
+; CHECK:       sll [[IDX:%s[0-9]+]], %s1, 3
+; CHECK-NEXT:  ld %s0, ([[IDX]], %s0)
+  %a = getelementptr i64, i64* %p, i64 %i
+  %v = load i64, i64* %a, align 8
+  ret i64 %v
+}
+
+define i64 @ld_base_index_disp(i64* %p, i64 %i) {
+; CHECK-LABEL: ld_base_index_disp:
+; CHECK:       sll [[IDX:%s[0-9]+]], %s1, 3
+; CHECK-NEXT:  ld %s0, 16([[IDX]], %s0)
+  %j = add i64 %i, 2
+  %a = getelementptr i64, i64* %p, i64 %j
+  %v = load i64, i64* %a, align 8
+  ret i64 %v
+}
+
+define void @st_base_index(i32* %p, i64 %i, i32 %v) {
+; CHECK-LABEL: st_base_index:
+; CHECK:       sll [[IDX:%s[0-9]+]], %s1, 2
+; CHECK-NEXT:  stl %s2, ([[IDX]], %s0)
+  %a = getelementptr i32, i32* %p, i64 %i
+  store i32 %v, i32* %a, align 4
+  ret void
+}
+
+; 64-bit constants take LEA and LEA.SL without clearing the upper half.
+
+define i64 @imm_hi() {
+; CHECK-LABEL: imm_hi:
+; CHECK:       lea.sl %s0, 4660
+; CHECK-NEXT:  or %s11, 0, %s9
+  ret i64 20014547599360
+}
+
+define i64 @imm_lo_positive() {
+; CHECK-LABEL: imm_lo_positive:
+; CHECK:       lea [[LO:%s[0-9]+]], 2
+; CHECK-NEXT:  lea.sl %s0, 1([[LO]])
+; CHECK-NEXT:  or %s11, 0, %s9
+  ret i64 4294967298
+}
+
+define i64 @imm_lo_negative() {
+; CHECK-LABEL: imm_lo_negative:
+; CHECK:       lea [[LO:%s[0-9]+]], -16
+; CHECK-NEXT:  lea.sl %s0, 2([[LO]])
+; CHECK-NEXT:  or %s11, 0, %s9
+  ret i64 8589934576
+}
+
+; Chains of additions are reassociated to shorten the critical path.
+
+define i64 @reassoc(i64 %a, i64 %b, i64 %c, i64 %d) {
+; CHECK-LABEL: reassoc:
+; CHECK:       adds.l %s{{[0-9]+}}, %s{{[23]}}, %s{{[23]}}
+; CHECK:       adds.l %s0,
+; NOCOMB-LABEL: reassoc:
+; NOCOMB:      adds.l %s0, %s{{[0-9]+}}, %s3
+  %ab = add i64 %a, %b
+  %abc = add i64 %ab, %c
+  %abcd = add i64 %abc, %d
+  ret i64 %abcd
+}
@@ -366,7 +366,6 @@ define i64 @test_atomic_exchange_8() {
 ; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  lea.sl %s34, l@hi
 ; CHECK-NEXT:  lea %s35, 1886417008
-; CHECK-NEXT:  and %s35, %s35, (32)0
 ; CHECK-NEXT:  lea.sl %s0, 1886417008(%s35)
 ; CHECK-NEXT:  ts1am.l %s0, l@lo(%s34), 127
 ; CHECK-NEXT:  fencem 2
@@ -387,7 +386,6 @@ define i128 @test_atomic_exchange_16() {
 ; CHECK-NEXT:  and %s34, %s34, (32)0
 ; CHECK-NEXT:  lea.sl %s0, it@hi(%s34)
 ; CHECK-NEXT:  lea %s34, 1886417008
-; CHECK-NEXT:  and %s34, %s34, (32)0
 ; CHECK-NEXT:  lea.sl %s1, 1886417008(%s34)
 ; CHECK-NEXT:  or %s2, 0, (0)1
 ; CHECK-NEXT:  or %s3, 2, (0)1
@@ -401,7 +399,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i8 @test_atomic_compare_exchange_1() {
 ; CHECK-LABEL: test_atomic_compare_exchange_1:
-; CHECK:       .LBB{{[0-9]+}}_5:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, c@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -411,17 +409,17 @@ define signext i8 @test_atomic_compare_exchange_1() {
 ; CHECK-NEXT:  lea %s36, -256
 ; CHECK-NEXT:  and %s38, %s35, %s36
 ; CHECK-NEXT:  or %s0, 0, (0)1
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s38
 ; CHECK-NEXT:  or %s37, 0, %s38
 ; CHECK-NEXT:  cas.w %s37, (%s34), %s38
-; CHECK-NEXT:  breq.w %s37, %s38, .LBB{{[0-9]+}}_3
+; CHECK-NEXT:  breq.w %s37, %s38, .LBB{{[0-9]+}}_5
 ; CHECK-NEXT:  # %partword.cmpxchg.failure
-; CHECK-NEXT:  #   in Loop: Header=BB25_1 Depth=1
+; CHECK-NEXT:  #   in Loop: Header=BB25_3 Depth=1
 ; CHECK-NEXT:  and %s38, %s37, %s36
-; CHECK-NEXT:  brne.w %s35, %s38, .LBB{{[0-9]+}}_1
-; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
+; CHECK-NEXT:  brne.w %s35, %s38, .LBB{{[0-9]+}}_3
+; CHECK-NEXT:  .LBB{{[0-9]+}}_5:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  cmps.w.sx %s34, %s37, %s35
 ; CHECK-NEXT:  cmov.w.eq %s0, (63)0, %s34
@@ -437,7 +435,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i16 @test_atomic_compare_exchange_2() {
 ; CHECK-LABEL: test_atomic_compare_exchange_2:
-; CHECK:       .LBB{{[0-9]+}}_5:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, s@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -449,17 +447,17 @@ define signext i16 @test_atomic_compare_exchange_2() {
 ; CHECK-NEXT:  sla.w.sx %s38, %s35, 16
 ; CHECK-NEXT:  or %s0, 0, (0)1
 ; CHECK-NEXT:  lea %s37, -65536
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s38
 ; CHECK-NEXT:  or %s36, 0, %s38
 ; CHECK-NEXT:  cas.w %s36, (%s34), %s38
-; CHECK-NEXT:  breq.w %s36, %s38, .LBB{{[0-9]+}}_3
+; CHECK-NEXT:  breq.w %s36, %s38, .LBB{{[0-9]+}}_5
 ; CHECK-NEXT:  # %partword.cmpxchg.failure
-; CHECK-NEXT:  #   in Loop: Header=BB{{[0-9]+}}_1 Depth=1
+; CHECK-NEXT:  #   in Loop: Header=BB{{[0-9]+}}_3 Depth=1
 ; CHECK-NEXT:  and %s38, %s36, %s37
-; CHECK-NEXT:  brne.w %s35, %s38, .LBB{{[0-9]+}}_1
-; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
+; CHECK-NEXT:  brne.w %s35, %s38, .LBB{{[0-9]+}}_3
+; CHECK-NEXT:  .LBB{{[0-9]+}}_5:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  cmps.w.sx %s34, %s36, %s35
 ; CHECK-NEXT:  cmov.w.eq %s0, (63)0, %s34
@@ -1152,7 +1150,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i8 @test_atomic_fetch_add_1() {
 ; CHECK-LABEL: test_atomic_fetch_add_1:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, c@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -1160,7 +1158,7 @@ define signext i8 @test_atomic_fetch_add_1() {
 ; CHECK-NEXT:  and %s34, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s36, (,%s34)
 ; CHECK-NEXT:  lea %s35, -256
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s37, 0, %s36
 ; CHECK-NEXT:  lea %s36, 1(%s36)
@@ -1168,7 +1166,7 @@ define signext i8 @test_atomic_fetch_add_1() {
 ; CHECK-NEXT:  and %s38, %s37, %s35
 ; CHECK-NEXT:  or %s36, %s38, %s36
 ; CHECK-NEXT:  cas.w %s36, (%s34), %s37
-; CHECK-NEXT:  brne.w %s36, %s37, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s36, %s37, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s36, 24
@@ -1182,7 +1180,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i16 @test_atomic_fetch_add_2() {
 ; CHECK-LABEL: test_atomic_fetch_add_2:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, s@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -1190,7 +1188,7 @@ define signext i16 @test_atomic_fetch_add_2() {
 ; CHECK-NEXT:  and %s34, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s36, (,%s34)
 ; CHECK-NEXT:  lea %s35, -65536
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s37, 0, %s36
 ; CHECK-NEXT:  lea %s36, 1(%s36)
@@ -1198,7 +1196,7 @@ define signext i16 @test_atomic_fetch_add_2() {
 ; CHECK-NEXT:  and %s38, %s37, %s35
 ; CHECK-NEXT:  or %s36, %s38, %s36
 ; CHECK-NEXT:  cas.w %s36, (%s34), %s37
-; CHECK-NEXT:  brne.w %s36, %s37, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s36, %s37, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s36, 16
@@ -1212,16 +1210,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_add_4() {
 ; CHECK-LABEL: test_atomic_fetch_add_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, i@hi
 ; CHECK-NEXT:  ldl.sx %s0, i@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  lea %s0, 1(%s0)
 ; CHECK-NEXT:  cas.w %s0, i@lo(%s34), %s35
-; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1233,16 +1231,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i64 @test_atomic_fetch_add_8() {
 ; CHECK-LABEL: test_atomic_fetch_add_8:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, l@hi
 ; CHECK-NEXT:  ld %s0, l@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  lea %s0, 1(%s0)
 ; CHECK-NEXT:  cas.l %s0, l@lo(%s34), %s35
-; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1274,7 +1272,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i8 @test_atomic_fetch_sub_1() {
 ; CHECK-LABEL: test_atomic_fetch_sub_1:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, c@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -1282,7 +1280,7 @@ define signext i8 @test_atomic_fetch_sub_1() {
 ; CHECK-NEXT:  and %s34, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s36, (,%s34)
 ; CHECK-NEXT:  lea %s35, -256
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s37, 0, %s36
 ; CHECK-NEXT:  lea %s36, -1(%s36)
@@ -1290,7 +1288,7 @@ define signext i8 @test_atomic_fetch_sub_1() {
 ; CHECK-NEXT:  and %s38, %s37, %s35
 ; CHECK-NEXT:  or %s36, %s38, %s36
 ; CHECK-NEXT:  cas.w %s36, (%s34), %s37
-; CHECK-NEXT:  brne.w %s36, %s37, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s36, %s37, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s36, 24
@@ -1304,7 +1302,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i16 @test_atomic_fetch_sub_2() {
 ; CHECK-LABEL: test_atomic_fetch_sub_2:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, s@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -1312,7 +1310,7 @@ define signext i16 @test_atomic_fetch_sub_2() {
 ; CHECK-NEXT:  and %s34, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s36, (,%s34)
 ; CHECK-NEXT:  lea %s35, -65536
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s37, 0, %s36
 ; CHECK-NEXT:  lea %s36, -1(%s36)
@@ -1320,7 +1318,7 @@ define signext i16 @test_atomic_fetch_sub_2() {
 ; CHECK-NEXT:  and %s38, %s37, %s35
 ; CHECK-NEXT:  or %s36, %s38, %s36
 ; CHECK-NEXT:  cas.w %s36, (%s34), %s37
-; CHECK-NEXT:  brne.w %s36, %s37, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s36, %s37, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s36, 16
@@ -1334,16 +1332,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_sub_4() {
 ; CHECK-LABEL: test_atomic_fetch_sub_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, i@hi
 ; CHECK-NEXT:  ldl.sx %s0, i@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  lea %s0, -1(%s0)
 ; CHECK-NEXT:  cas.w %s0, i@lo(%s34), %s35
-; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1355,16 +1353,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i64 @test_atomic_fetch_sub_8() {
 ; CHECK-LABEL: test_atomic_fetch_sub_8:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, l@hi
 ; CHECK-NEXT:  ld %s0, l@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  lea %s0, -1(%s0)
 ; CHECK-NEXT:  cas.l %s0, l@lo(%s34), %s35
-; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1396,7 +1394,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i8 @test_atomic_fetch_and_1() {
 ; CHECK-LABEL: test_atomic_fetch_and_1:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, c@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -1404,12 +1402,12 @@ define signext i8 @test_atomic_fetch_and_1() {
 ; CHECK-NEXT:  and %s35, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s34, (,%s35)
 ; CHECK-NEXT:  lea %s36, -255
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s37, 0, %s34
 ; CHECK-NEXT:  and %s34, %s34, %s36
 ; CHECK-NEXT:  cas.w %s34, (%s35), %s37
-; CHECK-NEXT:  brne.w %s34, %s37, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s34, %s37, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s34, 24
@@ -1423,7 +1421,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i16 @test_atomic_fetch_and_2() {
 ; CHECK-LABEL: test_atomic_fetch_and_2:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, s@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -1431,12 +1429,12 @@ define signext i16 @test_atomic_fetch_and_2() {
 ; CHECK-NEXT:  and %s35, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s34, (,%s35)
 ; CHECK-NEXT:  lea %s36, -65535
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s37, 0, %s34
 ; CHECK-NEXT:  and %s34, %s34, %s36
 ; CHECK-NEXT:  cas.w %s34, (%s35), %s37
-; CHECK-NEXT:  brne.w %s34, %s37, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s34, %s37, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s34, 16
@@ -1450,16 +1448,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_and_4() {
 ; CHECK-LABEL: test_atomic_fetch_and_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, i@hi
 ; CHECK-NEXT:  ldl.sx %s0, i@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  and %s0, 1, %s0
 ; CHECK-NEXT:  cas.w %s0, i@lo(%s34), %s35
-; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1471,16 +1469,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i64 @test_atomic_fetch_and_8() {
 ; CHECK-LABEL: test_atomic_fetch_and_8:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, l@hi
 ; CHECK-NEXT:  ld %s0, l@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  and %s0, 1, %s0
 ; CHECK-NEXT:  cas.l %s0, l@lo(%s34), %s35
-; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1512,19 +1510,19 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i8 @test_atomic_fetch_or_1() {
 ; CHECK-LABEL: test_atomic_fetch_or_1:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, c@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
 ; CHECK-NEXT:  lea.sl %s34, c@hi(%s34)
 ; CHECK-NEXT:  and %s35, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s34, (,%s35)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s36, 0, %s34
 ; CHECK-NEXT:  or %s34, 1, %s34
 ; CHECK-NEXT:  cas.w %s34, (%s35), %s36
-; CHECK-NEXT:  brne.w %s34, %s36, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s34, %s36, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s34, 24
@@ -1538,19 +1536,19 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i16 @test_atomic_fetch_or_2() {
 ; CHECK-LABEL: test_atomic_fetch_or_2:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, s@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
 ; CHECK-NEXT:  lea.sl %s34, s@hi(%s34)
 ; CHECK-NEXT:  and %s35, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s34, (,%s35)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s36, 0, %s34
 ; CHECK-NEXT:  or %s34, 1, %s34
 ; CHECK-NEXT:  cas.w %s34, (%s35), %s36
-; CHECK-NEXT:  brne.w %s34, %s36, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s34, %s36, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s34, 16
@@ -1564,16 +1562,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_or_4() {
 ; CHECK-LABEL: test_atomic_fetch_or_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, i@hi
 ; CHECK-NEXT:  ldl.sx %s0, i@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  or %s0, 1, %s0
 ; CHECK-NEXT:  cas.w %s0, i@lo(%s34), %s35
-; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1585,16 +1583,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i64 @test_atomic_fetch_or_8() {
 ; CHECK-LABEL: test_atomic_fetch_or_8:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, l@hi
 ; CHECK-NEXT:  ld %s0, l@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  or %s0, 1, %s0
 ; CHECK-NEXT:  cas.l %s0, l@lo(%s34), %s35
-; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1626,19 +1624,19 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i8 @test_atomic_fetch_xor_1() {
 ; CHECK-LABEL: test_atomic_fetch_xor_1:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, c@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
 ; CHECK-NEXT:  lea.sl %s34, c@hi(%s34)
 ; CHECK-NEXT:  and %s35, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s34, (,%s35)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s36, 0, %s34
 ; CHECK-NEXT:  xor %s34, 1, %s34
 ; CHECK-NEXT:  cas.w %s34, (%s35), %s36
-; CHECK-NEXT:  brne.w %s34, %s36, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s34, %s36, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s34, 24
@@ -1652,19 +1650,19 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i16 @test_atomic_fetch_xor_2() {
 ; CHECK-LABEL: test_atomic_fetch_xor_2:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, s@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
 ; CHECK-NEXT:  lea.sl %s34, s@hi(%s34)
 ; CHECK-NEXT:  and %s35, -4, %s34
 ; CHECK-NEXT:  ldl.sx %s34, (,%s35)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s36, 0, %s34
 ; CHECK-NEXT:  xor %s34, 1, %s34
 ; CHECK-NEXT:  cas.w %s34, (%s35), %s36
-; CHECK-NEXT:  brne.w %s34, %s36, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s34, %s36, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s34, 16
@@ -1678,16 +1676,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_xor_4() {
 ; CHECK-LABEL: test_atomic_fetch_xor_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, i@hi
 ; CHECK-NEXT:  ldl.sx %s0, i@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  xor %s0, 1, %s0
 ; CHECK-NEXT:  cas.w %s0, i@lo(%s34), %s35
-; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1699,16 +1697,16 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i64 @test_atomic_fetch_xor_8() {
 ; CHECK-LABEL: test_atomic_fetch_xor_8:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, l@hi
 ; CHECK-NEXT:  ld %s0, l@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  xor %s0, 1, %s0
 ; CHECK-NEXT:  cas.l %s0, l@lo(%s34), %s35
-; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1740,7 +1738,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i8 @test_atomic_fetch_nand_1() {
 ; CHECK-LABEL: test_atomic_fetch_nand_1:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, c@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -1749,7 +1747,7 @@ define signext i8 @test_atomic_fetch_nand_1() {
 ; CHECK-NEXT:  ldl.sx %s37, (,%s34)
 ; CHECK-NEXT:  lea %s35, 254
 ; CHECK-NEXT:  lea %s36, -256
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s38, 0, %s37
 ; CHECK-NEXT:  xor %s37, -1, %s37
@@ -1758,7 +1756,7 @@ define signext i8 @test_atomic_fetch_nand_1() {
 ; CHECK-NEXT:  and %s39, %s38, %s36
 ; CHECK-NEXT:  or %s37, %s39, %s37
 ; CHECK-NEXT:  cas.w %s37, (%s34), %s38
-; CHECK-NEXT:  brne.w %s37, %s38, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s37, %s38, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s37, 24
@@ -1772,7 +1770,7 @@ entry:
 ; Function Attrs: norecurse nounwind
 define signext i16 @test_atomic_fetch_nand_2() {
 ; CHECK-LABEL: test_atomic_fetch_nand_2:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea %s34, s@lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
@@ -1781,7 +1779,7 @@ define signext i16 @test_atomic_fetch_nand_2() {
 ; CHECK-NEXT:  ldl.sx %s37, (,%s34)
 ; CHECK-NEXT:  lea %s35, 65534
 ; CHECK-NEXT:  lea %s36, -65536
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s38, 0, %s37
 ; CHECK-NEXT:  xor %s37, -1, %s37
@@ -1790,7 +1788,7 @@ define signext i16 @test_atomic_fetch_nand_2() {
 ; CHECK-NEXT:  and %s39, %s38, %s36
 ; CHECK-NEXT:  or %s37, %s39, %s37
 ; CHECK-NEXT:  cas.w %s37, (%s34), %s38
-; CHECK-NEXT:  brne.w %s37, %s38, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s37, %s38, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  sla.w.sx %s34, %s37, 16
@@ -1804,17 +1802,17 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_nand_4() {
 ; CHECK-LABEL: test_atomic_fetch_nand_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, i@hi
 ; CHECK-NEXT:  ldl.sx %s0, i@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  xor %s36, -1, %s0
 ; CHECK-NEXT:  or %s0, -2, %s36
 ; CHECK-NEXT:  cas.w %s0, i@lo(%s34), %s35
-; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1826,17 +1824,17 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i64 @test_atomic_fetch_nand_8() {
 ; CHECK-LABEL: test_atomic_fetch_nand_8:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, l@hi
 ; CHECK-NEXT:  ld %s0, l@lo(,%s34)
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s35, 0, %s0
 ; CHECK-NEXT:  xor %s36, -1, %s0
 ; CHECK-NEXT:  or %s0, -2, %s36
 ; CHECK-NEXT:  cas.l %s0, l@lo(%s34), %s35
-; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.l %s0, %s35, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1868,17 +1866,17 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_max_4() {
 ; CHECK-LABEL: test_atomic_fetch_max_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, i@hi
 ; CHECK-NEXT:  ldl.sx %s0, i@lo(,%s34)
 ; CHECK-NEXT:  or %s35, 1, (0)1
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s36, 0, %s0
 ; CHECK-NEXT:  maxs.w.zx %s0, %s0, %s35
 ; CHECK-NEXT:  cas.w %s0, i@lo(%s34), %s36
-; CHECK-NEXT:  brne.w %s0, %s36, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s36, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  or %s11, 0, %s9
@@ -1890,20 +1888,20 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_min_4() {
 ; CHECK-LABEL: test_atomic_fetch_min_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, i@hi
 ; CHECK-NEXT:  ldl.sx %s0, i@lo(,%s34)
 ; CHECK-NEXT:  or %s35, 1, (0)1
 ; CHECK-NEXT:  or %s36, 2, (0)1
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s37, 0, %s0
 ; CHECK-NEXT:  cmps.w.sx %s38, %s0, %s36
 ; CHECK-NEXT:  or %s0, 0, %s35
 ; CHECK-NEXT:  cmov.w.lt %s0, %s37, %s38
 ; CHECK-NEXT:  cas.w %s0, i@lo(%s34), %s37
-; CHECK-NEXT:  brne.w %s0, %s37, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s37, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  # kill: def $sw0 killed $sw0 killed $sx0
@@ -1916,19 +1914,19 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_umax_4() {
 ; CHECK-LABEL: test_atomic_fetch_umax_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, ui@hi
 ; CHECK-NEXT:  ldl.sx %s0, ui@lo(,%s34)
 ; CHECK-NEXT:  or %s35, 1, (0)1
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s36, 0, %s0
 ; CHECK-NEXT:  cmpu.w %s37, %s0, %s35
 ; CHECK-NEXT:  or %s0, 0, %s35
 ; CHECK-NEXT:  cmov.w.gt %s0, %s36, %s37
 ; CHECK-NEXT:  cas.w %s0, ui@lo(%s34), %s36
-; CHECK-NEXT:  brne.w %s0, %s36, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s36, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  # kill: def $sw0 killed $sw0 killed $sx0
@@ -1941,20 +1939,20 @@ entry:
 ; Function Attrs: norecurse nounwind
 define i32 @test_atomic_fetch_umin_4() {
 ; CHECK-LABEL: test_atomic_fetch_umin_4:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  lea.sl %s34, ui@hi
 ; CHECK-NEXT:  ldl.sx %s0, ui@lo(,%s34)
 ; CHECK-NEXT:  or %s35, 1, (0)1
 ; CHECK-NEXT:  or %s36, 2, (0)1
-; CHECK-NEXT:  .LBB{{[0-9]+}}_1:
+; CHECK-NEXT:  .LBB{{[0-9]+}}_3:
 ; CHECK-NEXT:  # =>This Inner Loop Header: Depth=1
 ; CHECK-NEXT:  or %s37, 0, %s0
 ; CHECK-NEXT:  cmpu.w %s38, %s0, %s36
 ; CHECK-NEXT:  or %s0, 0, %s35
 ; CHECK-NEXT:  cmov.w.lt %s0, %s37, %s38
 ; CHECK-NEXT:  cas.w %s0, ui@lo(%s34), %s37
-; CHECK-NEXT:  brne.w %s0, %s37, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:  brne.w %s0, %s37, .LBB{{[0-9]+}}_3
 ; CHECK-NEXT:  # %atomicrmw.end
 ; CHECK-NEXT:  fencem 3
 ; CHECK-NEXT:  # kill: def $sw0 killed $sw0 killed $sx0
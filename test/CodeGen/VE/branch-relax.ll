@@ -0,0 +1,46 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown -ve-bcr-offset-bits=7 \
+; RUN:   | FileCheck %s --check-prefix=BCR
+; RUN: llc < %s -mtriple=ve-unknown-unknown -ve-bcr-offset-bits=7 \
+; RUN:   -ve-br-offset-bits=7 | FileCheck %s --check-prefix=BR
+; RUN: llc < %s -mtriple=ve-unknown-unknown -ve-bcr-offset-bits=5 \
+; RUN:   -ve-br-offset-bits=5 -verify-machineinstrs \
+; RUN:   | FileCheck %s --check-prefix=BR
+; RUN: llc < %s -mtriple=ve-unknown-unknown -ve-bcr-offset-bits=7 \
+; RUN:   -ve-br-offset-bits=7 -relocation-model=pic \
+; RUN:   | FileCheck %s --check-prefix=PIC
+
+; Branch displacements are 32 bits.  Restrict them to 7 bits to check that
+; out of range branches are relaxed.  Fewer bits can't reach over the 40
+; bytes of an expanded indirect branch, so narrower ranges are widened to 7
+; bits and give the same code.
+
+define i32 @relax(i32 %a) {
+; BCR-LABEL: relax:
+; BCR:       br{{[a-z]*}}.w %s0, %s{{[0-9]+}}, .LBB0_[[NEAR:[0-9]+]]
+; BCR:       br.l .LBB0_
+; BCR:       .LBB0_[[NEAR]]:
+; BCR:       nop
+;
+; BR-LABEL:  relax:
+; BR:        lea %s12, .LBB0_[[FAR:[0-9]+]]@lo
+; BR-NEXT:   and %s12, %s12, (32)0
+; BR-NEXT:   lea.sl %s12, .LBB0_[[FAR]]@hi(%s12)
+; BR-NEXT:   b.l (,%s12)
+;
+; PIC-LABEL: relax:
+; PIC:       lea %s12, .LBB0_[[FAR:[0-9]+]]@pc_lo(-24)
+; PIC-NEXT:  and %s12, %s12, (32)0
+; PIC-NEXT:  sic %s16
+; PIC-NEXT:  lea.sl %s12, .LBB0_[[FAR]]@pc_hi(%s16, %s12)
+; PIC-NEXT:  b.l (,%s12)
+entry:
+  %c = icmp eq i32 %a, 0
+  br i1 %c, label %far, label %near
+
+near:
+  call void asm sideeffect "nop\0Anop\0Anop\0Anop\0Anop\0Anop\0Anop\0Anop", ""()
+  ret i32 1
+
+far:
+  ret i32 0
+}
@@ -2,8 +2,8 @@
 
 define signext i8 @func1(i8 signext, i8 signext) {
 ; CHECK-LABEL: func1:
-; CHECK:       .LBB{{[0-9]+}}_5:
-; CHECK-NEXT:    brle.w %s0, %s1, .LBB{{[0-9]+}}_1
+; CHECK:       .LBB{{[0-9]+}}_2:
+; CHECK-NEXT:    brle.w %s0, %s1, .LBB{{[0-9]+}}_4
   %3 = icmp sgt i8 %0, %1
   br i1 %3, label %4, label %7
 
@@ -21,8 +21,8 @@ declare i32 @ret(i32)
 
 define i32 @func2(i16 signext, i16 signext) {
 ; CHECK-LABEL: func2:
-; CHECK:       .LBB{{[0-9]+}}_5:
-; CHECK-NEXT:    brle.w %s0, %s1, .LBB{{[0-9]+}}_1
+; CHECK:       .LBB{{[0-9]+}}_2:
+; CHECK-NEXT:    brle.w %s0, %s1, .LBB{{[0-9]+}}_4
   %3 = icmp sgt i16 %0, %1
   br i1 %3, label %4, label %6
 
@@ -37,8 +37,8 @@ define i32 @func2(i16 signext, i16 signext) {
 
 define i32 @func3(i32, i32) {
 ; CHECK-LABEL: func3:
-; CHECK:       .LBB{{[0-9]+}}_5:
-; CHECK-NEXT:    brle.w %s0, %s1, .LBB{{[0-9]+}}_1
+; CHECK:       .LBB{{[0-9]+}}_2:
+; CHECK-NEXT:    brle.w %s0, %s1, .LBB{{[0-9]+}}_4
   %3 = icmp sgt i32 %0, %1
   br i1 %3, label %4, label %6
 
@@ -53,8 +53,8 @@ define i32 @func3(i32, i32) {
 
 define i32 @func4(i64, i64) {
 ; CHECK-LABEL: func4:
-; CHECK:       .LBB{{[0-9]+}}_5:
-; CHECK-NEXT:    brle.l %s0, %s1, .LBB{{[0-9]+}}_1
+; CHECK:       .LBB{{[0-9]+}}_2:
+; CHECK-NEXT:    brle.l %s0, %s1, .LBB{{[0-9]+}}_4
   %3 = icmp sgt i64 %0, %1
   br i1 %3, label %4, label %6
 
@@ -69,9 +69,9 @@ define i32 @func4(i64, i64) {
 
 define i32 @func5(i8 zeroext, i8 zeroext) {
 ; CHECK-LABEL: func5:
-; CHECK:       .LBB{{[0-9]+}}_5:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:    cmpu.w %s34, %s1, %s0
-; CHECK-NEXT:    brle.w 0, %s34, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:    brle.w 0, %s34, .LBB{{[0-9]+}}_4
   %3 = icmp ugt i8 %0, %1
   br i1 %3, label %4, label %6
 
@@ -86,9 +86,9 @@ define i32 @func5(i8 zeroext, i8 zeroext) {
 
 define i32 @func6(i16 zeroext, i16 zeroext) {
 ; CHECK-LABEL: func6:
-; CHECK:       .LBB{{[0-9]+}}_5:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:    cmpu.w %s34, %s1, %s0
-; CHECK-NEXT:    brle.w 0, %s34, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:    brle.w 0, %s34, .LBB{{[0-9]+}}_4
   %3 = icmp ugt i16 %0, %1
   br i1 %3, label %4, label %6
 
@@ -103,9 +103,9 @@ define i32 @func6(i16 zeroext, i16 zeroext) {
 
 define i32 @func7(i32, i32) {
 ; CHECK-LABEL: func7:
-; CHECK:       .LBB{{[0-9]+}}_5:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:    cmpu.w %s34, %s1, %s0
-; CHECK-NEXT:    brle.w 0, %s34, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:    brle.w 0, %s34, .LBB{{[0-9]+}}_4
   %3 = icmp ugt i32 %0, %1
   br i1 %3, label %4, label %6
 
@@ -120,8 +120,8 @@ define i32 @func7(i32, i32) {
 
 define i32 @func8(float, float) {
 ; CHECK-LABEL: func8:
-; CHECK:       .LBB{{[0-9]+}}_5:
-; CHECK-NEXT:    brlenan.s %s0, %s1, .LBB{{[0-9]+}}_1
+; CHECK:       .LBB{{[0-9]+}}_2:
+; CHECK-NEXT:    brlenan.s %s0, %s1, .LBB{{[0-9]+}}_4
   %3 = fcmp ogt float %0, %1
   br i1 %3, label %4, label %6
 
@@ -136,8 +136,8 @@ define i32 @func8(float, float) {
 
 define i32 @func9(double, double) {
 ; CHECK-LABEL: func9:
-; CHECK:       .LBB{{[0-9]+}}_5:
-; CHECK-NEXT:    brlenan.d %s0, %s1, .LBB{{[0-9]+}}_1
+; CHECK:       .LBB{{[0-9]+}}_2:
+; CHECK-NEXT:    brlenan.d %s0, %s1, .LBB{{[0-9]+}}_4
   %3 = fcmp ogt double %0, %1
   br i1 %3, label %4, label %6
 
@@ -152,10 +152,10 @@ define i32 @func9(double, double) {
 
 define i32 @func10(double, double) {
 ; CHECK-LABEL: func10:
-; CHECK:       .LBB{{[0-9]+}}_5:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:    lea.sl %s34, .LCPI{{[0-9]+}}_0@hi
 ; CHECK-NEXT:    ld %s34, .LCPI{{[0-9]+}}_0@lo(,%s34)
-; CHECK-NEXT:    brlenan.d %s0, %s34, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:    brlenan.d %s0, %s34, .LBB{{[0-9]+}}_4
   %3 = fcmp ogt double %0, 5.000000e+00
   br i1 %3, label %4, label %6
 
@@ -170,9 +170,9 @@ define i32 @func10(double, double) {
 
 define i32 @func11(fp128, fp128) {
 ; CHECK-LABEL:  func11:
-; CHECK:        .LBB{{[0-9]+}}_5:
+; CHECK:        .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:   fcmp.q %s34, %s2, %s0
-; CHECK-NEXT:   brlenan.d 0, %s34, .LBB{{[0-9]+}}_1
+; CHECK-NEXT:   brlenan.d 0, %s34, .LBB{{[0-9]+}}_4
   %3 = fcmp ogt fp128 %0, %1
   br i1 %3, label %4, label %6
 
@@ -189,7 +189,7 @@ define i32 @func11(fp128, fp128) {
 ; Function Attrs: nounwind
 define i32 @func12(i128, i128) {
 ; CHECK-LABEL: func12:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:    or %s34, 0, (0)1
 ; CHECK-NEXT:    cmps.l %s35, %s1, %s3
 ; CHECK-NEXT:    or %s36, 0, %s34
@@ -198,7 +198,7 @@ define i32 @func12(i128, i128) {
 ; CHECK-NEXT:    cmov.l.le %s34, (63)0, %s37
 ; CHECK-NEXT:    cmov.l.eq %s36, %s34, %s35
 ; CHECK-NEXT:    or %s0, 0, (0)1
-; CHECK-NEXT:    brne.w %s36, %s0, .LBB{{[0-9]+}}_2
+; CHECK-NEXT:    brne.w %s36, %s0, .LBB{{[0-9]+}}_4
   %3 = icmp sgt i128 %0, %1
   br i1 %3, label %4, label %6
 
@@ -214,7 +214,7 @@ define i32 @func12(i128, i128) {
 ; Function Attrs: nounwind
 define i32 @func13(i128, i128) {
 ; CHECK-LABEL: func13:
-; CHECK:       .LBB{{[0-9]+}}_4:
+; CHECK:       .LBB{{[0-9]+}}_2:
 ; CHECK-NEXT:    cmps.l %s34, %s1, %s3
 ; CHECK-NEXT:    or %s35, 0, (0)1
 ; CHECK-NEXT:    cmpu.l %s36, %s1, %s3
@@ -224,7 +224,7 @@ define i32 @func13(i128, i128) {
 ; CHECK-NEXT:    cmov.l.le %s35, (63)0, %s36
 ; CHECK-NEXT:    cmov.l.eq %s37, %s35, %s34
 ; CHECK-NEXT:    or %s0, 0, (0)1
-; CHECK-NEXT:    brne.w %s37, %s0, .LBB{{[0-9]+}}_2
+; CHECK-NEXT:    brne.w %s37, %s0, .LBB{{[0-9]+}}_4
   %3 = icmp ugt i128 %0, %1
   br i1 %3, label %4, label %6
 
@@ -105,9 +105,7 @@ define i64 @d2ull(double) {
 ; CHECK-NEXT:    fcmp.d %s35, %s0, %s34
 ; CHECK-NEXT:    fsub.d %s34, %s0, %s34
 ; CHECK-NEXT:    cvt.l.d.rz %s34, %s34
-; CHECK-NEXT:    lea %s36, 0
-; CHECK-NEXT:    and %s36, %s36, (32)0
-; CHECK-NEXT:    lea.sl %s36, -2147483648(%s36)
+; CHECK-NEXT:    lea.sl %s36, -2147483648
 ; CHECK-NEXT:    xor %s34, %s34, %s36
 ; CHECK-NEXT:    cvt.l.d.rz %s36, %s0
 ; CHECK-NEXT:    cmov.d.lt %s34, %s36, %s35
@@ -226,9 +224,7 @@ define i64 @q2ull(fp128) {
 ; CHECK-NEXT:    fsub.q %s34, %s0, %s34
 ; CHECK-NEXT:    cvt.d.q %s34, %s34
 ; CHECK-NEXT:    cvt.l.d.rz %s34, %s34
-; CHECK-NEXT:    lea %s35, 0
-; CHECK-NEXT:    and %s35, %s35, (32)0
-; CHECK-NEXT:    lea.sl %s35, -2147483648(%s35)
+; CHECK-NEXT:    lea.sl %s35, -2147483648
 ; CHECK-NEXT:    xor %s34, %s34, %s35
 ; CHECK-NEXT:    cvt.d.q %s35, %s0
 ; CHECK-NEXT:    cvt.l.d.rz %s35, %s35
@@ -339,9 +335,7 @@ define i64 @f2ull(float) {
 ; CHECK-NEXT:    fsub.s %s34, %s0, %s34
 ; CHECK-NEXT:    cvt.d.s %s34, %s34
 ; CHECK-NEXT:    cvt.l.d.rz %s34, %s34
-; CHECK-NEXT:    lea %s36, 0
-; CHECK-NEXT:    and %s36, %s36, (32)0
-; CHECK-NEXT:    lea.sl %s36, -2147483648(%s36)
+; CHECK-NEXT:    lea.sl %s36, -2147483648
 ; CHECK-NEXT:    xor %s34, %s34, %s36
 ; CHECK-NEXT:    cvt.d.s %s36, %s0
 ; CHECK-NEXT:    cvt.l.d.rz %s36, %s36
@@ -575,19 +569,17 @@ define float @ull2f(i64) {
 define double @ull2d(i64) {
 ; CHECK-LABEL: ull2d:
 ; CHECK:       .LBB{{[0-9]+}}_2:
-; CHECK-NEXT:    srl %s34, %s0, 32
-; CHECK-NEXT:    lea %s35, 0
-; CHECK-NEXT:    lea.sl %s36, .LCPI57_0@hi
-; CHECK-NEXT:    ld %s36, .LCPI57_0@lo(,%s36)
+; CHECK-NEXT:    lea.sl %s34, .LCPI57_0@hi
+; CHECK-NEXT:    ld %s34, .LCPI57_0@lo(,%s34)
+; CHECK-NEXT:    srl %s35, %s0, 32
+; CHECK-NEXT:    lea.sl %s36, 1160773632
+; CHECK-NEXT:    or %s35, %s35, %s36
+; CHECK-NEXT:    fsub.d %s34, %s35, %s34
+; CHECK-NEXT:    lea %s35, -1
 ; CHECK-NEXT:    and %s35, %s35, (32)0
-; CHECK-NEXT:    lea.sl %s37, 1160773632(%s35)
-; CHECK-NEXT:    or %s34, %s34, %s37
-; CHECK-NEXT:    fsub.d %s34, %s34, %s36
-; CHECK-NEXT:    lea %s36, -1
-; CHECK-NEXT:    and %s36, %s36, (32)0
-; CHECK-NEXT:    and %s36, %s0, %s36
-; CHECK-NEXT:    lea.sl %s35, 1127219200(%s35)
-; CHECK-NEXT:    or %s35, %s36, %s35
+; CHECK-NEXT:    and %s35, %s0, %s35
+; CHECK-NEXT:    lea.sl %s36, 1127219200
+; CHECK-NEXT:    or %s35, %s35, %s36
 ; CHECK-NEXT:    fadd.d %s0, %s35, %s34
 ; CHECK-NEXT:    or %s11, 0, %s9
   %2 = uitofp i64 %0 to double
@@ -597,12 +589,11 @@ define double @ull2d(i64) {
 define fp128 @ull2q(i64) {
 ; CHECK-LABEL: ull2q:
 ; CHECK:       .LBB{{[0-9]+}}_2:
-; CHECK-NEXT:    srl %s34, %s0, 61
-; CHECK-NEXT:    and %s34, 4, %s34
-; CHECK-NEXT:    lea %s35, .LCPI58_0@lo
-; CHECK-NEXT:    and %s35, %s35, (32)0
-; CHECK-NEXT:    lea.sl %s35, .LCPI58_0@hi(%s35)
-; CHECK-NEXT:    adds.l %s34, %s35, %s34
+; CHECK-NEXT:    lea %s34, .LCPI58_0@lo
+; CHECK-NEXT:    and %s34, %s34, (32)0
+; CHECK-NEXT:    srl %s35, %s0, 61
+; CHECK-NEXT:    and %s35, 4, %s35
+; CHECK-NEXT:    lea.sl %s34, .LCPI58_0@hi(%s35, %s34)
 ; CHECK-NEXT:    ldu %s34, (,%s34)
 ; CHECK-NEXT:    cvt.q.s %s34, %s34
 ; CHECK-NEXT:    cvt.d.l %s36, %s0
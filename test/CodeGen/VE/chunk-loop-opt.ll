@@ -0,0 +1,94 @@
+; RUN: opt -S -mtriple=ve-unknown-unknown -ve-chunk-loop-opt < %s | FileCheck %s
+; RUN: llc < %s -mtriple=ve-unknown-unknown -debug-pass=Structure \
+; RUN:   -ve-enable-chunk-loop-opt -o /dev/null 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=ENABLED
+; RUN: llc < %s -mtriple=ve-unknown-unknown -debug-pass=Structure \
+; RUN:   -o /dev/null 2>&1 | FileCheck %s --check-prefix=DISABLED
+
+; llc only runs the pass on request.
+; ENABLED: VE chunk loop optimization
+; DISABLED-NOT: VE chunk loop optimization
+
+; A loop processing VL-sized chunks sets VL once per chunk and gets a second
+; version for trip counts which are a multiple of 256.  That version sets VL
+; to 256 once before the loop.
+
+; CHECK-LABEL: @copy(
+; CHECK:       [[REM:%.*]] = and i64 {{.*}}, 255
+; CHECK:       [[ZERO:%.*]] = icmp eq i64 [[REM]], 0
+; CHECK:       %vl.full = and i1 {{.*}}, [[ZERO]]
+; CHECK:       br i1 %vl.full, label %{{.*}}.vl256, label
+; CHECK:       call void @llvm.ve.lvl(i32 256)
+; CHECK-NEXT:  br label %loop.vl256
+; CHECK:     loop.vl256:
+; CHECK-NOT:   call void @llvm.ve.lvl
+; CHECK:       call <256 x double> @llvm.ve.vld.vss(i64 8
+; CHECK-NOT:   call void @llvm.ve.lvl
+; CHECK:       call void @llvm.ve.vst.vss(
+; CHECK:     loop:
+; CHECK:       call void @llvm.ve.lvl(i32 %vl)
+; CHECK-NOT:   call void @llvm.ve.lvl
+; CHECK:       br i1
+define void @copy(double* %a, double* %b, i64 %n) {
+entry:
+  %guard = icmp sgt i64 %n, 0
+  br i1 %guard, label %loop, label %exit
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %rem = sub nsw i64 %n, %i
+  %short = icmp slt i64 %rem, 256
+  %len = select i1 %short, i64 %rem, i64 256
+  %vl = trunc i64 %len to i32
+  call void @llvm.ve.lvl(i32 %vl)
+  %pa = getelementptr inbounds double, double* %a, i64 %i
+  %pa8 = bitcast double* %pa to i8*
+  %v = call <256 x double> @llvm.ve.vld.vss(i64 8, i8* %pa8)
+  call void @llvm.ve.lvl(i32 %vl)
+  %pb = getelementptr inbounds double, double* %b, i64 %i
+  %pb8 = bitcast double* %pb to i8*
+  call void @llvm.ve.vst.vss(<256 x double> %v, i64 8, i8* %pb8)
+  %i.next = add nuw nsw i64 %i, 256
+  %cont = icmp slt i64 %i.next, %n
+  br i1 %cont, label %loop, label %exit
+
+exit:
+  ret void
+}
+
+; Loops which call functions are left alone.
+
+; CHECK-LABEL: @with_call(
+; CHECK-NOT:   vl.full
+; CHECK:       call void @llvm.ve.lvl(i32 %vl)
+; CHECK:       call void @foo()
+; CHECK:       call void @llvm.ve.lvl(i32 %vl)
+define void @with_call(double* %a, i64 %n) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %rem = sub nsw i64 %n, %i
+  %short = icmp slt i64 %rem, 256
+  %len = select i1 %short, i64 %rem, i64 256
+  %vl = trunc i64 %len to i32
+  call void @llvm.ve.lvl(i32 %vl)
+  %pa = getelementptr inbounds double, double* %a, i64 %i
+  %pa8 = bitcast double* %pa to i8*
+  %v = call <256 x double> @llvm.ve.vld.vss(i64 8, i8* %pa8)
+  call void @foo()
+  call void @llvm.ve.lvl(i32 %vl)
+  call void @llvm.ve.vst.vss(<256 x double> %v, i64 8, i8* %pa8)
+  %i.next = add nuw nsw i64 %i, 256
+  %cont = icmp slt i64 %i.next, %n
+  br i1 %cont, label %loop, label %exit
+
+exit:
+  ret void
+}
+
+declare void @foo()
+declare void @llvm.ve.lvl(i32)
+declare <256 x double> @llvm.ve.vld.vss(i64, i8*)
+declare void @llvm.ve.vst.vss(<256 x double>, i64, i8*)
@@ -0,0 +1,103 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown | FileCheck %s
+
+; Under fast-math flags, f128 division and square root are computed with
+; Newton-Raphson iterations on fmul.q/fadd.q instead of library calls.
+
+define fp128 @div_arcp(fp128 %a, fp128 %b) {
+; CHECK-LABEL: div_arcp:
+; CHECK-NOT:   __divtf3
+; CHECK:       fdiv.d
+; CHECK:       fmul.q
+; CHECK:       fsub.q
+; CHECK:       fadd.q
+; CHECK-NOT:   __divtf3
+; CHECK:       or %s11, 0, %s9
+  %r = fdiv arcp fp128 %a, %b
+  ret fp128 %r
+}
+
+; Zero, infinite and NaN dividends skip the refinement step, which would
+; turn an infinite quotient into NaN.
+define fp128 @div_inf_x(fp128 %b) {
+; CHECK-LABEL: div_inf_x:
+; CHECK-NOT:   fsub.q
+; CHECK:       fdiv.d
+; CHECK:       fmul.q
+; CHECK-NOT:   fsub.q
+; CHECK-NOT:   fadd.q
+; CHECK:       cmov.w.ne
+; CHECK-NOT:   fsub.q
+; CHECK:       or %s11, 0, %s9
+  %r = fdiv arcp fp128 0xL00000000000000007FFF000000000000, %b
+  ret fp128 %r
+}
+
+define fp128 @div_zero_x(fp128 %b) {
+; CHECK-LABEL: div_zero_x:
+; CHECK-NOT:   fsub.q
+; CHECK-NOT:   fadd.q
+; CHECK:       or %s11, 0, %s9
+  %r = fdiv arcp fp128 0xL00000000000000000000000000000000, %b
+  ret fp128 %r
+}
+
+define fp128 @div_nan_x(fp128 %b) {
+; CHECK-LABEL: div_nan_x:
+; CHECK-NOT:   fsub.q
+; CHECK-NOT:   fadd.q
+; CHECK:       or %s11, 0, %s9
+  %r = fdiv arcp fp128 0xL00000000000000007FFF800000000000, %b
+  ret fp128 %r
+}
+
+; Zero and infinite divisors fold to a multiplication by the exact
+; reciprocal.
+define fp128 @div_x_inf(fp128 %a) {
+; CHECK-LABEL: div_x_inf:
+; CHECK-NOT:   fdiv.d
+; CHECK:       fmul.q %s0, %s0, %s34
+; CHECK-NOT:   fmul.q
+; CHECK-NOT:   fdiv.d
+; CHECK:       or %s11, 0, %s9
+  %r = fdiv arcp fp128 %a, 0xL00000000000000007FFF000000000000
+  ret fp128 %r
+}
+
+define fp128 @div_x_zero(fp128 %a) {
+; CHECK-LABEL: div_x_zero:
+; CHECK-NOT:   fdiv.d
+; CHECK:       fmul.q %s0, %s0, %s34
+; CHECK-NOT:   fmul.q
+; CHECK-NOT:   fdiv.d
+; CHECK:       or %s11, 0, %s9
+  %r = fdiv arcp fp128 %a, 0xL00000000000000000000000000000000
+  ret fp128 %r
+}
+
+define fp128 @div(fp128 %a, fp128 %b) {
+; CHECK-LABEL: div:
+; CHECK:       __divtf3
+  %r = fdiv fp128 %a, %b
+  ret fp128 %r
+}
+
+define fp128 @sqrt_afn(fp128 %x) {
+; CHECK-LABEL: sqrt_afn:
+; CHECK-NOT:   sqrtl
+; CHECK:       fmul.d
+; CHECK:       fmul.q
+; CHECK:       fadd.q
+; CHECK-NOT:   sqrtl
+; CHECK:       or %s11, 0, %s9
+  %r = call afn fp128 @llvm.sqrt.f128(fp128 %x)
+  ret fp128 %r
+}
+
+define fp128 @sqrt(fp128 %x) {
+; CHECK-LABEL: sqrt:
+; CHECK:       sqrtl
+  %r = call fp128 @llvm.sqrt.f128(fp128 %x)
+  ret fp128 %r
+}
+
+declare fp128 @llvm.sqrt.f128(fp128)
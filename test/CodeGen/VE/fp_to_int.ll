@@ -103,9 +103,7 @@ define i64 @f2ul(float %a) {
 ; CHECK-NEXT:  fsub.s %s34, %s0, %s34
 ; CHECK-NEXT:  cvt.d.s %s34, %s34
 ; CHECK-NEXT:  cvt.l.d.rz %s34, %s34
-; CHECK-NEXT:  lea %s36, 0
-; CHECK-NEXT:  and %s36, %s36, (32)0
-; CHECK-NEXT:  lea.sl %s36, -2147483648(%s36)
+; CHECK-NEXT:  lea.sl %s36, -2147483648
 ; CHECK-NEXT:  xor %s34, %s34, %s36
 ; CHECK-NEXT:  cvt.d.s %s36, %s0
 ; CHECK-NEXT:  cvt.l.d.rz %s36, %s36
@@ -230,9 +228,7 @@ define i64 @d2ul(double %a) {
 ; CHECK-NEXT:  fcmp.d %s35, %s0, %s34
 ; CHECK-NEXT:  fsub.d %s34, %s0, %s34
 ; CHECK-NEXT:  cvt.l.d.rz %s34, %s34
-; CHECK-NEXT:  lea %s36, 0
-; CHECK-NEXT:  and %s36, %s36, (32)0
-; CHECK-NEXT:  lea.sl %s36, -2147483648(%s36)
+; CHECK-NEXT:  lea.sl %s36, -2147483648
 ; CHECK-NEXT:  xor %s34, %s34, %s36
 ; CHECK-NEXT:  cvt.l.d.rz %s36, %s0
 ; CHECK-NEXT:  cmov.d.lt %s34, %s36, %s35
@@ -368,9 +364,7 @@ define i64 @q2ul(fp128 %a) {
 ; CHECK-NEXT:  fsub.q %s34, %s0, %s34
 ; CHECK-NEXT:  cvt.d.q %s34, %s34
 ; CHECK-NEXT:  cvt.l.d.rz %s34, %s34
-; CHECK-NEXT:  lea %s35, 0
-; CHECK-NEXT:  and %s35, %s35, (32)0
-; CHECK-NEXT:  lea.sl %s35, -2147483648(%s35)
+; CHECK-NEXT:  lea.sl %s35, -2147483648
 ; CHECK-NEXT:  xor %s34, %s34, %s35
 ; CHECK-NEXT:  cvt.d.q %s35, %s0
 ; CHECK-NEXT:  cvt.l.d.rz %s35, %s35
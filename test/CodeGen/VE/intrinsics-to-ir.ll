@@ -0,0 +1,95 @@
+; RUN: opt -S -mtriple=ve-unknown-unknown -ve-intrinsics-to-ir < %s | FileCheck %s
+
+; Unmasked VE intrinsics executed with VL=256 are rewritten to generic vector
+; IR.  Other vector lengths keep the intrinsics.
+
+define void @vfaddd(<256 x double>* %p, <256 x double>* %q) {
+; CHECK-LABEL: @vfaddd(
+; CHECK:       call void @llvm.ve.lvl(i32 256)
+; CHECK-NEXT:  %r = fadd <256 x double> %a, %b
+  %a = load <256 x double>, <256 x double>* %p, align 8
+  %b = load <256 x double>, <256 x double>* %q, align 8
+  call void @llvm.ve.lvl(i32 256)
+  %r = call <256 x double> @llvm.ve.vfaddd.vvv(<256 x double> %a, <256 x double> %b)
+  store <256 x double> %r, <256 x double>* %p, align 8
+  ret void
+}
+
+define void @vfmuld_vsv(<256 x double>* %p, double %s) {
+; CHECK-LABEL: @vfmuld_vsv(
+; CHECK:       insertelement <256 x double> undef, double %s, i32 0
+; CHECK:       shufflevector
+; CHECK:       %r = fmul <256 x double>
+  %a = load <256 x double>, <256 x double>* %p, align 8
+  call void @llvm.ve.lvl(i32 256)
+  %r = call <256 x double> @llvm.ve.vfmuld.vsv(double %s, <256 x double> %a)
+  store <256 x double> %r, <256 x double>* %p, align 8
+  ret void
+}
+
+define void @vaddsl(<256 x double>* %p, <256 x double>* %q) {
+; CHECK-LABEL: @vaddsl(
+; CHECK:       bitcast <256 x double> %a to <256 x i64>
+; CHECK:       bitcast <256 x double> %b to <256 x i64>
+; CHECK:       add <256 x i64>
+; CHECK:       %r = bitcast <256 x i64> {{.*}} to <256 x double>
+  %a = load <256 x double>, <256 x double>* %p, align 8
+  %b = load <256 x double>, <256 x double>* %q, align 8
+  call void @llvm.ve.lvl(i32 256)
+  %r = call <256 x double> @llvm.ve.vaddsl.vvv(<256 x double> %a, <256 x double> %b)
+  store <256 x double> %r, <256 x double>* %p, align 8
+  ret void
+}
+
+define void @vbrd(<256 x double>* %p, double %s) {
+; CHECK-LABEL: @vbrd(
+; CHECK-NOT:   @llvm.ve.vbrd
+; CHECK:       ret void
+  call void @llvm.ve.lvl(i32 256)
+  %r = call <256 x double> @llvm.ve.vbrd.vs.f64(double %s)
+  store <256 x double> %r, <256 x double>* %p, align 8
+  ret void
+}
+
+define void @unknown_vl(<256 x double>* %p, <256 x double>* %q, i32 %n) {
+; CHECK-LABEL: @unknown_vl(
+; CHECK:       call <256 x double> @llvm.ve.vfaddd.vvv
+  %a = load <256 x double>, <256 x double>* %p, align 8
+  %b = load <256 x double>, <256 x double>* %q, align 8
+  call void @llvm.ve.lvl(i32 %n)
+  %r = call <256 x double> @llvm.ve.vfaddd.vvv(<256 x double> %a, <256 x double> %b)
+  store <256 x double> %r, <256 x double>* %p, align 8
+  ret void
+}
+
+define void @clobbered_vl(<256 x double>* %p, <256 x double>* %q) {
+; CHECK-LABEL: @clobbered_vl(
+; CHECK:       call void @f()
+; CHECK:       call <256 x double> @llvm.ve.vfaddd.vvv
+  %a = load <256 x double>, <256 x double>* %p, align 8
+  %b = load <256 x double>, <256 x double>* %q, align 8
+  call void @llvm.ve.lvl(i32 256)
+  call void @f()
+  %r = call <256 x double> @llvm.ve.vfaddd.vvv(<256 x double> %a, <256 x double> %b)
+  store <256 x double> %r, <256 x double>* %p, align 8
+  ret void
+}
+
+define void @masked(<256 x double>* %p, <256 x double>* %q, <4 x i64> %m) {
+; CHECK-LABEL: @masked(
+; CHECK:       call <256 x double> @llvm.ve.vfaddd.vvvmv
+  %a = load <256 x double>, <256 x double>* %p, align 8
+  %b = load <256 x double>, <256 x double>* %q, align 8
+  call void @llvm.ve.lvl(i32 256)
+  %r = call <256 x double> @llvm.ve.vfaddd.vvvmv(<256 x double> %a, <256 x double> %b, <4 x i64> %m, <256 x double> %a)
+  store <256 x double> %r, <256 x double>* %p, align 8
+  ret void
+}
+
+declare void @f()
+declare void @llvm.ve.lvl(i32)
+declare <256 x double> @llvm.ve.vfaddd.vvv(<256 x double>, <256 x double>)
+declare <256 x double> @llvm.ve.vfaddd.vvvmv(<256 x double>, <256 x double>, <4 x i64>, <256 x double>)
+declare <256 x double> @llvm.ve.vfmuld.vsv(double, <256 x double>)
+declare <256 x double> @llvm.ve.vaddsl.vvv(<256 x double>, <256 x double>)
+declare <256 x double> @llvm.ve.vbrd.vs.f64(double)
@@ -0,0 +1,56 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown | FileCheck %s
+; RUN: llc < %s -mtriple=ve-unknown-unknown -relocation-model=pic \
+; RUN:   | FileCheck %s --check-prefix=PIC
+
+; Dense switches are lowered to a jump table and an indirect branch.
+
+define signext i32 @dispatch(i32 signext %op, i32 signext %x) {
+; CHECK-LABEL: dispatch:
+; CHECK:       lea %s{{[0-9]+}}, .LJTI0_0@lo
+; CHECK-NEXT:  and %s{{[0-9]+}}, %s{{[0-9]+}}, (32)0
+; CHECK:       lea.sl %s{{[0-9]+}}, .LJTI0_0@hi(%s{{[0-9]+}}, %s{{[0-9]+}})
+; CHECK-NEXT:  ld %s{{[0-9]+}}, (,%s{{[0-9]+}})
+; CHECK:       b.l (,%s{{[0-9]+}})
+; CHECK:       .LJTI0_0:
+; CHECK-NEXT:  .8byte .LBB0_{{[0-9]+}}
+;
+; PIC-LABEL:   dispatch:
+; PIC:         lea %s{{[0-9]+}}, .LJTI0_0@gotoff_lo
+; PIC:         lea.sl %s{{[0-9]+}}, .LJTI0_0@gotoff_hi(%s15, %s{{[0-9]+}})
+; PIC:         ldl.zx %s{{[0-9]+}}, {{.*}}(,%s{{[0-9]+}})
+; PIC:         lea %s{{[0-9]+}}, dispatch@gotoff_lo
+; PIC:         lea.sl %s{{[0-9]+}}, dispatch@gotoff_hi(%s15, %s{{[0-9]+}})
+; PIC:         b.l %s{{[0-9]+}}(,%s{{[0-9]+}})
+; PIC:         .LJTI0_0:
+; PIC-NEXT:    .4byte .LBB0_{{[0-9]+}}-dispatch
+entry:
+  switch i32 %op, label %default [
+    i32 0, label %bb0
+    i32 1, label %bb1
+    i32 2, label %bb2
+    i32 3, label %bb3
+    i32 4, label %bb4
+    i32 5, label %bb5
+  ]
+
+bb0:
+  %r0 = add i32 %x, 3
+  ret i32 %r0
+bb1:
+  %r1 = sub i32 %x, 7
+  ret i32 %r1
+bb2:
+  %r2 = mul i32 %x, 11
+  ret i32 %r2
+bb3:
+  %r3 = xor i32 %x, 13
+  ret i32 %r3
+bb4:
+  %r4 = shl i32 %x, 5
+  ret i32 %r4
+bb5:
+  %r5 = ashr i32 %x, 3
+  ret i32 %r5
+default:
+  ret i32 0
+}
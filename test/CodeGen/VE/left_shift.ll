@@ -46,12 +46,9 @@ define i64 @func4(i64, i64) {
 ; Function Attrs: norecurse nounwind readnone
 define i128 @func5(i128, i128) {
 ; CHECK-LABEL: func5:
-; CHECK:       .LBB{{[0-9]+}}_2:
-; CHECK-NEXT:    adds.w.sx %s2, %s2, (0)1
-; CHECK-NEXT:    lea %s34, __ashlti3@lo
-; CHECK-NEXT:    and %s34, %s34, (32)0
-; CHECK-NEXT:    lea.sl %s12, __ashlti3@hi(%s34)
-; CHECK-NEXT:    bsic %lr, (,%s12)
+; CHECK-NOT:     __ashlti3
+; CHECK:         sld %s{{[0-9]+}}, %s{{[0-9]+}}, %s{{[0-9]+}}
+; CHECK:         or %s11, 0, %s9
   %3 = shl i128 %0, %1
   ret i128 %3
 }
@@ -100,12 +97,9 @@ define i64 @func9(i64, i64) {
 ; Function Attrs: norecurse nounwind readnone
 define i128 @func10(i128, i128) {
 ; CHECK-LABEL: func10:
-; CHECK:       .LBB{{[0-9]+}}_2:
-; CHECK-NEXT:    adds.w.sx %s2, %s2, (0)1
-; CHECK-NEXT:    lea %s34, __ashlti3@lo
-; CHECK-NEXT:    and %s34, %s34, (32)0
-; CHECK-NEXT:    lea.sl %s12, __ashlti3@hi(%s34)
-; CHECK-NEXT:    bsic %lr, (,%s12)
+; CHECK-NOT:     __ashlti3
+; CHECK:         sld %s{{[0-9]+}}, %s{{[0-9]+}}, %s{{[0-9]+}}
+; CHECK:         or %s11, 0, %s9
   %3 = shl i128 %0, %1
   ret i128 %3
 }
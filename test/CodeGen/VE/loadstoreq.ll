@@ -17,8 +17,8 @@ define fp128 @loadq(fp128* nocapture readonly) {
 define void @storeq(fp128* nocapture, fp128) {
 ; CHECK-LABEL: storeq:
 ; CHECK:       .LBB{{[0-9]+}}_2:
-; CHECK-NEXT:    st %s2, 8(,%s0)
 ; CHECK-NEXT:    st %s3, (,%s0)
+; CHECK-NEXT:    st %s2, 8(,%s0)
 ; CHECK-NEXT:    or %s11, 0, %s9
   store fp128 %1, fp128* %0, align 16, !tbaa !2
   ret void
@@ -11,8 +11,7 @@ define void @test(i32) {
 ; CHECK-NEXT:    sll %s35, %s35, 3
 ; CHECK-NEXT:    lea %s35, 15(%s35)
 ; CHECK-NEXT:    lea %s36, -16
-; CHECK-NEXT:    and %s36, %s36, (32)0
-; CHECK-NEXT:    lea.sl %s36, 15(%s36)
+; CHECK-NEXT:    lea.sl %s36, 16(%s36)
 ; CHECK-NEXT:    and %s0, %s35, %s36
 ; CHECK-NEXT:    adds.l %s11, -64, %s11
 ; CHECK-NEXT:    lea %s35, __llvm_grow_stack@lo
@@ -0,0 +1,56 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown -enable-machine-outliner \
+; RUN:   -verify-machineinstrs | FileCheck %s
+; RUN: llc < %s -mtriple=ve-unknown-unknown -enable-machine-outliner \
+; RUN:   -relocation-model=pic | FileCheck %s --check-prefix=PIC
+
+; Identical sequences are outlined into a function called through %s12.
+
+define void @f1(i64* %p) {
+; CHECK-LABEL: f1:
+; CHECK:       lea %s12, OUTLINED_FUNCTION_0@lo
+; CHECK-NEXT:  and %s12, %s12, (32)0
+; CHECK-NEXT:  lea.sl %s12, OUTLINED_FUNCTION_0@hi(%s12)
+; CHECK-NEXT:  bsic %lr, (,%s12)
+; CHECK:       bsic %lr, (,%s12)
+; PIC-LABEL:   f1:
+; PIC:         lea %s12, OUTLINED_FUNCTION_0@plt_lo(-24)
+; PIC:         bsic %lr, (,%s12)
+  %p1 = getelementptr i64, i64* %p, i64 1
+  %p2 = getelementptr i64, i64* %p, i64 2
+  %p3 = getelementptr i64, i64* %p, i64 3
+  %p4 = getelementptr i64, i64* %p, i64 4
+  %p5 = getelementptr i64, i64* %p, i64 5
+  store volatile i64 11, i64* %p
+  store volatile i64 12, i64* %p1
+  store volatile i64 13, i64* %p2
+  store volatile i64 14, i64* %p3
+  store volatile i64 15, i64* %p4
+  store volatile i64 16, i64* %p5
+  call void @ext()
+  ret void
+}
+
+define void @f2(i64* %p) {
+; CHECK-LABEL: f2:
+; CHECK:       lea.sl %s12, OUTLINED_FUNCTION_0@hi(%s12)
+; CHECK-NEXT:  bsic %lr, (,%s12)
+  %p1 = getelementptr i64, i64* %p, i64 1
+  %p2 = getelementptr i64, i64* %p, i64 2
+  %p3 = getelementptr i64, i64* %p, i64 3
+  %p4 = getelementptr i64, i64* %p, i64 4
+  %p5 = getelementptr i64, i64* %p, i64 5
+  store volatile i64 11, i64* %p
+  store volatile i64 12, i64* %p1
+  store volatile i64 13, i64* %p2
+  store volatile i64 14, i64* %p3
+  store volatile i64 15, i64* %p4
+  store volatile i64 16, i64* %p5
+  call void @ext()
+  ret void
+}
+
+; CHECK-LABEL: OUTLINED_FUNCTION_0:
+; CHECK:       st
+; CHECK:       b.l (,%lr)
+
+declare void @ext()
@@ -0,0 +1,115 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown | FileCheck %s
+; RUN: llc < %s -mtriple=ve-unknown-unknown -stop-after=expand-isel-pseudos \
+; RUN:   | FileCheck %s --check-prefix=MIR
+
+; Constant sized memcpy/memmove/memset of 8-byte aligned buffers are
+; lowered to strip-mined vld/vst.
+
+define void @memcpy_4096(i8* align 8 %dst, i8* align 8 %src) {
+; CHECK-LABEL: memcpy_4096:
+; CHECK-NOT:   memcpy@
+; CHECK:       lvl
+; CHECK:       vld %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK:       vst %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK-NOT:   lvl
+; CHECK:       vld %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK:       vst %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK-NOT:   memcpy@
+; CHECK:       or %s11, 0, %s9
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* align 8 %dst, i8* align 8 %src, i64 4096, i1 false)
+  ret void
+}
+
+; The strips carry memory operands, so they are ordered against other memory
+; accesses like the scalar tail is.
+; MIR-LABEL: name: memcpy_1004
+; MIR:       VLDir 8, %{{[0-9]+}}, %{{[0-9]+}} :: (load 1000 from %ir.src, align 8)
+; MIR:       VSTir {{.*}} :: (store 1000 into %ir.dst, align 8)
+; MIR:       LDLri {{.*}} :: (load 4 from %ir.src + 1000, align 8)
+define void @memcpy_1004(i8* align 8 %dst, i8* align 8 %src) {
+; CHECK-LABEL: memcpy_1004:
+; CHECK-NOT:   memcpy@
+; CHECK:       lea %s{{[0-9]+}}, 125
+; CHECK:       lvl
+; CHECK:       vld %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK:       vst %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK:       ldl.{{sx|zx}} %s{{[0-9]+}}, 1000(,%s1)
+; CHECK:       stl %s{{[0-9]+}}, 1000(,%s0)
+; CHECK-NOT:   memcpy@
+; CHECK:       or %s11, 0, %s9
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* align 8 %dst, i8* align 8 %src, i64 1004, i1 false)
+  ret void
+}
+
+define void @memmove_4096(i8* align 8 %dst, i8* align 8 %src) {
+; CHECK-LABEL: memmove_4096:
+; CHECK-NOT:   memmove@
+; CHECK:       vld %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK:       vld %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK:       vst %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK:       vst %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK-NOT:   memmove@
+; CHECK:       or %s11, 0, %s9
+  call void @llvm.memmove.p0i8.p0i8.i64(i8* align 8 %dst, i8* align 8 %src, i64 4096, i1 false)
+  ret void
+}
+
+define void @memset_2048(i8* align 8 %dst) {
+; CHECK-LABEL: memset_2048:
+; CHECK-NOT:   memset@
+; CHECK:       vbrd %v{{[0-9]+}},%s{{[0-9]+}}
+; CHECK:       vst %v{{[0-9]+}},8,%s0
+; CHECK-NOT:   memset@
+; CHECK:       or %s11, 0, %s9
+  call void @llvm.memset.p0i8.i64(i8* align 8 %dst, i8 0, i64 2048, i1 false)
+  ret void
+}
+
+define void @memset_var_byte(i8* align 8 %dst, i8 %c) {
+; CHECK-LABEL: memset_var_byte:
+; CHECK-NOT:   memset@
+; CHECK:       vbrd %v{{[0-9]+}},%s{{[0-9]+}}
+; CHECK:       vst %v{{[0-9]+}},8,%s0
+; CHECK-NOT:   memset@
+; CHECK:       or %s11, 0, %s9
+  call void @llvm.memset.p0i8.i64(i8* align 8 %dst, i8 %c, i64 1024, i1 false)
+  ret void
+}
+
+; MIR-LABEL: name: memcpy_volatile
+; MIR:       VLDir {{.*}} :: (volatile load 2048 from %ir.src, align 8)
+; MIR:       VSTir {{.*}} :: (volatile store 2048 into %ir.dst, align 8)
+; MIR:       VLDir {{.*}} :: (volatile load 2048 from %ir.src + 2048, align 8)
+; MIR:       VSTir {{.*}} :: (volatile store 2048 into %ir.dst + 2048, align 8)
+define void @memcpy_volatile(i8* align 8 %dst, i8* align 8 %src) {
+; CHECK-LABEL: memcpy_volatile:
+; CHECK-NOT:   memcpy@
+; CHECK:       vld
+; CHECK:       vst
+; CHECK:       vld
+; CHECK:       vst
+; CHECK-NOT:   memcpy@
+; CHECK:       or %s11, 0, %s9
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* align 8 %dst, i8* align 8 %src, i64 4096, i1 true)
+  ret void
+}
+
+; Under-aligned and variable sized operations still call the library.
+
+define void @memcpy_align4(i8* align 4 %dst, i8* align 4 %src) {
+; CHECK-LABEL: memcpy_align4:
+; CHECK:       lea.sl %s12, memcpy@hi
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* align 4 %dst, i8* align 4 %src, i64 4096, i1 false)
+  ret void
+}
+
+define void @memcpy_var(i8* align 8 %dst, i8* align 8 %src, i64 %n) {
+; CHECK-LABEL: memcpy_var:
+; CHECK:       lea.sl %s12, memcpy@hi
+  call void @llvm.memcpy.p0i8.p0i8.i64(i8* align 8 %dst, i8* align 8 %src, i64 %n, i1 false)
+  ret void
+}
+
+declare void @llvm.memcpy.p0i8.p0i8.i64(i8* nocapture writeonly, i8* nocapture readonly, i64, i1)
+declare void @llvm.memmove.p0i8.p0i8.i64(i8* nocapture, i8* nocapture readonly, i64, i1)
+declare void @llvm.memset.p0i8.i64(i8* nocapture writeonly, i8, i64, i1)
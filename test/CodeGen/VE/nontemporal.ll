@@ -0,0 +1,32 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown | FileCheck %s
+
+; Nontemporal vector loads and stores use the .nc forms of vld/vst.
+
+define void @copy_v256f64(<256 x double>* %p, <256 x double>* %q) {
+; CHECK-LABEL: copy_v256f64:
+; CHECK:       vld.nc %v{{[0-9]+}},8,%s{{[0-9]+}}
+; CHECK:       vst.nc %v{{[0-9]+}},8,%s{{[0-9]+}}
+  %v = load <256 x double>, <256 x double>* %p, align 8, !nontemporal !0
+  store <256 x double> %v, <256 x double>* %q, align 8, !nontemporal !0
+  ret void
+}
+
+define void @copy_v256i32(<256 x i32>* %p, <256 x i32>* %q) {
+; CHECK-LABEL: copy_v256i32:
+; CHECK:       vldl.sx.nc %v{{[0-9]+}},4,%s{{[0-9]+}}
+; CHECK:       vstl.nc %v{{[0-9]+}},4,%s{{[0-9]+}}
+  %v = load <256 x i32>, <256 x i32>* %p, align 4, !nontemporal !0
+  store <256 x i32> %v, <256 x i32>* %q, align 4, !nontemporal !0
+  ret void
+}
+
+define void @store_v256f32(<256 x float>* %p, <256 x float>* %q) {
+; CHECK-LABEL: store_v256f32:
+; CHECK:       vldu %v{{[0-9]+}},4,%s{{[0-9]+}}
+; CHECK:       vstu.nc %v{{[0-9]+}},4,%s{{[0-9]+}}
+  %v = load <256 x float>, <256 x float>* %p, align 4
+  store <256 x float> %v, <256 x float>* %q, align 4, !nontemporal !0
+  ret void
+}
+
+!0 = !{i32 1}
@@ -13,18 +13,15 @@ define i32 @func() {
 ; CHECK-NEXT:  lea.sl %s15, _GLOBAL_OFFSET_TABLE_@pc_hi(%s16, %s15)
 ; CHECK-NEXT:  lea %s34, dst@got_lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
-; CHECK-NEXT:  lea.sl %s34, dst@got_hi(%s34)
-; CHECK-NEXT:  adds.l %s34, %s15, %s34
+; CHECK-NEXT:  lea.sl %s34, dst@got_hi(%s15, %s34)
 ; CHECK-NEXT:  ld %s34, (,%s34)
 ; CHECK-NEXT:  lea %s35, ptr@got_lo
 ; CHECK-NEXT:  and %s35, %s35, (32)0
-; CHECK-NEXT:  lea.sl %s35, ptr@got_hi(%s35)
 ; CHECK-NEXT:  lea %s36, src@got_lo
 ; CHECK-NEXT:  and %s36, %s36, (32)0
-; CHECK-NEXT:  lea.sl %s36, src@got_hi(%s36)
-; CHECK-NEXT:  adds.l %s36, %s15, %s36
+; CHECK-NEXT:  lea.sl %s36, src@got_hi(%s15, %s36)
 ; CHECK-NEXT:  ld %s36, (,%s36)
-; CHECK-NEXT:  adds.l %s35, %s15, %s35
+; CHECK-NEXT:  lea.sl %s35, ptr@got_hi(%s15, %s35)
 ; CHECK-NEXT:  ld %s35, (,%s35)
 ; CHECK-NEXT:  ldl.sx %s36, (,%s36)
 ; CHECK-NEXT:  st %s34, (,%s35)
@@ -13,16 +13,14 @@ define void @func() {
 ; CHECK-NEXT:  lea.sl %s15, _GLOBAL_OFFSET_TABLE_@pc_hi(%s16, %s15)
 ; CHECK-NEXT:  lea %s34, src@gotoff_lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
-; CHECK-NEXT:  lea.sl %s34, src@gotoff_hi(%s34)
-; CHECK-NEXT:  adds.l %s34, %s15, %s34
+; CHECK-NEXT:  lea.sl %s34, src@gotoff_hi(%s15, %s34)
 ; CHECK-NEXT:  ld1b.zx %s34, (,%s34)
 ; CHECK-NEXT:  or %s35, 0, (0)1
 ; CHECK-NEXT:  lea %s36, 100
 ; CHECK-NEXT:  cmov.w.ne %s35, %s36, %s34
 ; CHECK-NEXT:  lea %s34, dst@gotoff_lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
-; CHECK-NEXT:  lea.sl %s34, dst@gotoff_hi(%s34)
-; CHECK-NEXT:  adds.l %s34, %s15, %s34
+; CHECK-NEXT:  lea.sl %s34, dst@gotoff_hi(%s15, %s34)
 ; CHECK-NEXT:  stl %s35, (,%s34)
 
   %1 = load i1, i1* @src, align 4
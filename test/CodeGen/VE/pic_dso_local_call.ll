@@ -0,0 +1,23 @@
+; RUN: llc -relocation-model=pic < %s -mtriple=ve-unknown-unknown | FileCheck %s
+
+; dso_local callees are called through their GOT-relative address instead of
+; the PLT.
+
+define void @func() {
+; CHECK-LABEL: func:
+; CHECK:       lea [[R:%s[0-9]+]], local@gotoff_lo
+; CHECK-NEXT:  and [[R]], [[R]], (32)0
+; CHECK-NEXT:  lea.sl %s12, local@gotoff_hi(%s15, [[R]])
+; CHECK-NEXT:  bsic %lr, (,%s12)
+; CHECK:       lea %s12, preemptible@plt_lo(-24)
+; CHECK-NEXT:  and %s12, %s12, (32)0
+; CHECK-NEXT:  sic %s16
+; CHECK-NEXT:  lea.sl %s12, preemptible@plt_hi(%s16, %s12)
+; CHECK-NEXT:  bsic %lr, (,%s12)
+  call void @local()
+  call void @preemptible()
+  ret void
+}
+
+declare dso_local void @local()
+declare void @preemptible()
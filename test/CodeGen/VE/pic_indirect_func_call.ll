@@ -11,13 +11,11 @@ define void @func() {
 ; CHECK-NEXT:  lea.sl %s15, _GLOBAL_OFFSET_TABLE_@pc_hi(%s16, %s15)
 ; CHECK-NEXT:  lea %s34, function@got_lo
 ; CHECK-NEXT:  and %s34, %s34, (32)0
-; CHECK-NEXT:  lea.sl %s34, function@got_hi(%s34)
-; CHECK-NEXT:  adds.l %s34, %s15, %s34
+; CHECK-NEXT:  lea.sl %s34, function@got_hi(%s15, %s34)
 ; CHECK-NEXT:  ld %s34, (,%s34)
 ; CHECK-NEXT:  lea %s35, ptr@got_lo
 ; CHECK-NEXT:  and %s35, %s35, (32)0
-; CHECK-NEXT:  lea.sl %s35, ptr@got_hi(%s35)
-; CHECK-NEXT:  adds.l %s35, %s15, %s35
+; CHECK-NEXT:  lea.sl %s35, ptr@got_hi(%s15, %s35)
 ; CHECK-NEXT:  ld %s35, (,%s35)
 ; CHECK-NEXT:  st %s34, (,%s35)
 ; CHECK-NEXT:  or %s12, 0, %s34
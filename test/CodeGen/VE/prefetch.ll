@@ -0,0 +1,37 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown | FileCheck %s
+; RUN: llc < %s -mtriple=ve-unknown-unknown -ve-prefetch-lines=1 \
+; RUN:   | FileCheck %s --check-prefix=SINGLE
+
+; A data prefetch fetches several consecutive cache lines with pfchv unless
+; only a single line is requested.
+
+define void @prefetch_read(i8* %p) {
+; CHECK-LABEL: prefetch_read:
+; CHECK:       lea %s{{[0-9]+}}, 128
+; CHECK:       lvl
+; CHECK:       pfchv
+; SINGLE-LABEL: prefetch_read:
+; SINGLE:       pfch (,%s0)
+; SINGLE-NOT:   pfchv
+  call void @llvm.prefetch(i8* %p, i32 0, i32 3, i32 1)
+  ret void
+}
+
+define void @prefetch_write(i8* %p) {
+; CHECK-LABEL: prefetch_write:
+; CHECK:       pfchv
+; SINGLE-LABEL: prefetch_write:
+; SINGLE:       pfch (,%s0)
+  call void @llvm.prefetch(i8* %p, i32 1, i32 3, i32 1)
+  ret void
+}
+
+define void @prefetch_instruction(i8* %p) {
+; CHECK-LABEL: prefetch_instruction:
+; CHECK-NOT:   pfch
+; CHECK:       or %s11, 0, %s9
+  call void @llvm.prefetch(i8* %p, i32 0, i32 3, i32 0)
+  ret void
+}
+
+declare void @llvm.prefetch(i8*, i32, i32, i32)
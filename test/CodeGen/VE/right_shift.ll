@@ -41,12 +41,9 @@ define i64 @func4(i64, i64) {
 
 define i128 @func6(i128, i128) {
 ; CHECK-LABEL: func6:
-; CHECK:       .LBB{{[0-9]+}}_2:
-; CHECK-NEXT:    adds.w.sx %s2, %s2, (0)1
-; CHECK-NEXT:    lea %s34, __ashrti3@lo
-; CHECK-NEXT:    and %s34, %s34, (32)0
-; CHECK-NEXT:    lea.sl %s12, __ashrti3@hi(%s34)
-; CHECK-NEXT:    bsic %lr, (,%s12)
+; CHECK-NOT:     __ashrti3
+; CHECK:         srd %s{{[0-9]+}}, %s{{[0-9]+}}, %s{{[0-9]+}}
+; CHECK:         or %s11, 0, %s9
   %3 = ashr i128 %0, %1
   ret i128 %3
 }
@@ -101,12 +98,9 @@ define i64 @func10(i64, i64) {
 
 define i128 @func11(i128, i128) {
 ; CHECK-LABEL: func11:
-; CHECK:       .LBB{{[0-9]+}}_2:
-; CHECK-NEXT:    adds.w.sx %s2, %s2, (0)1
-; CHECK-NEXT:    lea %s34, __lshrti3@lo
-; CHECK-NEXT:    and %s34, %s34, (32)0
-; CHECK-NEXT:    lea.sl %s12, __lshrti3@hi(%s34)
-; CHECK-NEXT:    bsic %lr, (,%s12)
+; CHECK-NOT:     __lshrti3
+; CHECK:         srd %s{{[0-9]+}}, %s{{[0-9]+}}, %s{{[0-9]+}}
+; CHECK:         or %s11, 0, %s9
   %3 = lshr i128 %0, %1
   ret i128 %3
 }
@@ -3,11 +3,8 @@
 define i64 @func1(i64, i32) {
 ; CHECK-LABEL: func1:
 ; CHECK:       .LBB{{[0-9]+}}_2:
-; CHECK-NEXT:    sll %s34, %s0, %s1
-; CHECK-NEXT:    lea %s35, 64
-; CHECK-NEXT:    subs.w.sx %s35, %s35, %s1
-; CHECK-NEXT:    srl %s35, %s0, %s35
-; CHECK-NEXT:    or %s0, %s35, %s34
+; CHECK-NEXT:    and [[AMT:%s[0-9]+]], 63, %s1
+; CHECK-NEXT:    sld %s0, %s0, [[AMT]]
 ; CHECK-NEXT:    or %s11, 0, %s9
   %3 = zext i32 %1 to i64
   %4 = shl i64 %0, %3
@@ -35,3 +32,26 @@ define i32 @func2(i32, i32) {
   ret i32 %6
 }
 
+
+define i64 @func3(i64) {
+; CHECK-LABEL: func3:
+; CHECK:       .LBB{{[0-9]+}}_2:
+; CHECK-NEXT:    sld %s0, %s0, 5
+; CHECK-NEXT:    or %s11, 0, %s9
+  %2 = shl i64 %0, 5
+  %3 = lshr i64 %0, 59
+  %4 = or i64 %3, %2
+  ret i64 %4
+}
+
+define i64 @func4(i64, i64) {
+; CHECK-LABEL: func4:
+; CHECK:       .LBB{{[0-9]+}}_2:
+; CHECK-NEXT:    and [[AMT:%s[0-9]+]], 63, %s1
+; CHECK-NEXT:    sld %s0, %s0, [[AMT]]
+; CHECK-NEXT:    or %s11, 0, %s9
+  %3 = tail call i64 @llvm.fshl.i64(i64 %0, i64 %0, i64 %1)
+  ret i64 %3
+}
+
+declare i64 @llvm.fshl.i64(i64, i64, i64)
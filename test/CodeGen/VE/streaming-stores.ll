@@ -0,0 +1,71 @@
+; RUN: opt -S -mtriple=ve-unknown-unknown -ve-streaming-stores < %s | FileCheck %s
+
+; Consecutive vector stores writing at least 16MB in a loop which doesn't
+; read the stored array are marked nontemporal.
+
+; 8192 iterations of 2048 bytes write 16MB.
+define void @triad(<256 x double>* noalias %a, <256 x double>* noalias %b,
+                   <256 x double>* noalias %c) {
+; CHECK-LABEL: @triad(
+; CHECK:       store <256 x double> %{{.*}}, align 8, !nontemporal !0
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pb = getelementptr inbounds <256 x double>, <256 x double>* %b, i64 %i
+  %pc = getelementptr inbounds <256 x double>, <256 x double>* %c, i64 %i
+  %vb = load <256 x double>, <256 x double>* %pb, align 8
+  %vc = load <256 x double>, <256 x double>* %pc, align 8
+  %s = fadd <256 x double> %vb, %vc
+  %pa = getelementptr inbounds <256 x double>, <256 x double>* %a, i64 %i
+  store <256 x double> %s, <256 x double>* %pa, align 8
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, 8192
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; Stores to an array read in the same loop stay cached.
+define void @update(<256 x double>* %a) {
+; CHECK-LABEL: @update(
+; CHECK:       store <256 x double> %{{.*}}, align 8{{$}}
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pa = getelementptr inbounds <256 x double>, <256 x double>* %a, i64 %i
+  %v = load <256 x double>, <256 x double>* %pa, align 8
+  %s = fadd <256 x double> %v, %v
+  store <256 x double> %s, <256 x double>* %pa, align 8
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, 8192
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; Small loops stay cached.
+define void @small(<256 x double>* %a, <256 x double> %v) {
+; CHECK-LABEL: @small(
+; CHECK:       store <256 x double> %v, {{.*}}, align 8{{$}}
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pa = getelementptr inbounds <256 x double>, <256 x double>* %a, i64 %i
+  store <256 x double> %v, <256 x double>* %pa, align 8
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, 16
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; CHECK: !0 = !{i32 1}
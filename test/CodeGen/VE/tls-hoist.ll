@@ -0,0 +1,51 @@
+; RUN: llc -mtriple=ve-unknown-unknown < %s | FileCheck %s
+
+; The address of a thread-local variable is computed once per function, and
+; outside of loops, instead of calling __tls_get_addr for each reference.
+
+@x = external thread_local global [1024 x i64], align 8
+
+define void @fill(i64 %n) {
+; CHECK-LABEL: fill:
+; CHECK:       lea %s0, x@tls_gd_lo(-24)
+; CHECK:       __tls_get_addr@plt_lo
+; CHECK-NOT:   __tls_get_addr@plt_lo
+; CHECK:       .Lfunc_end0:
+entry:
+  %cmp = icmp sgt i64 %n, 0
+  br i1 %cmp, label %preheader, label %exit
+
+preheader:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %preheader ], [ %i.next, %loop ]
+  %v = call i64 @next(i64 %i)
+  %p = getelementptr inbounds [1024 x i64], [1024 x i64]* @x, i64 0, i64 %i
+  store i64 %v, i64* %p, align 8
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp slt i64 %i.next, %n
+  br i1 %done, label %loop, label %exit
+
+exit:
+  ret void
+}
+
+define i64 @select(i1 %c) {
+; CHECK-LABEL: select:
+; CHECK:       __tls_get_addr@plt_lo
+; CHECK-NOT:   __tls_get_addr@plt_lo
+; CHECK:       .Lfunc_end1:
+entry:
+  br i1 %c, label %then, label %else
+
+then:
+  %a = load i64, i64* getelementptr inbounds ([1024 x i64], [1024 x i64]* @x, i64 0, i64 1), align 8
+  ret i64 %a
+
+else:
+  %b = load i64, i64* getelementptr inbounds ([1024 x i64], [1024 x i64]* @x, i64 0, i64 2), align 8
+  ret i64 %b
+}
+
+declare i64 @next(i64)
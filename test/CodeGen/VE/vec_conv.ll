@@ -0,0 +1,81 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown | FileCheck %s
+
+; Conversions between unsigned integer and floating-point vectors, and
+; extending loads of i8 vectors, are done in vector registers.
+
+define void @fptoui_v256f64_v256i64(<256 x double>* %p, <256 x i64>* %q) {
+; CHECK-LABEL: fptoui_v256f64_v256i64:
+; CHECK:       vfcmp.d
+; CHECK:       vfmk.d.lt
+; CHECK:       vfsub.d
+; CHECK:       vcvt.l.d.rz
+; CHECK:       vxor
+; CHECK:       vmrg
+; CHECK:       vst
+  %a = load <256 x double>, <256 x double>* %p, align 8
+  %b = fptoui <256 x double> %a to <256 x i64>
+  store <256 x i64> %b, <256 x i64>* %q, align 8
+  ret void
+}
+
+define void @fptoui_v256f64_v256i32(<256 x double>* %p, <256 x i32>* %q) {
+; CHECK-LABEL: fptoui_v256f64_v256i32:
+; CHECK:       vcvt.l.d.rz
+; CHECK-NOT:   vmrg
+; CHECK:       vstl
+  %a = load <256 x double>, <256 x double>* %p, align 8
+  %b = fptoui <256 x double> %a to <256 x i32>
+  store <256 x i32> %b, <256 x i32>* %q, align 4
+  ret void
+}
+
+define void @uitofp_v256i64_v256f64(<256 x i64>* %p, <256 x double>* %q) {
+; CHECK-LABEL: uitofp_v256i64_v256f64:
+; CHECK-DAG:   vsrl
+; CHECK-DAG:   vand
+; CHECK:       vfmul.d
+; CHECK:       vfadd.d
+; CHECK:       vst
+  %a = load <256 x i64>, <256 x i64>* %p, align 8
+  %b = uitofp <256 x i64> %a to <256 x double>
+  store <256 x double> %b, <256 x double>* %q, align 8
+  ret void
+}
+
+define void @uitofp_v256i32_v256f32(<256 x i32>* %p, <256 x float>* %q) {
+; CHECK-LABEL: uitofp_v256i32_v256f32:
+; CHECK:       vadds.w.zx
+; CHECK:       vcvt.d.l
+; CHECK:       vcvt.s.d
+; CHECK:       vstu
+  %a = load <256 x i32>, <256 x i32>* %p, align 4
+  %b = uitofp <256 x i32> %a to <256 x float>
+  store <256 x float> %b, <256 x float>* %q, align 4
+  ret void
+}
+
+define void @zext_v256i8(<256 x i8>* %p, <256 x i32>* %q) {
+; CHECK-LABEL: zext_v256i8:
+; CHECK:       vseq
+; CHECK:       vgt
+; CHECK:       vsrl
+; CHECK:       vand
+; CHECK:       vstl
+  %a = load <256 x i8>, <256 x i8>* %p, align 1
+  %b = zext <256 x i8> %a to <256 x i32>
+  store <256 x i32> %b, <256 x i32>* %q, align 4
+  ret void
+}
+
+define void @sext_v256i8(<256 x i8>* %p, <256 x i64>* %q) {
+; CHECK-LABEL: sext_v256i8:
+; CHECK:       vgt
+; CHECK:       vsrl
+; CHECK:       vsla
+; CHECK:       vsra
+; CHECK:       vst
+  %a = load <256 x i8>, <256 x i8>* %p, align 1
+  %b = sext <256 x i8> %a to <256 x i64>
+  store <256 x i64> %b, <256 x i64>* %q, align 8
+  ret void
+}
@@ -0,0 +1,223 @@
+; RUN: llc < %s -mtriple=ve-unknown-unknown -o /dev/null \
+; RUN:   -pass-remarks-analysis=ve-machine-scheduler 2>&1 | FileCheck %s
+; RUN: llc < %s -mtriple=ve-unknown-unknown \
+; RUN:   | FileCheck %s --check-prefix=VE --implicit-check-not="vst "
+; RUN: llc < %s -mtriple=ve-unknown-unknown -misched=converge \
+; RUN:   | FileCheck %s --check-prefix=GENERIC --implicit-check-not="vst "
+
+; All loads come before the adds, so the region needs about as many vector
+; registers as there are loads.  The VE scheduler reports such regions and
+; prefers the adds over the loads to keep the vector register pressure down.
+
+; CHECK: remark: {{.*}} region needs {{[0-9]+}} of {{[0-9]+}} V64 registers
+
+; Neither strategy spills a vector register; the only vst is the result.
+; The generic scheduler issues all 62 loads first and fills 62 of the 64
+; vector registers.  The VE scheduler stops 4 registers short of the limit
+; and interleaves the remaining loads with the adds.
+
+; VE-LABEL:      sum:
+; VE-COUNT-60:   vld %v
+; VE-NOT:        vld %v
+; VE:            vfadd.d
+; VE-NEXT:       vld %v
+; VE-NEXT:       vfadd.d
+; VE-NEXT:       vld %v
+; VE:            vst %v{{[0-9]+}},8,%s{{[0-9]+}}
+
+; GENERIC-LABEL: sum:
+; GENERIC-COUNT-62: vld %v
+; GENERIC-NOT:   vld %v
+; GENERIC:       vfadd.d
+; GENERIC-NOT:   vld %v
+; GENERIC:       vst %v{{[0-9]+}},8,%s{{[0-9]+}}
+
+define void @sum(<256 x double>* %p, <256 x double>* %q) {
+  %p0 = getelementptr <256 x double>, <256 x double>* %p, i64 0
+  %p1 = getelementptr <256 x double>, <256 x double>* %p, i64 1
+  %p2 = getelementptr <256 x double>, <256 x double>* %p, i64 2
+  %p3 = getelementptr <256 x double>, <256 x double>* %p, i64 3
+  %p4 = getelementptr <256 x double>, <256 x double>* %p, i64 4
+  %p5 = getelementptr <256 x double>, <256 x double>* %p, i64 5
+  %p6 = getelementptr <256 x double>, <256 x double>* %p, i64 6
+  %p7 = getelementptr <256 x double>, <256 x double>* %p, i64 7
+  %p8 = getelementptr <256 x double>, <256 x double>* %p, i64 8
+  %p9 = getelementptr <256 x double>, <256 x double>* %p, i64 9
+  %p10 = getelementptr <256 x double>, <256 x double>* %p, i64 10
+  %p11 = getelementptr <256 x double>, <256 x double>* %p, i64 11
+  %p12 = getelementptr <256 x double>, <256 x double>* %p, i64 12
+  %p13 = getelementptr <256 x double>, <256 x double>* %p, i64 13
+  %p14 = getelementptr <256 x double>, <256 x double>* %p, i64 14
+  %p15 = getelementptr <256 x double>, <256 x double>* %p, i64 15
+  %p16 = getelementptr <256 x double>, <256 x double>* %p, i64 16
+  %p17 = getelementptr <256 x double>, <256 x double>* %p, i64 17
+  %p18 = getelementptr <256 x double>, <256 x double>* %p, i64 18
+  %p19 = getelementptr <256 x double>, <256 x double>* %p, i64 19
+  %p20 = getelementptr <256 x double>, <256 x double>* %p, i64 20
+  %p21 = getelementptr <256 x double>, <256 x double>* %p, i64 21
+  %p22 = getelementptr <256 x double>, <256 x double>* %p, i64 22
+  %p23 = getelementptr <256 x double>, <256 x double>* %p, i64 23
+  %p24 = getelementptr <256 x double>, <256 x double>* %p, i64 24
+  %p25 = getelementptr <256 x double>, <256 x double>* %p, i64 25
+  %p26 = getelementptr <256 x double>, <256 x double>* %p, i64 26
+  %p27 = getelementptr <256 x double>, <256 x double>* %p, i64 27
+  %p28 = getelementptr <256 x double>, <256 x double>* %p, i64 28
+  %p29 = getelementptr <256 x double>, <256 x double>* %p, i64 29
+  %p30 = getelementptr <256 x double>, <256 x double>* %p, i64 30
+  %p31 = getelementptr <256 x double>, <256 x double>* %p, i64 31
+  %p32 = getelementptr <256 x double>, <256 x double>* %p, i64 32
+  %p33 = getelementptr <256 x double>, <256 x double>* %p, i64 33
+  %p34 = getelementptr <256 x double>, <256 x double>* %p, i64 34
+  %p35 = getelementptr <256 x double>, <256 x double>* %p, i64 35
+  %p36 = getelementptr <256 x double>, <256 x double>* %p, i64 36
+  %p37 = getelementptr <256 x double>, <256 x double>* %p, i64 37
+  %p38 = getelementptr <256 x double>, <256 x double>* %p, i64 38
+  %p39 = getelementptr <256 x double>, <256 x double>* %p, i64 39
+  %p40 = getelementptr <256 x double>, <256 x double>* %p, i64 40
+  %p41 = getelementptr <256 x double>, <256 x double>* %p, i64 41
+  %p42 = getelementptr <256 x double>, <256 x double>* %p, i64 42
+  %p43 = getelementptr <256 x double>, <256 x double>* %p, i64 43
+  %p44 = getelementptr <256 x double>, <256 x double>* %p, i64 44
+  %p45 = getelementptr <256 x double>, <256 x double>* %p, i64 45
+  %p46 = getelementptr <256 x double>, <256 x double>* %p, i64 46
+  %p47 = getelementptr <256 x double>, <256 x double>* %p, i64 47
+  %p48 = getelementptr <256 x double>, <256 x double>* %p, i64 48
+  %p49 = getelementptr <256 x double>, <256 x double>* %p, i64 49
+  %p50 = getelementptr <256 x double>, <256 x double>* %p, i64 50
+  %p51 = getelementptr <256 x double>, <256 x double>* %p, i64 51
+  %p52 = getelementptr <256 x double>, <256 x double>* %p, i64 52
+  %p53 = getelementptr <256 x double>, <256 x double>* %p, i64 53
+  %p54 = getelementptr <256 x double>, <256 x double>* %p, i64 54
+  %p55 = getelementptr <256 x double>, <256 x double>* %p, i64 55
+  %p56 = getelementptr <256 x double>, <256 x double>* %p, i64 56
+  %p57 = getelementptr <256 x double>, <256 x double>* %p, i64 57
+  %p58 = getelementptr <256 x double>, <256 x double>* %p, i64 58
+  %p59 = getelementptr <256 x double>, <256 x double>* %p, i64 59
+  %p60 = getelementptr <256 x double>, <256 x double>* %p, i64 60
+  %p61 = getelementptr <256 x double>, <256 x double>* %p, i64 61
+  %v0 = load <256 x double>, <256 x double>* %p0, align 8
+  %v1 = load <256 x double>, <256 x double>* %p1, align 8
+  %v2 = load <256 x double>, <256 x double>* %p2, align 8
+  %v3 = load <256 x double>, <256 x double>* %p3, align 8
+  %v4 = load <256 x double>, <256 x double>* %p4, align 8
+  %v5 = load <256 x double>, <256 x double>* %p5, align 8
+  %v6 = load <256 x double>, <256 x double>* %p6, align 8
+  %v7 = load <256 x double>, <256 x double>* %p7, align 8
+  %v8 = load <256 x double>, <256 x double>* %p8, align 8
+  %v9 = load <256 x double>, <256 x double>* %p9, align 8
+  %v10 = load <256 x double>, <256 x double>* %p10, align 8
+  %v11 = load <256 x double>, <256 x double>* %p11, align 8
+  %v12 = load <256 x double>, <256 x double>* %p12, align 8
+  %v13 = load <256 x double>, <256 x double>* %p13, align 8
+  %v14 = load <256 x double>, <256 x double>* %p14, align 8
+  %v15 = load <256 x double>, <256 x double>* %p15, align 8
+  %v16 = load <256 x double>, <256 x double>* %p16, align 8
+  %v17 = load <256 x double>, <256 x double>* %p17, align 8
+  %v18 = load <256 x double>, <256 x double>* %p18, align 8
+  %v19 = load <256 x double>, <256 x double>* %p19, align 8
+  %v20 = load <256 x double>, <256 x double>* %p20, align 8
+  %v21 = load <256 x double>, <256 x double>* %p21, align 8
+  %v22 = load <256 x double>, <256 x double>* %p22, align 8
+  %v23 = load <256 x double>, <256 x double>* %p23, align 8
+  %v24 = load <256 x double>, <256 x double>* %p24, align 8
+  %v25 = load <256 x double>, <256 x double>* %p25, align 8
+  %v26 = load <256 x double>, <256 x double>* %p26, align 8
+  %v27 = load <256 x double>, <256 x double>* %p27, align 8
+  %v28 = load <256 x double>, <256 x double>* %p28, align 8
+  %v29 = load <256 x double>, <256 x double>* %p29, align 8
+  %v30 = load <256 x double>, <256 x double>* %p30, align 8
+  %v31 = load <256 x double>, <256 x double>* %p31, align 8
+  %v32 = load <256 x double>, <256 x double>* %p32, align 8
+  %v33 = load <256 x double>, <256 x double>* %p33, align 8
+  %v34 = load <256 x double>, <256 x double>* %p34, align 8
+  %v35 = load <256 x double>, <256 x double>* %p35, align 8
+  %v36 = load <256 x double>, <256 x double>* %p36, align 8
+  %v37 = load <256 x double>, <256 x double>* %p37, align 8
+  %v38 = load <256 x double>, <256 x double>* %p38, align 8
+  %v39 = load <256 x double>, <256 x double>* %p39, align 8
+  %v40 = load <256 x double>, <256 x double>* %p40, align 8
+  %v41 = load <256 x double>, <256 x double>* %p41, align 8
+  %v42 = load <256 x double>, <256 x double>* %p42, align 8
+  %v43 = load <256 x double>, <256 x double>* %p43, align 8
+  %v44 = load <256 x double>, <256 x double>* %p44, align 8
+  %v45 = load <256 x double>, <256 x double>* %p45, align 8
+  %v46 = load <256 x double>, <256 x double>* %p46, align 8
+  %v47 = load <256 x double>, <256 x double>* %p47, align 8
+  %v48 = load <256 x double>, <256 x double>* %p48, align 8
+  %v49 = load <256 x double>, <256 x double>* %p49, align 8
+  %v50 = load <256 x double>, <256 x double>* %p50, align 8
+  %v51 = load <256 x double>, <256 x double>* %p51, align 8
+  %v52 = load <256 x double>, <256 x double>* %p52, align 8
+  %v53 = load <256 x double>, <256 x double>* %p53, align 8
+  %v54 = load <256 x double>, <256 x double>* %p54, align 8
+  %v55 = load <256 x double>, <256 x double>* %p55, align 8
+  %v56 = load <256 x double>, <256 x double>* %p56, align 8
+  %v57 = load <256 x double>, <256 x double>* %p57, align 8
+  %v58 = load <256 x double>, <256 x double>* %p58, align 8
+  %v59 = load <256 x double>, <256 x double>* %p59, align 8
+  %v60 = load <256 x double>, <256 x double>* %p60, align 8
+  %v61 = load <256 x double>, <256 x double>* %p61, align 8
+  %s1 = fadd <256 x double> %v0, %v1
+  %s2 = fadd <256 x double> %s1, %v2
+  %s3 = fadd <256 x double> %s2, %v3
+  %s4 = fadd <256 x double> %s3, %v4
+  %s5 = fadd <256 x double> %s4, %v5
+  %s6 = fadd <256 x double> %s5, %v6
+  %s7 = fadd <256 x double> %s6, %v7
+  %s8 = fadd <256 x double> %s7, %v8
+  %s9 = fadd <256 x double> %s8, %v9
+  %s10 = fadd <256 x double> %s9, %v10
+  %s11 = fadd <256 x double> %s10, %v11
+  %s12 = fadd <256 x double> %s11, %v12
+  %s13 = fadd <256 x double> %s12, %v13
+  %s14 = fadd <256 x double> %s13, %v14
+  %s15 = fadd <256 x double> %s14, %v15
+  %s16 = fadd <256 x double> %s15, %v16
+  %s17 = fadd <256 x double> %s16, %v17
+  %s18 = fadd <256 x double> %s17, %v18
+  %s19 = fadd <256 x double> %s18, %v19
+  %s20 = fadd <256 x double> %s19, %v20
+  %s21 = fadd <256 x double> %s20, %v21
+  %s22 = fadd <256 x double> %s21, %v22
+  %s23 = fadd <256 x double> %s22, %v23
+  %s24 = fadd <256 x double> %s23, %v24
+  %s25 = fadd <256 x double> %s24, %v25
+  %s26 = fadd <256 x double> %s25, %v26
+  %s27 = fadd <256 x double> %s26, %v27
+  %s28 = fadd <256 x double> %s27, %v28
+  %s29 = fadd <256 x double> %s28, %v29
+  %s30 = fadd <256 x double> %s29, %v30
+  %s31 = fadd <256 x double> %s30, %v31
+  %s32 = fadd <256 x double> %s31, %v32
+  %s33 = fadd <256 x double> %s32, %v33
+  %s34 = fadd <256 x double> %s33, %v34
+  %s35 = fadd <256 x double> %s34, %v35
+  %s36 = fadd <256 x double> %s35, %v36
+  %s37 = fadd <256 x double> %s36, %v37
+  %s38 = fadd <256 x double> %s37, %v38
+  %s39 = fadd <256 x double> %s38, %v39
+  %s40 = fadd <256 x double> %s39, %v40
+  %s41 = fadd <256 x double> %s40, %v41
+  %s42 = fadd <256 x double> %s41, %v42
+  %s43 = fadd <256 x double> %s42, %v43
+  %s44 = fadd <256 x double> %s43, %v44
+  %s45 = fadd <256 x double> %s44, %v45
+  %s46 = fadd <256 x double> %s45, %v46
+  %s47 = fadd <256 x double> %s46, %v47
+  %s48 = fadd <256 x double> %s47, %v48
+  %s49 = fadd <256 x double> %s48, %v49
+  %s50 = fadd <256 x double> %s49, %v50
+  %s51 = fadd <256 x double> %s50, %v51
+  %s52 = fadd <256 x double> %s51, %v52
+  %s53 = fadd <256 x double> %s52, %v53
+  %s54 = fadd <256 x double> %s53, %v54
+  %s55 = fadd <256 x double> %s54, %v55
+  %s56 = fadd <256 x double> %s55, %v56
+  %s57 = fadd <256 x double> %s56, %v57
+  %s58 = fadd <256 x double> %s57, %v58
+  %s59 = fadd <256 x double> %s58, %v59
+  %s60 = fadd <256 x double> %s59, %v60
+  %s61 = fadd <256 x double> %s60, %v61
+  store <256 x double> %s61, <256 x double>* %q, align 8
+  ret void
+}
@@ -0,0 +1,10 @@
+declare i32 @b()
+
+define i32 @a() {
+  %r = call i32 @b()
+  ret i32 %r
+}
+
+define i32 @unused_a() {
+  ret i32 1
+}
@@ -0,0 +1,43 @@
+; @unused_b and @unused_c share the type !17, so it ends up in the module-level
+; metadata block.
+
+define i32 @b() !dbg !6 {
+  ret i32 2, !dbg !9
+}
+
+define i32 @unused_b(i32 %x) !dbg !10 {
+  call void @llvm.dbg.value(metadata i32 %x, metadata !13, metadata !DIExpression()), !dbg !14
+  ret i32 %x, !dbg !14
+}
+
+define i32 @unused_c() !dbg !15 {
+  ret i32 3, !dbg !16
+}
+
+declare void @llvm.dbg.value(metadata, metadata, metadata)
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!3, !4}
+
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, producer: "clang", isOptimized: true, runtimeVersion: 0, emissionKind: FullDebug, enums: !2)
+!1 = !DIFile(filename: "lazy-b.c", directory: "/tmp")
+!2 = !{}
+!3 = !{i32 2, !"Debug Info Version", i32 3}
+!4 = !{i32 2, !"Dwarf Version", i32 4}
+!5 = !DIBasicType(name: "int", size: 32, encoding: DW_ATE_signed)
+!6 = distinct !DISubprogram(name: "b", scope: !1, file: !1, line: 1, type: !7, isLocal: false, isDefinition: true, scopeLine: 1, isOptimized: true, unit: !0)
+!7 = !DISubroutineType(types: !8)
+!8 = !{!5}
+!9 = !DILocation(line: 1, column: 1, scope: !6)
+!10 = distinct !DISubprogram(name: "unused_b", scope: !1, file: !1, line: 2, type: !11, isLocal: false, isDefinition: true, scopeLine: 2, isOptimized: true, unit: !0, retainedNodes: !12)
+!11 = !DISubroutineType(types: !{!5, !17})
+!12 = !{!13}
+!13 = !DILocalVariable(name: "x", arg: 1, scope: !10, file: !1, line: 2, type: !5)
+!14 = !DILocation(line: 2, column: 1, scope: !10)
+!15 = distinct !DISubprogram(name: "unused_c", scope: !1, file: !1, line: 3, type: !11, isLocal: false, isDefinition: true, scopeLine: 3, isOptimized: true, unit: !0)
+!16 = !DILocation(line: 3, column: 1, scope: !15)
+!17 = !DICompositeType(tag: DW_TAG_structure_type, name: "S", file: !1, line: 10, size: 96, elements: !18)
+!18 = !{!19, !20, !21}
+!19 = !DIDerivedType(tag: DW_TAG_member, name: "m0", scope: !17, file: !1, line: 11, baseType: !5, size: 32, offset: 0)
+!20 = !DIDerivedType(tag: DW_TAG_member, name: "m1", scope: !17, file: !1, line: 12, baseType: !5, size: 32, offset: 32)
+!21 = !DIDerivedType(tag: DW_TAG_member, name: "m2", scope: !17, file: !1, line: 13, baseType: !5, size: 32, offset: 64)
@@ -0,0 +1,8 @@
+define weak i32 @f() {
+  ret i32 1
+}
+
+define i32 @g() {
+  %r = call i32 @f()
+  ret i32 %r
+}
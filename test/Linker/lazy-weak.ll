@@ -0,0 +1,32 @@
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-as %p/Inputs/lazy-weak-a.ll -o %t.a.bc
+; RUN: llvm-as %p/Inputs/lazy-weak-b.ll -o %t.b.bc
+
+; The strong definition of @f in the last file wins over the weak one, as in a
+; normal link. The weak @f comes along with @g, so it is replaced after the
+; fact.
+; RUN: llvm-link -S -lazy %t.bc %t.a.bc %t.b.bc | FileCheck %s
+; RUN: llvm-link -S %t.bc %t.a.bc %t.b.bc | FileCheck %s
+
+; CHECK-NOT: ret i32 1
+; CHECK-DAG: define i32 @f()
+; CHECK-DAG: ret i32 2
+; CHECK-DAG: define i32 @g()
+
+; It also wins over a weak definition in the first file.
+; RUN: llvm-link -S -lazy %t.a.bc %t.b.bc | FileCheck %s --check-prefix=FIRST
+; RUN: llvm-link -S %t.a.bc %t.b.bc | FileCheck %s --check-prefix=FIRST
+
+; FIRST-NOT: ret i32 1
+; FIRST-DAG: define i32 @f()
+; FIRST-DAG: ret i32 2
+
+declare i32 @f()
+declare i32 @g()
+
+define i32 @main() {
+  %f = call i32 @f()
+  %g = call i32 @g()
+  %r = add i32 %f, %g
+  ret i32 %r
+}
@@ -0,0 +1,40 @@
+; RUN: llvm-as %s -o %t.bc
+; RUN: llvm-as %p/Inputs/lazy-a.ll -o %t.a.bc
+; RUN: llvm-as %p/Inputs/lazy-b.ll -o %t.b.bc -bitcode-mdindex-threshold=0
+; REQUIRES: asserts
+
+; @a needs @b, which is defined in a file preceding it. -only-needed misses it,
+; -lazy links it regardless of the order of the files.
+; RUN: llvm-link -S -lazy %t.bc %t.b.bc %t.a.bc | FileCheck %s
+; RUN: llvm-link -S -only-needed %t.bc %t.b.bc %t.a.bc \
+; RUN:   | FileCheck %s --check-prefix=ONLYNEEDED
+
+; CHECK: define i32 @main()
+; CHECK: define i32 @a()
+; CHECK: define i32 @b() !dbg
+; CHECK-NOT: @unused
+; CHECK: distinct !DISubprogram(name: "b"
+; CHECK-NOT: name: "unused_b"
+; CHECK-NOT: name: "S"
+
+; ONLYNEEDED: define i32 @a()
+; ONLYNEEDED: declare i32 @b()
+
+; Check that linking @b does not trigger loading the global metadata of
+; @unused_b and @unused_c.
+; RUN: llvm-link -lazy -o /dev/null -stats %t.bc %t.b.bc %t.a.bc 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=LAZY
+; LAZY: 143 bitcode-reader - Number of Metadata records loaded
+; LAZY: 7 bitcode-reader - Number of MDStrings loaded
+
+; RUN: llvm-link -lazy -o /dev/null -disable-ondemand-mds-loading -stats \
+; RUN:   %t.bc %t.b.bc %t.a.bc 2>&1 | FileCheck %s --check-prefix=NOTLAZY
+; NOTLAZY: 153 bitcode-reader - Number of Metadata records loaded
+; NOTLAZY: 11 bitcode-reader - Number of MDStrings loaded
+
+declare i32 @a()
+
+define i32 @main() {
+  %r = call i32 @a()
+  ret i32 %r
+}
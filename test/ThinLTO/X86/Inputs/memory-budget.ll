@@ -0,0 +1,12 @@
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @big(i32 %x) {
+  %a = mul i32 %x, %x
+  %b = add i32 %a, %x
+  %c = mul i32 %b, %a
+  %d = add i32 %c, %b
+  %e = mul i32 %d, %c
+  %f = add i32 %e, %d
+  ret i32 %f
+}
@@ -0,0 +1,53 @@
+; RUN: opt -module-hash -module-summary %s -o %t.bc
+; RUN: opt -module-hash -module-summary %p/Inputs/cache.ll -o %t2.bc
+
+; Entries written with a codec start with the compressed entry magic and are
+; uncompressed on a hit, whatever codec the later link asks for.
+; RUN: rm -Rf %t.cache
+; RUN: llvm-lto2 run -o %t.o %t2.bc %t.bc -cache-dir %t.cache \
+; RUN:  -cache-compression=lz4 \
+; RUN:  -r=%t2.bc,_main,plx \
+; RUN:  -r=%t2.bc,_globalfunc,lx \
+; RUN:  -r=%t.bc,_globalfunc,plx
+; RUN: ls %t.cache/llvmcache-* | count 2
+; RUN: cat %t.cache/llvmcache-* | FileCheck %s --check-prefix=MAGIC
+; RUN: llvm-nm %t.o.1 %t.o.2 | FileCheck %s --check-prefix=NM
+; RUN: rm %t.o.1 %t.o.2
+; RUN: llvm-lto2 run -o %t.o %t2.bc %t.bc -cache-dir %t.cache \
+; RUN:  -cache-compression=zlib -thinlto-cache-stats \
+; RUN:  -r=%t2.bc,_main,plx \
+; RUN:  -r=%t2.bc,_globalfunc,lx \
+; RUN:  -r=%t.bc,_globalfunc,plx 2>&1 | FileCheck %s --check-prefix=HIT
+; RUN: llvm-nm %t.o.1 %t.o.2 | FileCheck %s --check-prefix=NM
+
+; Entries whose header claims a huge object are rebuilt.
+; RUN: %python -c "import glob; [(h.seek(5), h.write(bytearray([255] * 8)), h.close()) for h in [open(f, 'r+b') for f in glob.glob(r'%t.cache/llvmcache-*')]]"
+; RUN: rm %t.o.1 %t.o.2
+; RUN: llvm-lto2 run -o %t.o %t2.bc %t.bc -cache-dir %t.cache \
+; RUN:  -cache-compression=lz4 -thinlto-cache-stats \
+; RUN:  -r=%t2.bc,_main,plx \
+; RUN:  -r=%t2.bc,_globalfunc,lx \
+; RUN:  -r=%t.bc,_globalfunc,plx 2>&1 | FileCheck %s --check-prefix=CORRUPT
+; RUN: llvm-nm %t.o.1 %t.o.2 | FileCheck %s --check-prefix=NM
+
+; RUN: not llvm-lto2 run -o %t.o %t2.bc %t.bc -cache-dir %t.cache \
+; RUN:  -cache-compression=foo \
+; RUN:  -r=%t2.bc,_main,plx \
+; RUN:  -r=%t2.bc,_globalfunc,lx \
+; RUN:  -r=%t.bc,_globalfunc,plx 2>&1 | FileCheck %s --check-prefix=ERR
+
+; MAGIC: LZC
+; NM: T _globalfunc
+; HIT: hits:          2
+; HIT: misses:        0
+; CORRUPT: hits:          0
+; CORRUPT: misses:        2
+; ERR: invalid cache compression: foo
+
+target datalayout = "e-m:o-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-apple-macosx10.11.0"
+
+define void @globalfunc() {
+entry:
+  ret void
+}
@@ -0,0 +1,42 @@
+; RUN: opt -module-hash -module-summary %s -o %t.bc
+; RUN: opt -module-hash -module-summary %p/Inputs/cache.ll -o %t2.bc
+
+; The indexed layout shards the entries by the first two characters of their
+; key and journals each use.
+; RUN: rm -Rf %t.cache
+; RUN: llvm-lto2 run -o %t.o %t2.bc %t.bc -cache-dir %t.cache -cache-indexed \
+; RUN:  -thinlto-cache-stats \
+; RUN:  -r=%t2.bc,_main,plx \
+; RUN:  -r=%t2.bc,_globalfunc,lx \
+; RUN:  -r=%t.bc,_globalfunc,plx 2>&1 | FileCheck %s --check-prefix=MISS
+; RUN: not ls %t.cache/llvmcache-*
+; RUN: ls %t.cache/*/llvmcache-* | count 2
+; RUN: ls %t.cache/llvmcache.journal
+
+; MISS: hits:          0
+; MISS: misses:        2
+
+; A second link hits both entries, and pruning folds the journal into the
+; index.
+; RUN: llvm-lto2 run -o %t.o %t2.bc %t.bc -cache-dir %t.cache -cache-indexed \
+; RUN:  -cache-policy prune_interval=0s:cache_size_files=1 \
+; RUN:  -thinlto-cache-stats \
+; RUN:  -r=%t2.bc,_main,plx \
+; RUN:  -r=%t2.bc,_globalfunc,lx \
+; RUN:  -r=%t.bc,_globalfunc,plx 2>&1 | FileCheck %s --check-prefix=HIT
+; RUN: ls %t.cache/*/llvmcache-* | count 1
+; RUN: ls %t.cache/llvmcache.index
+; RUN: not ls %t.cache/llvmcache.journal
+
+; HIT: hits:          2
+; HIT: misses:        0
+; HIT: hit rate:      100%
+; HIT: evictions:     1
+
+target datalayout = "e-m:o-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-apple-macosx10.11.0"
+
+define void @globalfunc() {
+entry:
+  ret void
+}
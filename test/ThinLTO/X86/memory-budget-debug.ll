@@ -0,0 +1,36 @@
+; Test that backends are dispatched largest first and that backends which do
+; not fit the memory budget together never run at the same time.
+
+; REQUIRES: asserts
+; RUN: opt -module-summary %s -o %t1.bc
+; RUN: opt -module-summary %p/Inputs/memory-budget.ll -o %t2.bc
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -thinlto-threads=2 \
+; RUN:   -thinlto-memory-budget=1 -thinlto-backend-bytes-per-inst=1048576 \
+; RUN:   -debug-only=lto -stats \
+; RUN:   -r %t1.bc,main,plx \
+; RUN:   -r %t1.bc,big,l \
+; RUN:   -r %t2.bc,big,plx 2> %t.log
+; RUN: FileCheck %s --check-prefix=DISPATCH < %t.log
+; RUN: FileCheck %s --check-prefix=START < %t.log
+; RUN: FileCheck %s --check-prefix=STATS < %t.log
+
+; main and the copy of big imported into it cost 9 instructions, big alone 7.
+; DISPATCH: Dispatching ThinLTO backend {{.*}}1.bc with cost 9
+; DISPATCH: Dispatching ThinLTO backend {{.*}}2.bc with cost 7
+
+; Each backend alone exceeds the 1 MB budget, so it only starts once the other
+; one has released its share.
+; START-DAG: ThinLTO backend {{.*}}1.bc starts: 9437184 bytes, 9437184 of 1048576 bytes in use
+; START-DAG: ThinLTO backend {{.*}}2.bc starts: 7340032 bytes, 7340032 of 1048576 bytes in use
+
+; STATS: 9216 lto - Peak estimated footprint of the running ThinLTO backends, in KB
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i32 @big(i32)
+
+define i32 @main(i32 %x) {
+  %r = call i32 @big(i32 %x)
+  ret i32 %r
+}
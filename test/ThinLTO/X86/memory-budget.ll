@@ -0,0 +1,24 @@
+; Test that backends limited by a memory budget all run.
+
+; RUN: opt -module-summary %s -o %t1.bc
+; RUN: opt -module-summary %p/Inputs/memory-budget.ll -o %t2.bc
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -thinlto-threads=2 \
+; RUN:   -thinlto-memory-budget=1 \
+; RUN:   -r %t1.bc,main,plx \
+; RUN:   -r %t1.bc,big,l \
+; RUN:   -r %t2.bc,big,plx
+; RUN: llvm-nm %t.o.1 | FileCheck %s --check-prefix=NM1
+; RUN: llvm-nm %t.o.2 | FileCheck %s --check-prefix=NM2
+
+; NM1: T main
+; NM2: T big
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i32 @big(i32)
+
+define i32 @main(i32 %x) {
+  %r = call i32 @big(i32 %x)
+  ret i32 %r
+}
@@ -0,0 +1,64 @@
+; REQUIRES: asserts
+; RUN: opt -module-hash -module-summary %s -o %t.bc
+; RUN: opt -module-hash -module-summary %p/Inputs/thin-link-cache-foo.ll \
+; RUN:   -o %t.foo.bc
+; RUN: opt -module-hash -module-summary %p/Inputs/thin-link-cache-bar.ll \
+; RUN:   -o %t.bar.bc
+; RUN: sed -e s/42/43/ %p/Inputs/thin-link-cache-bar.ll | \
+; RUN:   opt -module-hash -module-summary -o %t.bar2.bc
+
+; The first link computes the import lists of all modules.
+; RUN: rm -f %t.cache
+; RUN: cp %t.bar.bc %t.edit.bc
+; RUN: llvm-lto2 run -o %t.o %t.bc %t.foo.bc %t.edit.bc -save-temps -stats \
+; RUN:  -thinlto-link-cache=%t.cache \
+; RUN:  -r=%t.bc,_main,plx \
+; RUN:  -r=%t.bc,_foo, \
+; RUN:  -r=%t.bc,_bar, \
+; RUN:  -r=%t.foo.bc,_foo,pl \
+; RUN:  -r=%t.edit.bc,_bar,pl 2>&1 | FileCheck %s --check-prefix=FIRST \
+; RUN:  --allow-empty
+; RUN: llvm-dis < %t.o.1.3.import.bc | FileCheck %s --check-prefix=IMPORT
+
+; Relinking the same modules reuses all import lists.
+; RUN: llvm-lto2 run -o %t.o %t.bc %t.foo.bc %t.edit.bc -save-temps -stats \
+; RUN:  -thinlto-link-cache=%t.cache \
+; RUN:  -r=%t.bc,_main,plx \
+; RUN:  -r=%t.bc,_foo, \
+; RUN:  -r=%t.bc,_bar, \
+; RUN:  -r=%t.foo.bc,_foo,pl \
+; RUN:  -r=%t.edit.bc,_bar,pl 2>&1 | FileCheck %s --check-prefix=ALL
+; RUN: llvm-dis < %t.o.1.3.import.bc | FileCheck %s --check-prefix=IMPORT
+
+; After changing bar, the lists of the module defining it and of main, which
+; may import it, are computed again.
+; RUN: cp %t.bar2.bc %t.edit.bc
+; RUN: llvm-lto2 run -o %t.o %t.bc %t.foo.bc %t.edit.bc -save-temps -stats \
+; RUN:  -thinlto-link-cache=%t.cache \
+; RUN:  -r=%t.bc,_main,plx \
+; RUN:  -r=%t.bc,_foo, \
+; RUN:  -r=%t.bc,_bar, \
+; RUN:  -r=%t.foo.bc,_foo,pl \
+; RUN:  -r=%t.edit.bc,_bar,pl 2>&1 | FileCheck %s --check-prefix=EDIT
+; RUN: llvm-dis < %t.o.1.3.import.bc | FileCheck %s --check-prefix=IMPORT2
+
+; FIRST-NOT: reusing the import lists
+; ALL: 3 function-import - Number of modules reusing the import lists of a previous thin link
+; EDIT: 1 function-import - Number of modules reusing the import lists of a previous thin link
+; IMPORT-DAG: define available_externally i32 @foo()
+; IMPORT-DAG: ret i32 42
+; IMPORT2: ret i32 43
+
+target datalayout = "e-m:o-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-apple-macosx10.11.0"
+
+define i32 @main() {
+entry:
+  %f = call i32 @foo()
+  %b = call i32 @bar()
+  %r = add i32 %f, %b
+  ret i32 %r
+}
+
+declare i32 @foo()
+declare i32 @bar()
@@ -0,0 +1,85 @@
+; RUN: opt -mtriple=ve-unknown-unknown -loop-data-prefetch -S < %s | FileCheck %s
+; RUN: opt -mtriple=ve-unknown-unknown -loop-data-prefetch -loop-prefetch-writes \
+; RUN:   -S < %s | FileCheck %s --check-prefix=WRITES
+
+; Vectorized loops touch a whole vector of elements per iteration.  Gathers
+; with a strided vector induction are prefetched through their first lane.
+
+define void @stream(<256 x double>* %a, <256 x double>* %b, i64 %n) {
+; CHECK-LABEL: @stream(
+; CHECK:       loop:
+; CHECK:       call void @llvm.prefetch(i8* %{{.*}}, i32 0, i32 3, i32 1)
+; CHECK:       load <256 x double>
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pa = getelementptr inbounds <256 x double>, <256 x double>* %a, i64 %i
+  %pb = getelementptr inbounds <256 x double>, <256 x double>* %b, i64 %i
+  %v = load <256 x double>, <256 x double>* %pb, align 8
+  store <256 x double> %v, <256 x double>* %pa, align 8
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+define void @gather(double* %a, double* %b, i64 %n) {
+; CHECK-LABEL: @gather(
+; CHECK:       loop:
+; CHECK:       call void @llvm.prefetch(i8* %{{.*}}, i32 0, i32 3, i32 1)
+; CHECK:       call <8 x double> @llvm.masked.gather
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %vec.ind = phi <8 x i64> [ <i64 0, i64 64, i64 128, i64 192, i64 256, i64 320, i64 384, i64 448>, %entry ], [ %vec.ind.next, %loop ]
+  %ptrs = getelementptr inbounds double, double* %b, <8 x i64> %vec.ind
+  %v = call <8 x double> @llvm.masked.gather.v8f64.v8p0f64(<8 x double*> %ptrs, i32 8, <8 x i1> <i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true>, <8 x double> undef)
+  %pa = getelementptr inbounds double, double* %a, i64 %i
+  %pv = bitcast double* %pa to <8 x double>*
+  store <8 x double> %v, <8 x double>* %pv, align 8
+  %i.next = add nuw nsw i64 %i, 8
+  %vec.ind.next = add <8 x i64> %vec.ind, <i64 512, i64 512, i64 512, i64 512, i64 512, i64 512, i64 512, i64 512>
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; Scatters are prefetched for writing, volatile loads for reading.
+define void @scatter(double* %a, double* %b, i64 %n) {
+; WRITES-LABEL: @scatter(
+; WRITES:       loop:
+; WRITES:       call void @llvm.prefetch(i8* %{{.*}}, i32 0, i32 3, i32 1)
+; WRITES:       load volatile <8 x double>
+; WRITES:       call void @llvm.prefetch(i8* %{{.*}}, i32 1, i32 3, i32 1)
+; WRITES:       call void @llvm.masked.scatter
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %vec.ind = phi <8 x i64> [ <i64 0, i64 64, i64 128, i64 192, i64 256, i64 320, i64 384, i64 448>, %entry ], [ %vec.ind.next, %loop ]
+  %off = mul nuw nsw i64 %i, 64
+  %pb = getelementptr inbounds double, double* %b, i64 %off
+  %pv = bitcast double* %pb to <8 x double>*
+  %v = load volatile <8 x double>, <8 x double>* %pv, align 8
+  %ptrs = getelementptr inbounds double, double* %a, <8 x i64> %vec.ind
+  call void @llvm.masked.scatter.v8f64.v8p0f64(<8 x double> %v, <8 x double*> %ptrs, i32 8, <8 x i1> <i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true, i1 true>)
+  %i.next = add nuw nsw i64 %i, 8
+  %vec.ind.next = add <8 x i64> %vec.ind, <i64 512, i64 512, i64 512, i64 512, i64 512, i64 512, i64 512, i64 512>
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+declare <8 x double> @llvm.masked.gather.v8f64.v8p0f64(<8 x double*>, i32, <8 x i1>, <8 x double>)
+declare void @llvm.masked.scatter.v8f64.v8p0f64(<8 x double>, <8 x double*>, i32, <8 x i1>)
@@ -0,0 +1,117 @@
+; RUN: opt -mtriple=ve-unknown-unknown -loop-vectorize -force-vector-width=256 \
+; RUN:   -force-vector-interleave=1 -S < %s | FileCheck %s
+
+; Nontemporal accesses are only vectorized when VE keeps them nontemporal:
+; vectors of 32-bit or 64-bit elements with at least element alignment.
+
+define void @store_i32(i32* %a, i32* %b, i64 %n) {
+; CHECK-LABEL: @store_i32(
+; CHECK:       vector.body:
+; CHECK:       store <256 x i32> {{.*}}, align 4, {{.*}}!nontemporal
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pb = getelementptr inbounds i32, i32* %b, i64 %i
+  %v = load i32, i32* %pb, align 4
+  %pa = getelementptr inbounds i32, i32* %a, i64 %i
+  store i32 %v, i32* %pa, align 4, !nontemporal !0
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+define void @load_double(double* %a, double* %b, i64 %n) {
+; CHECK-LABEL: @load_double(
+; CHECK:       vector.body:
+; CHECK:       load <256 x double>, {{.*}}, align 8, {{.*}}!nontemporal
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pb = getelementptr inbounds double, double* %b, i64 %i
+  %v = load double, double* %pb, align 8, !nontemporal !0
+  %pa = getelementptr inbounds double, double* %a, i64 %i
+  store double %v, double* %pa, align 8
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; There are no nontemporal vector accesses of 16-bit elements.
+define void @store_i16(i16* %a, i16* %b, i64 %n) {
+; CHECK-LABEL: @store_i16(
+; CHECK-NOT:   vector.body:
+; CHECK-NOT:   <256 x i16>
+; CHECK:       ret void
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pb = getelementptr inbounds i16, i16* %b, i64 %i
+  %v = load i16, i16* %pb, align 2
+  %pa = getelementptr inbounds i16, i16* %a, i64 %i
+  store i16 %v, i16* %pa, align 2, !nontemporal !0
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; An under-aligned nontemporal store can't be kept nontemporal either.
+define void @store_i32_align1(i32* %a, i32* %b, i64 %n) {
+; CHECK-LABEL: @store_i32_align1(
+; CHECK-NOT:   vector.body:
+; CHECK-NOT:   <256 x i32>
+; CHECK:       ret void
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pb = getelementptr inbounds i32, i32* %b, i64 %i
+  %v = load i32, i32* %pb, align 4
+  %pa = getelementptr inbounds i32, i32* %a, i64 %i
+  store i32 %v, i32* %pa, align 1, !nontemporal !0
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+; Without the hint, the same loop is vectorized.
+define void @store_i16_temporal(i16* %a, i16* %b, i64 %n) {
+; CHECK-LABEL: @store_i16_temporal(
+; CHECK:       vector.body:
+; CHECK:       store <256 x i16>
+entry:
+  br label %loop
+
+loop:
+  %i = phi i64 [ 0, %entry ], [ %i.next, %loop ]
+  %pb = getelementptr inbounds i16, i16* %b, i64 %i
+  %v = load i16, i16* %pb, align 2
+  %pa = getelementptr inbounds i16, i16* %a, i64 %i
+  store i16 %v, i16* %pa, align 2
+  %i.next = add nuw nsw i64 %i, 1
+  %done = icmp eq i64 %i.next, %n
+  br i1 %done, label %exit, label %loop
+
+exit:
+  ret void
+}
+
+!0 = !{i32 1}
@@ -0,0 +1,56 @@
+; RUN: llvm-as < %s > %t1.bc
+
+; The function passes run on the partitions, so the module after the module
+; passes still has the loop invariant multiplication inside the loop.
+; RUN: llvm-lto2 run %t1.bc -o %t.o -save-temps -lto-partitions=2 \
+; RUN:   -lto-balance-partitions -lto-split-function-passes \
+; RUN:   -r %t1.bc,foo,px -r %t1.bc,bar,px
+; RUN: llvm-dis < %t.o.0.4.opt.bc | FileCheck %s --check-prefix=MODULE
+; RUN: llvm-dis < %t.o.0.5.precodegen.bc | FileCheck %s --check-prefix=PART0
+; RUN: llvm-dis < %t.o.1.5.precodegen.bc | FileCheck %s --check-prefix=PART1
+
+; Without splitting the function passes, the whole module is optimized before
+; it is split.
+; RUN: llvm-lto2 run %t1.bc -o %t2.o -save-temps -lto-partitions=2 \
+; RUN:   -lto-balance-partitions -r %t1.bc,foo,px -r %t1.bc,bar,px
+; RUN: llvm-dis < %t2.o.0.4.opt.bc | FileCheck %s --check-prefix=WHOLE
+; RUN: llvm-dis < %t2.o.0.5.precodegen.bc | FileCheck %s --check-prefix=PART0
+
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+; MODULE-LABEL: define i32 @foo(
+; MODULE:       loop:
+; MODULE:       %inv = mul i32 %x, %y
+
+; WHOLE-LABEL:  define i32 @foo(
+; WHOLE-NEXT:   entry:
+; WHOLE-NEXT:   %inv = mul i32 %x, %y
+
+; PART0-LABEL:  define i32 @foo(
+; PART0-NEXT:   entry:
+; PART0-NEXT:   %inv = mul i32 %x, %y
+; PART0-NOT:    define void @bar()
+
+; PART1-NOT:    define i32 @foo(
+; PART1:        define void @bar()
+define i32 @foo(i32 %x, i32 %y, i32* %p) {
+entry:
+  br label %loop
+
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %inv = mul i32 %x, %y
+  %q = getelementptr i32, i32* %p, i32 %i
+  store volatile i32 %inv, i32* %q
+  %i.next = add i32 %i, 1
+  %c = icmp slt i32 %i.next, %x
+  br i1 %c, label %loop, label %exit
+
+exit:
+  ret i32 %inv
+}
+
+define void @bar() {
+  ret void
+}
@@ -0,0 +1,65 @@
+; Functions are spread over the partitions by their number of instructions,
+; and placed in the partition which they have the most references with.
+
+; RUN: llvm-split -j=2 -balance-by-size -o %t %s
+; RUN: llvm-dis -o - %t0 | FileCheck --check-prefix=CHECK0 %s
+; RUN: llvm-dis -o - %t1 | FileCheck --check-prefix=CHECK1 %s
+
+; CHECK0: define i32 @big
+; CHECK0: declare i32 @mid1
+; CHECK0: declare i32 @mid2
+; CHECK0: define i32 @callee_big
+; CHECK0: declare i32 @callee_mid
+
+; CHECK1: declare i32 @big
+; CHECK1: define i32 @mid1
+; CHECK1: define i32 @mid2
+; CHECK1: declare i32 @callee_big
+; CHECK1: define i32 @callee_mid
+
+define i32 @big(i32 %x) {
+  %a = add i32 %x, 1
+  %b = mul i32 %a, %x
+  %c = add i32 %b, 2
+  %d = mul i32 %c, %b
+  %e = add i32 %d, 3
+  %f = mul i32 %e, %d
+  %g = add i32 %f, 4
+  %h = mul i32 %g, %f
+  %i = add i32 %h, 5
+  %j = mul i32 %i, %h
+  %k = add i32 %j, 6
+  %l = mul i32 %k, %j
+  %m = add i32 %l, 7
+  %n = mul i32 %m, %l
+  %r = call i32 @callee_big(i32 %n)
+  ret i32 %r
+}
+
+define i32 @mid1(i32 %x) {
+  %a = add i32 %x, 1
+  %b = mul i32 %a, %x
+  %c = add i32 %b, 2
+  %d = mul i32 %c, %b
+  %e = add i32 %d, 3
+  %r = call i32 @callee_mid(i32 %e)
+  ret i32 %r
+}
+
+define i32 @mid2(i32 %x) {
+  %a = add i32 %x, 1
+  %b = mul i32 %a, %x
+  %c = add i32 %b, 2
+  %d = mul i32 %c, %b
+  %e = add i32 %d, 3
+  %r = call i32 @callee_mid(i32 %e)
+  ret i32 %r
+}
+
+define i32 @callee_big(i32 %x) {
+  ret i32 %x
+}
+
+define i32 @callee_mid(i32 %x) {
+  ret i32 %x
+}
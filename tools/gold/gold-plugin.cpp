@@ -24,6 +24,7 @@
 #include "llvm/Object/Error.h"
 #include "llvm/Support/CachePruning.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -139,6 +140,10 @@ namespace options {
   static unsigned Parallelism = 0;
   // Default regular LTO codegen parallelism (number of partitions).
   static unsigned ParallelCodeGenParallelismLevel = 1;
+  // Balance the partitions by instruction count.
+  static bool BalancePartitions = false;
+  // Run the function passes on each partition rather than the whole module.
+  static bool SplitFunctionPasses = false;
 #ifdef NDEBUG
   static bool DisableVerify = true;
 #else
@@ -190,6 +195,10 @@ namespace options {
   static std::string cache_dir;
   // Optional pruning policy for ThinLTO caches.
   static std::string cache_policy;
+  // Optional codec ("zlib" or "lz4") to compress new ThinLTO cache entries.
+  static const compression::Codec *cache_compression = nullptr;
+  // Optional path to a file recording the import lists of the thin link.
+  static std::string thinlto_link_cache;
   // Additional options to pass into the code generator.
   // Note: This array will contain all plugin options which are not claimed
   // as plugin exclusive to pass to the code generator.
@@ -252,6 +261,16 @@ namespace options {
       cache_dir = opt.substr(strlen("cache-dir="));
     } else if (opt.startswith("cache-policy=")) {
       cache_policy = opt.substr(strlen("cache-policy="));
+    } else if (opt.startswith("cache-compression=")) {
+      StringRef Name = opt.substr(strlen("cache-compression="));
+      if (Name != "none") {
+        cache_compression = compression::getCodec(Name);
+        if (!cache_compression)
+          message(LDPL_FATAL, "Unknown cache compression: %s",
+                  Name.str().c_str());
+      }
+    } else if (opt.startswith("thinlto-link-cache=")) {
+      thinlto_link_cache = opt.substr(strlen("thinlto-link-cache="));
     } else if (opt.size() == 2 && opt[0] == 'O') {
       if (opt[1] < '0' || opt[1] > '3')
         message(LDPL_FATAL, "Optimization level must be between 0 and 3");
@@ -263,6 +282,10 @@ namespace options {
       if (opt.substr(strlen("lto-partitions="))
               .getAsInteger(10, ParallelCodeGenParallelismLevel))
         message(LDPL_FATAL, "Invalid codegen partition level: %s", opt_ + 5);
+    } else if (opt == "lto-balance-partitions") {
+      BalancePartitions = true;
+    } else if (opt == "lto-split-function-passes") {
+      SplitFunctionPasses = true;
     } else if (opt == "disable-verify") {
       DisableVerify = true;
     } else if (opt.startswith("sample-profile=")) {
@@ -899,6 +922,9 @@ static std::unique_ptr<LTO> createLTO(IndexWriteCallback OnIndexWrite,
   Conf.DebugPassManager = options::debug_pass_manager;
 
   Conf.StatsFile = options::stats_file;
+  Conf.ThinLinkCacheFile = options::thinlto_link_cache;
+  Conf.BalancePartitions = options::BalancePartitions;
+  Conf.SplitFunctionPasses = options::SplitFunctionPasses;
   return llvm::make_unique<LTO>(std::move(Conf), Backend,
                                 options::ParallelCodeGenParallelismLevel);
 }
@@ -1029,7 +1055,8 @@ static std::vector<std::pair<SmallString<128>, bool>> runLTO() {
 
   NativeObjectCache Cache;
   if (!options::cache_dir.empty())
-    Cache = check(localCache(options::cache_dir, AddBuffer));
+    Cache = check(localCache(options::cache_dir, AddBuffer, /*Stats=*/nullptr,
+                             /*Indexed=*/false, options::cache_compression));
 
   check(Lto->run(AddStream, Cache));
 
@@ -38,6 +38,7 @@
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/ToolOutputFile.h"
 
+#include <climits>
 #include <functional>
 #include <map>
 #include <system_error>
@@ -954,10 +955,18 @@ int CodeCoverageTool::doShow(int argc, const char **argv,
                           ShowFilenames);
   } else {
     // In -output-dir mode, it's safe to use multiple threads to print files.
+    // Start with the largest files, which take the longest to render.
     ThreadPool Pool(NumThreads);
-    for (const std::string &SourceFile : SourceFiles)
-      Pool.async(&CodeCoverageTool::writeSourceFileView, this, SourceFile,
-                 Coverage.get(), Printer.get(), ShowFilenames);
+    for (const std::string &SourceFile : SourceFiles) {
+      uint64_t Size = 0;
+      sys::fs::file_size(SourceFile, Size);
+      ThreadPool::TaskOptions Opts;
+      Opts.Priority = std::min<uint64_t>(Size, INT_MAX);
+      Pool.asyncWithOptions(
+          std::move(Opts),
+          std::bind(&CodeCoverageTool::writeSourceFileView, this, SourceFile,
+                    Coverage.get(), Printer.get(), ShowFilenames));
+    }
     Pool.wait();
   }
 
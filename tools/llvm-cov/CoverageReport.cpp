@@ -14,10 +14,12 @@
 #include "CoverageReport.h"
 #include "RenderingSupport.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Threading.h"
+#include <climits>
 #include <numeric>
 
 using namespace llvm;
@@ -366,10 +368,17 @@ std::vector<FileCoverageSummary> CoverageReport::prepareFileReports(
   std::vector<FileCoverageSummary> FileReports;
   FileReports.reserve(Files.size());
 
+  // Start with the largest files, which take the longest to summarize.
   for (StringRef Filename : Files) {
     FileReports.emplace_back(Filename.drop_front(LCP));
-    Pool.async(&CoverageReport::prepareSingleFileReport, Filename,
-               &Coverage, Options, LCP, &FileReports.back(), &Filters);
+    uint64_t Size = 0;
+    sys::fs::file_size(Filename, Size);
+    ThreadPool::TaskOptions Opts;
+    Opts.Priority = std::min<uint64_t>(Size, INT_MAX);
+    Pool.asyncWithOptions(
+        std::move(Opts),
+        std::bind(&CoverageReport::prepareSingleFileReport, Filename,
+                  &Coverage, Options, LCP, &FileReports.back(), &Filters));
   }
   Pool.wait();
 
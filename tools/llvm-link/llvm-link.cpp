@@ -79,6 +79,12 @@ static cl::opt<bool>
 static cl::opt<bool>
 OnlyNeeded("only-needed", cl::desc("Link only needed symbols"));
 
+static cl::opt<bool>
+    LazyLink("lazy",
+             cl::desc("Link only the definitions reachable from the first "
+                      "input file, reading the bodies and debug info of only "
+                      "those functions"));
+
 static cl::opt<bool>
 Force("f", cl::desc("Enable binary output on terminals"));
 
@@ -125,7 +131,8 @@ static std::unique_ptr<Module> loadFile(const char *argv0,
   if (DisableLazyLoad)
     Result = parseIRFile(FN, Err, Context);
   else
-    Result = getLazyIRFileModule(FN, Err, Context, !MaterializeMetadata);
+    Result = getLazyIRFileModule(FN, Err, Context, !MaterializeMetadata,
+                                 /*LoadMetadataOnDemand=*/LazyLink);
 
   if (!Result) {
     Err.print(argv0, errs());
@@ -273,67 +280,78 @@ static bool importFunctions(const char *argv0, Module &DestModule) {
   return true;
 }
 
-static bool linkFiles(const char *argv0, LLVMContext &Context, Linker &L,
-                      const cl::list<std::string> &Files,
-                      unsigned Flags) {
-  // Filter out flags that don't apply to the first file we load.
-  unsigned ApplicableFlags = Flags & Linker::Flags::OverrideFromSrc;
-  // Similar to some flags, internalization doesn't apply to the first file.
-  bool InternalizeLinkedSymbols = false;
-  for (const auto &File : Files) {
-    std::unique_ptr<Module> M = loadFile(argv0, File, Context);
-    if (!M.get()) {
-      errs() << argv0 << ": ";
-      WithColor::error() << " loading file '" << File << "'\n";
-      return false;
-    }
+static bool linkFile(const char *argv0, LLVMContext &Context, Linker &L,
+                     const std::string &File, unsigned Flags,
+                     bool InternalizeLinkedSymbols) {
+  std::unique_ptr<Module> M = loadFile(argv0, File, Context);
+  if (!M.get()) {
+    errs() << argv0 << ": ";
+    WithColor::error() << " loading file '" << File << "'\n";
+    return false;
+  }
 
-    // Note that when ODR merging types cannot verify input files in here When
-    // doing that debug metadata in the src module might already be pointing to
-    // the destination.
-    if (DisableDITypeMap && verifyModule(*M, &errs())) {
-      errs() << argv0 << ": " << File << ": ";
-      WithColor::error() << "input module is broken!\n";
-      return false;
-    }
+  // Note that when ODR merging types cannot verify input files in here When
+  // doing that debug metadata in the src module might already be pointing to
+  // the destination.
+  if (DisableDITypeMap && verifyModule(*M, &errs())) {
+    errs() << argv0 << ": " << File << ": ";
+    WithColor::error() << "input module is broken!\n";
+    return false;
+  }
 
-    // If a module summary index is supplied, load it so linkInModule can treat
-    // local functions/variables as exported and promote if necessary.
-    if (!SummaryIndex.empty()) {
-      std::unique_ptr<ModuleSummaryIndex> Index =
-          ExitOnErr(llvm::getModuleSummaryIndexForFile(SummaryIndex));
-
-      // Conservatively mark all internal values as promoted, since this tool
-      // does not do the ThinLink that would normally determine what values to
-      // promote.
-      for (auto &I : *Index) {
-        for (auto &S : I.second.SummaryList) {
-          if (GlobalValue::isLocalLinkage(S->linkage()))
-            S->setLinkage(GlobalValue::ExternalLinkage);
-        }
+  // If a module summary index is supplied, load it so linkInModule can treat
+  // local functions/variables as exported and promote if necessary.
+  if (!SummaryIndex.empty()) {
+    std::unique_ptr<ModuleSummaryIndex> Index =
+        ExitOnErr(llvm::getModuleSummaryIndexForFile(SummaryIndex));
+
+    // Conservatively mark all internal values as promoted, since this tool
+    // does not do the ThinLink that would normally determine what values to
+    // promote.
+    for (auto &I : *Index) {
+      for (auto &S : I.second.SummaryList) {
+        if (GlobalValue::isLocalLinkage(S->linkage()))
+          S->setLinkage(GlobalValue::ExternalLinkage);
       }
+    }
 
-      // Promotion
-      if (renameModuleForThinLTO(*M, *Index))
-        return true;
+    // Promotion
+    if (renameModuleForThinLTO(*M, *Index)) {
+      errs() << argv0 << ": ";
+      WithColor::error() << " promoting local values of file '" << File
+                         << "'\n";
+      return false;
     }
+  }
 
-    if (Verbose)
-      errs() << "Linking in '" << File << "'\n";
-
-    bool Err = false;
-    if (InternalizeLinkedSymbols) {
-      Err = L.linkInModule(
-          std::move(M), ApplicableFlags, [](Module &M, const StringSet<> &GVS) {
-            internalizeModule(M, [&GVS](const GlobalValue &GV) {
-              return !GV.hasName() || (GVS.count(GV.getName()) == 0);
-            });
+  if (Verbose)
+    errs() << "Linking in '" << File << "'\n";
+
+  bool Err = false;
+  if (InternalizeLinkedSymbols) {
+    Err = L.linkInModule(
+        std::move(M), Flags, [](Module &M, const StringSet<> &GVS) {
+          internalizeModule(M, [&GVS](const GlobalValue &GV) {
+            return !GV.hasName() || (GVS.count(GV.getName()) == 0);
           });
-    } else {
-      Err = L.linkInModule(std::move(M), ApplicableFlags);
-    }
+        });
+  } else {
+    Err = L.linkInModule(std::move(M), Flags);
+  }
+
+  return !Err;
+}
 
-    if (Err)
+static bool linkFiles(const char *argv0, LLVMContext &Context, Linker &L,
+                      const cl::list<std::string> &Files,
+                      unsigned Flags) {
+  // Filter out flags that don't apply to the first file we load.
+  unsigned ApplicableFlags = Flags & Linker::Flags::OverrideFromSrc;
+  // Similar to some flags, internalization doesn't apply to the first file.
+  bool InternalizeLinkedSymbols = false;
+  for (const auto &File : Files) {
+    if (!linkFile(argv0, Context, L, File, ApplicableFlags,
+                  InternalizeLinkedSymbols))
       return false;
 
     // Internalization applies to linking of subsequent files.
@@ -346,6 +364,91 @@ static bool linkFiles(const char *argv0, LLVMContext &Context, Linker &L,
   return true;
 }
 
+/// Links the first of Files entirely and then, until nothing more is needed,
+/// the definitions of the other files which the linked module declares. This
+/// links a file as often as it provides needed definitions, also when it
+/// precedes the file needing them.
+static bool linkFilesLazily(const char *argv0, LLVMContext &Context, Linker &L,
+                            Module &Composite,
+                            const cl::list<std::string> &Files,
+                            unsigned Flags) {
+  if (!linkFile(argv0, Context, L, Files.front(),
+                Flags & Linker::Flags::OverrideFromSrc,
+                /*InternalizeLinkedSymbols=*/false))
+    return false;
+
+  // Find the file defining each symbol. This only reads the global values, in
+  // a separate context so that their types don't rename those of the link.
+  // As in a normal link, a strong definition takes precedence over weak ones,
+  // whichever file comes first.
+  struct Definition {
+    unsigned File;
+    bool Weak;
+    bool Linked;
+    bool Replaced;
+  };
+  StringMap<Definition> Definitions;
+  {
+    LLVMContext SymbolContext;
+    for (unsigned I = 1, E = Files.size(); I != E; ++I) {
+      std::unique_ptr<Module> M = loadFile(argv0, Files[I], SymbolContext,
+                                           /*MaterializeMetadata=*/false);
+      if (!M) {
+        errs() << argv0 << ": ";
+        WithColor::error() << " loading file '" << Files[I] << "'\n";
+        return false;
+      }
+      for (const GlobalValue &GV : M->global_values()) {
+        if (!GV.hasName() || GV.hasLocalLinkage() ||
+            GV.isDeclarationForLinker())
+          continue;
+        Definition D = {I, GV.isWeakForLinker(), false, false};
+        auto Inserted = Definitions.insert({GV.getName(), D});
+        if (!Inserted.second && Inserted.first->second.Weak && !D.Weak)
+          Inserted.first->second = D;
+      }
+    }
+  }
+
+  while (true) {
+    // Each symbol is looked up once, or twice if its weak definition gets
+    // replaced, so that this terminates even if the file defining it ends up
+    // not providing it.
+    SmallVector<unsigned, 8> Needed;
+    for (GlobalValue &GV : Composite.global_values()) {
+      if (!GV.isDeclaration() &&
+          !(GV.isWeakForLinker() && isa<GlobalObject>(GV)))
+        continue;
+      auto I = Definitions.find(GV.getName());
+      if (I == Definitions.end())
+        continue;
+      Definition &D = I->second;
+      if (!GV.isDeclaration()) {
+        // A weak definition linked from the first file, or from a file linked
+        // before the one with the strong definition, gives way to the strong
+        // one.
+        if (D.Weak || D.Replaced)
+          continue;
+        D.Replaced = true;
+        convertToDeclaration(GV);
+      } else if (D.Linked) {
+        continue;
+      }
+      D.Linked = true;
+      Needed.push_back(D.File);
+    }
+    if (Needed.empty())
+      return true;
+
+    llvm::sort(Needed);
+    Needed.erase(std::unique(Needed.begin(), Needed.end()), Needed.end());
+    for (unsigned I : Needed)
+      if (!linkFile(argv0, Context, L, Files[I],
+                    Flags | Linker::Flags::LinkOnlyNeeded, Internalize))
+        return false;
+  }
+}
+
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
   ExitOnErr.setBanner(std::string(argv[0]) + ": ");
@@ -366,8 +469,13 @@ int main(int argc, char **argv) {
     Flags |= Linker::Flags::LinkOnlyNeeded;
 
   // First add all the regular input files
-  if (!linkFiles(argv[0], Context, L, InputFilenames, Flags))
+  if (LazyLink) {
+    if (!linkFilesLazily(argv[0], Context, L, *Composite, InputFilenames,
+                         Flags))
+      return 1;
+  } else if (!linkFiles(argv[0], Context, L, InputFilenames, Flags)) {
     return 1;
+  }
 
   // Next the -override ones.
   if (!linkFiles(argv[0], Context, L, OverridingInputs,
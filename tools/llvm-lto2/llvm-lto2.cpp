@@ -21,9 +21,12 @@
 #include "llvm/IR/DiagnosticPrinter.h"
 #include "llvm/LTO/Caching.h"
 #include "llvm/LTO/LTO.h"
+#include "llvm/Support/CachePruning.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Compression.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/Threading.h"
 
@@ -50,6 +53,31 @@ static cl::opt<std::string> OutputFilename("o", cl::Required,
 static cl::opt<std::string> CacheDir("cache-dir", cl::desc("Cache Directory"),
                                      cl::value_desc("directory"));
 
+static cl::opt<bool> CacheIndexed(
+    "cache-indexed",
+    cl::desc("Use the indexed layout for the cache directory"));
+
+static cl::opt<std::string> CacheCompression(
+    "cache-compression",
+    cl::desc("Compress new cache entries with this codec (zlib or lz4)"),
+    cl::value_desc("codec"));
+
+static cl::opt<std::string>
+    CachePolicy("cache-policy",
+                cl::desc("Prune the cache directory with this policy after "
+                         "the link"),
+                cl::value_desc("policy"));
+
+static cl::opt<bool>
+    ThinLTOCacheStats("thinlto-cache-stats",
+                      cl::desc("Print statistics of the use of the cache"));
+
+static cl::opt<std::string> ThinLinkCache(
+    "thinlto-link-cache",
+    cl::desc("Reuse the import and export lists of unchanged modules from "
+             "the previous thin link recorded in this file"),
+    cl::value_desc("filename"));
+
 static cl::opt<std::string> OptPipeline("opt-pipeline",
                                         cl::desc("Optimizer Pipeline"),
                                         cl::value_desc("pipeline"));
@@ -69,6 +97,26 @@ static cl::opt<bool>
 static cl::opt<int> Threads("thinlto-threads",
                             cl::init(llvm::heavyweight_hardware_concurrency()));
 
+static cl::opt<unsigned>
+    Partitions("lto-partitions",
+               cl::desc("Split regular LTO code generation into this many "
+                        "partitions"),
+               cl::init(1));
+
+static cl::opt<bool> BalancePartitions(
+    "lto-balance-partitions",
+    cl::desc("Balance the regular LTO partitions by instruction count"));
+
+static cl::opt<bool> SplitFunctionPasses(
+    "lto-split-function-passes",
+    cl::desc("Run the function passes of regular LTO on each partition"));
+
+static cl::opt<unsigned> MemoryBudgetMB(
+    "thinlto-memory-budget",
+    cl::desc("Limit the estimated memory use of concurrent ThinLTO backends "
+             "to this many megabytes (0 for no limit)"),
+    cl::init(0));
+
 static cl::list<std::string> SymbolResolutions(
     "r",
     cl::desc("Specify a symbol resolution: filename,symbolname,resolution\n"
@@ -246,6 +294,9 @@ static int run(int argc, char **argv) {
   Conf.OverrideTriple = OverrideTriple;
   Conf.DefaultTriple = DefaultTriple;
   Conf.StatsFile = StatsFile;
+  Conf.ThinLinkCacheFile = ThinLinkCache;
+  Conf.BalancePartitions = BalancePartitions;
+  Conf.SplitFunctionPasses = SplitFunctionPasses;
 
   ThinBackend Backend;
   if (ThinLTODistributedIndexes)
@@ -255,14 +306,38 @@ static int run(int argc, char **argv) {
                                             /* LinkedObjectsFile */ nullptr,
                                             /* OnWrite */ {});
   else
-    Backend = createInProcessThinBackend(Threads);
-  LTO Lto(std::move(Conf), std::move(Backend));
+    Backend = createInProcessThinBackend(Threads,
+                                         uint64_t(MemoryBudgetMB) << 20);
+  LTO Lto(std::move(Conf), std::move(Backend), Partitions);
+
+  // Read the input files and their symbol tables in parallel. They are added
+  // to the link in the order of the command line below.
+  struct LoadedInput {
+    std::error_code EC;
+    std::unique_ptr<MemoryBuffer> MB;
+    Optional<Expected<std::unique_ptr<InputFile>>> InputOrErr;
+  };
+  std::vector<LoadedInput> Loaded(InputFilenames.size());
+  parallel::for_each_n(
+      parallel::par, size_t(0), InputFilenames.size(), [&](size_t I) {
+        ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+            MemoryBuffer::getFile(InputFilenames[I]);
+        if (!MBOrErr) {
+          Loaded[I].EC = MBOrErr.getError();
+          return;
+        }
+        Loaded[I].MB = std::move(*MBOrErr);
+        Loaded[I].InputOrErr.emplace(
+            InputFile::create(Loaded[I].MB->getMemBufferRef()));
+      });
 
   bool HasErrors = false;
-  for (std::string F : InputFilenames) {
-    std::unique_ptr<MemoryBuffer> MB = check(MemoryBuffer::getFile(F), F);
+  for (unsigned FI = 0; FI != InputFilenames.size(); ++FI) {
+    const std::string &F = InputFilenames[FI];
+    check(Loaded[FI].EC, F);
+    std::unique_ptr<MemoryBuffer> MB = std::move(Loaded[FI].MB);
     std::unique_ptr<InputFile> Input =
-        check(InputFile::create(MB->getMemBufferRef()), F);
+        check(std::move(*Loaded[FI].InputOrErr), F);
 
     std::vector<SymbolResolution> Res;
     for (const InputFile::Symbol &Sym : Input->symbols()) {
@@ -311,10 +386,30 @@ static int run(int argc, char **argv) {
   };
 
   NativeObjectCache Cache;
-  if (!CacheDir.empty())
-    Cache = check(localCache(CacheDir, AddBuffer), "failed to create cache");
+  CacheStats Stats;
+  if (!CacheDir.empty()) {
+    const compression::Codec *Compressor = nullptr;
+    if (!CacheCompression.empty() && CacheCompression != "none") {
+      Compressor = compression::getCodec(CacheCompression);
+      if (!Compressor) {
+        llvm::errs() << "invalid cache compression: " << CacheCompression
+                     << '\n';
+        return 1;
+      }
+    }
+    Cache = check(
+        localCache(CacheDir, AddBuffer, &Stats, CacheIndexed, Compressor),
+        "failed to create cache");
+  }
 
   check(Lto.run(AddStream, Cache), "LTO::run failed");
+
+  if (!CacheDir.empty() && !CachePolicy.empty())
+    pruneCache(CacheDir, check(parseCachePruningPolicy(CachePolicy),
+                               "invalid cache policy"),
+               &Stats);
+  if (ThinLTOCacheStats)
+    Stats.print(errs());
   return 0;
 }
 
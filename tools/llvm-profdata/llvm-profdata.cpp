@@ -31,6 +31,7 @@
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
+#include <queue>
 
 using namespace llvm;
 
@@ -316,31 +317,41 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   } else {
     ThreadPool Pool(NumThreads);
 
-    // Load the inputs in parallel (N/NumThreads serial steps).
+    // Load the inputs in parallel (N/NumThreads serial steps). Pending holds
+    // the tasks which have to finish before a context can be merged.
+    std::vector<std::vector<std::shared_future<void>>> Pending(NumThreads);
     unsigned Ctx = 0;
     for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Remapper, Contexts[Ctx].get());
+      Pending[Ctx].push_back(
+          Pool.async(loadInput, Input, Remapper, Contexts[Ctx].get()));
       Ctx = (Ctx + 1) % NumThreads;
     }
-    Pool.wait();
 
     // Merge the writer contexts together (~ lg(NumThreads) serial steps).
+    // Each merge starts as soon as its two contexts are complete rather than
+    // after all tasks of the previous step.
+    auto Merge = [&](unsigned Dst, unsigned Src) {
+      ThreadPool::TaskOptions Opts;
+      Opts.DependsOn = std::move(Pending[Dst]);
+      Opts.DependsOn.insert(Opts.DependsOn.end(), Pending[Src].begin(),
+                            Pending[Src].end());
+      Pending[Src].clear();
+      Pending[Dst] = {Pool.asyncWithOptions(
+          std::move(Opts), std::bind(mergeWriterContexts, Contexts[Dst].get(),
+                                     Contexts[Src].get()))};
+    };
     unsigned Mid = Contexts.size() / 2;
     unsigned End = Contexts.size();
     assert(Mid > 0 && "Expected more than one context");
     do {
       for (unsigned I = 0; I < Mid; ++I)
-        Pool.async(mergeWriterContexts, Contexts[I].get(),
-                   Contexts[I + Mid].get());
-      Pool.wait();
-      if (End & 1) {
-        Pool.async(mergeWriterContexts, Contexts[0].get(),
-                   Contexts[End - 1].get());
-        Pool.wait();
-      }
+        Merge(I, I + Mid);
+      if (End & 1)
+        Merge(0, End - 1);
       End = Mid;
       Mid /= 2;
     } while (Mid > 0);
+    Pool.wait();
   }
 
   // Handle deferred hard errors encountered during merging.
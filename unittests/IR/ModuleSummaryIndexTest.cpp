@@ -0,0 +1,93 @@
+//===- ModuleSummaryIndexTest.cpp - ModuleSummaryIndex unit tests ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/IR/ModuleSummaryIndex.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+GlobalValueSummary::GVFlags makeFlags() {
+  return GlobalValueSummary::GVFlags(GlobalValue::ExternalLinkage,
+                                     /*NotEligibleToImport=*/false,
+                                     /*Live=*/true, /*IsLocal=*/false);
+}
+
+void addFunction(ModuleSummaryIndex &Index, ValueInfo VI, StringRef ModulePath,
+                 std::vector<ValueInfo> Refs,
+                 std::vector<FunctionSummary::EdgeTy> Calls) {
+  auto FS = llvm::make_unique<FunctionSummary>(
+      makeFlags(), 1, FunctionSummary::FFlags{}, std::move(Refs),
+      std::move(Calls), std::vector<GlobalValue::GUID>(),
+      std::vector<FunctionSummary::VFuncId>(),
+      std::vector<FunctionSummary::VFuncId>(),
+      std::vector<FunctionSummary::ConstVCall>(),
+      std::vector<FunctionSummary::ConstVCall>());
+  FS->setModulePath(Index.getModule(ModulePath)->first());
+  Index.addGlobalValueSummary(VI, std::move(FS));
+}
+
+TEST(ModuleSummaryIndexTest, MergeFrom) {
+  GlobalValue::GUID F = GlobalValue::getGUID("f");
+  GlobalValue::GUID G = GlobalValue::getGUID("g");
+  GlobalValue::GUID V = GlobalValue::getGUID("v");
+
+  // a.bc defines f, which calls g.
+  ModuleSummaryIndex Index(/*HaveGVs=*/false);
+  Index.addModule("a.bc", 0);
+  ValueInfo GInA = Index.getOrInsertValueInfo(G);
+  addFunction(Index, Index.getOrInsertValueInfo(F, "f"), "a.bc", {},
+              {{GInA, CalleeInfo()}});
+
+  // b.bc defines g, which calls f and reads v. The name of g is owned by the
+  // index, the one of v lives outside of it like a bitcode string table.
+  auto Other = llvm::make_unique<ModuleSummaryIndex>(/*HaveGVs=*/false);
+  Other->addModule("b.bc", 1);
+  ValueInfo VInB = Other->getOrInsertValueInfo(V, "v");
+  VInB.setReadOnly();
+  auto VS = llvm::make_unique<GlobalVarSummary>(
+      makeFlags(), GlobalVarSummary::GVarFlags(true), std::vector<ValueInfo>());
+  VS->setModulePath(Other->getModule("b.bc")->first());
+  Other->addGlobalValueSummary(VInB, std::move(VS));
+  addFunction(*Other, Other->getOrInsertValueInfo(G, Other->saveString("g")),
+              "b.bc", {VInB},
+              {{Other->getOrInsertValueInfo(F), CalleeInfo()}});
+
+  Index.mergeFrom(std::move(*Other));
+  Other.reset();
+
+  ASSERT_EQ(2u, Index.modulePaths().size());
+  EXPECT_EQ(1u, Index.getModuleId("b.bc"));
+
+  // The summary of g moved over, with its module path, references and call
+  // edges pointing into Index.
+  ValueInfo GVI = Index.getValueInfo(G);
+  ASSERT_TRUE(GVI);
+  EXPECT_EQ(GInA.getRef(), GVI.getRef());
+  EXPECT_EQ("g", GVI.name());
+  ASSERT_EQ(1u, GVI.getSummaryList().size());
+  auto *GS = cast<FunctionSummary>(GVI.getSummaryList()[0].get());
+  EXPECT_EQ(Index.getModule("b.bc")->first().data(), GS->modulePath().data());
+
+  ASSERT_EQ(1u, GS->refs().size());
+  EXPECT_EQ(Index.getValueInfo(V).getRef(), GS->refs()[0].getRef());
+  EXPECT_TRUE(GS->refs()[0].isReadOnly());
+  EXPECT_EQ("v", GS->refs()[0].name());
+  ASSERT_EQ(1u, GS->refs()[0].getSummaryList().size());
+
+  ASSERT_EQ(1u, GS->calls().size());
+  ValueInfo Callee = GS->calls()[0].first;
+  EXPECT_EQ(Index.getValueInfo(F).getRef(), Callee.getRef());
+  EXPECT_EQ("f", Callee.name());
+  ASSERT_EQ(1u, Callee.getSummaryList().size());
+  EXPECT_EQ("a.bc", Callee.getSummaryList()[0]->modulePath());
+}
+
+} // end anonymous namespace
@@ -8,7 +8,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/CachePruning.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/LockFileManager.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
 
 using namespace llvm;
@@ -95,3 +100,140 @@ TEST(CachePruningPolicyParser, Errors) {
   EXPECT_EQ("Unknown key: 'foo'",
             toString(parseCachePruningPolicy("foo=bar").takeError()));
 }
+
+TEST(CachePruning, IndexedEviction) {
+  SmallString<128> Dir;
+  ASSERT_FALSE(sys::fs::createUniqueDirectory("cache-pruning-test", Dir));
+
+  // All entries were last used at the same time, so the largest one goes
+  // first.
+  std::pair<const char *, uint64_t> Keys[] = {
+      {"aa01", 1}, {"bb02", 3}, {"cc03", 2}};
+  SmallString<128> JournalPath(Dir);
+  sys::path::append(JournalPath, "llvmcache.journal");
+  std::time_t Now = sys::toTimeT(std::chrono::system_clock::now());
+  for (const auto &Key : Keys) {
+    std::string EntryPath = getIndexedCacheEntryPath(Dir, Key.first);
+    ASSERT_FALSE(sys::fs::create_directories(sys::path::parent_path(EntryPath)));
+    std::error_code EC;
+    raw_fd_ostream OS(EntryPath, EC, sys::fs::F_None);
+    ASSERT_FALSE(EC);
+    OS << std::string(Key.second, 'x');
+    raw_fd_ostream Journal(JournalPath, EC, sys::fs::F_Append);
+    ASSERT_FALSE(EC);
+    Journal << Key.first << ' ' << Key.second << ' ' << Now << '\n';
+  }
+
+  auto P = parseCachePruningPolicy("cache_size_files=2");
+  ASSERT_TRUE(bool(P));
+  CacheStats Stats;
+  EXPECT_TRUE(pruneCache(Dir, *P, &Stats));
+  EXPECT_EQ(1u, Stats.Evictions);
+  EXPECT_EQ(3u, Stats.BytesEvicted);
+  EXPECT_TRUE(sys::fs::exists(getIndexedCacheEntryPath(Dir, "aa01")));
+  EXPECT_FALSE(sys::fs::exists(getIndexedCacheEntryPath(Dir, "bb02")));
+  EXPECT_TRUE(sys::fs::exists(getIndexedCacheEntryPath(Dir, "cc03")));
+
+  // The journal was folded into the index.
+  SmallString<128> IndexPath(Dir);
+  sys::path::append(IndexPath, "llvmcache.index");
+  EXPECT_TRUE(sys::fs::exists(IndexPath));
+  EXPECT_FALSE(sys::fs::exists(JournalPath));
+
+  ASSERT_FALSE(sys::fs::remove_directories(Dir));
+}
+
+static void writeIndexedCacheEntry(StringRef Dir, StringRef Key, uint64_t Size) {
+  std::string EntryPath = getIndexedCacheEntryPath(Dir, Key);
+  ASSERT_FALSE(sys::fs::create_directories(sys::path::parent_path(EntryPath)));
+  std::error_code EC;
+  raw_fd_ostream OS(EntryPath, EC, sys::fs::F_None);
+  ASSERT_FALSE(EC);
+  OS << std::string(Size, 'x');
+}
+
+TEST(CachePruning, IndexedLateJournalRecord) {
+  SmallString<128> Dir;
+  ASSERT_FALSE(sys::fs::createUniqueDirectory("cache-pruning-test", Dir));
+
+  writeIndexedCacheEntry(Dir, "aa01", 1);
+  recordIndexedCacheEntry(Dir, "aa01", 1);
+  auto P = parseCachePruningPolicy("prune_interval=0s:cache_size_files=10");
+  ASSERT_TRUE(bool(P));
+  EXPECT_TRUE(pruneCache(Dir, *P));
+
+  // A process which opened the journal before the prune took it over appends
+  // its record to the journal taken over.
+  std::string TakenPath;
+  std::error_code EC;
+  for (sys::fs::directory_iterator File(Dir, EC), FileEnd;
+       File != FileEnd && !EC; File.increment(EC))
+    if (sys::path::filename(File->path()).startswith("llvmcache.journal-"))
+      TakenPath = File->path();
+  ASSERT_FALSE(TakenPath.empty());
+  writeIndexedCacheEntry(Dir, "bb02", 2);
+  {
+    raw_fd_ostream OS(TakenPath, EC, sys::fs::F_Append);
+    ASSERT_FALSE(EC);
+    OS << "bb02 2 " << sys::toTimeT(std::chrono::system_clock::now()) << '\n';
+  }
+
+  // The next prune still knows about the entry.
+  P = parseCachePruningPolicy("prune_interval=0s:cache_size_files=1");
+  ASSERT_TRUE(bool(P));
+  CacheStats Stats;
+  EXPECT_TRUE(pruneCache(Dir, *P, &Stats));
+  EXPECT_EQ(1u, Stats.Evictions);
+  EXPECT_TRUE(sys::fs::exists(getIndexedCacheEntryPath(Dir, "aa01")) !=
+              sys::fs::exists(getIndexedCacheEntryPath(Dir, "bb02")));
+
+  ASSERT_FALSE(sys::fs::remove_directories(Dir));
+}
+
+TEST(CachePruning, IndexedSweep) {
+  SmallString<128> Dir;
+  ASSERT_FALSE(sys::fs::createUniqueDirectory("cache-pruning-test", Dir));
+
+  // aa01 and bb02 are missing from the journal, and dd04 has no file.
+  writeIndexedCacheEntry(Dir, "aa01", 1);
+  writeIndexedCacheEntry(Dir, "bb02", 3);
+  writeIndexedCacheEntry(Dir, "cc03", 2);
+  recordIndexedCacheEntry(Dir, "cc03", 2);
+  recordIndexedCacheEntry(Dir, "dd04", 4);
+
+  // The first prune scans the directories.
+  auto P = parseCachePruningPolicy("cache_size_files=1");
+  ASSERT_TRUE(bool(P));
+  CacheStats Stats;
+  EXPECT_TRUE(pruneCache(Dir, *P, &Stats));
+  EXPECT_EQ(2u, Stats.Evictions);
+  unsigned NumLeft = 0;
+  for (const char *Key : {"aa01", "bb02", "cc03"})
+    NumLeft += sys::fs::exists(getIndexedCacheEntryPath(Dir, Key));
+  EXPECT_EQ(1u, NumLeft);
+
+  ASSERT_FALSE(sys::fs::remove_directories(Dir));
+}
+
+TEST(CachePruning, IndexedLocked) {
+  SmallString<128> Dir;
+  ASSERT_FALSE(sys::fs::createUniqueDirectory("cache-pruning-test", Dir));
+
+  writeIndexedCacheEntry(Dir, "aa01", 1);
+  recordIndexedCacheEntry(Dir, "aa01", 1);
+  SmallString<128> IndexPath(Dir);
+  sys::path::append(IndexPath, "llvmcache.index");
+  auto P = parseCachePruningPolicy("cache_size_files=1");
+  ASSERT_TRUE(bool(P));
+  {
+    // Another pruner holds the lock.
+    LockFileManager Lock(IndexPath);
+    ASSERT_EQ(LockFileManager::LFS_Owned, Lock.getState());
+    EXPECT_FALSE(pruneCache(Dir, *P));
+  }
+  SmallString<128> JournalPath(Dir);
+  sys::path::append(JournalPath, "llvmcache.journal");
+  EXPECT_TRUE(sys::fs::exists(JournalPath));
+
+  ASSERT_FALSE(sys::fs::remove_directories(Dir));
+}
@@ -74,4 +74,73 @@ TEST(CompressionTest, ZlibCRC32) {
 
 #endif
 
+void TestLZ4Compression(StringRef Input) {
+  SmallString<32> Compressed;
+  SmallString<32> Uncompressed;
+
+  Error E = lz4::compress(Input, Compressed);
+  EXPECT_FALSE(E);
+  consumeError(std::move(E));
+
+  E = lz4::uncompress(Compressed, Uncompressed, Input.size());
+  EXPECT_FALSE(E);
+  consumeError(std::move(E));
+
+  EXPECT_EQ(Input, Uncompressed);
+  if (Input.size() > 0) {
+    E = lz4::uncompress(Compressed, Uncompressed, Input.size() - 1);
+    EXPECT_EQ("lz4 error: output buffer too small",
+              llvm::toString(std::move(E)));
+  }
+}
+
+TEST(CompressionTest, LZ4) {
+  TestLZ4Compression("");
+  TestLZ4Compression("hello, world!");
+
+  const size_t kSize = 1024;
+  char BinaryData[kSize];
+  for (size_t i = 0; i < kSize; ++i) {
+    BinaryData[i] = i & 255;
+  }
+  TestLZ4Compression(StringRef(BinaryData, kSize));
+
+  // Long runs produce overlapping matches and extended lengths.
+  std::string Repeated(100000, 'a');
+  TestLZ4Compression(Repeated);
+  for (size_t i = 0; i < Repeated.size(); ++i)
+    Repeated[i] = "abcdefg"[i % 7] + (i % 1000 == 0);
+  TestLZ4Compression(Repeated);
+
+  SmallString<32> Compressed;
+  EXPECT_FALSE(lz4::compress(Repeated, Compressed));
+  EXPECT_LT(Compressed.size(), Repeated.size() / 10);
+}
+
+TEST(CompressionTest, LZ4Corrupt) {
+  SmallString<32> Uncompressed;
+  // A match before the start of the output.
+  Error E = lz4::uncompress(StringRef("\x10" "a\x02\x00\x00", 5), Uncompressed,
+                            100);
+  EXPECT_EQ("lz4 error: invalid match offset", llvm::toString(std::move(E)));
+  // More literals than the input holds.
+  E = lz4::uncompress(StringRef("\x50" "ab", 3), Uncompressed, 100);
+  EXPECT_EQ("lz4 error: truncated input", llvm::toString(std::move(E)));
+}
+
+TEST(CompressionTest, Codecs) {
+  EXPECT_EQ(nullptr, compression::getCodec("none"));
+  const compression::Codec *LZ4 = compression::getCodec("lz4");
+  ASSERT_NE(nullptr, LZ4);
+  EXPECT_EQ(compression::Format::LZ4, LZ4->getFormat());
+  EXPECT_TRUE(LZ4->isAvailable());
+
+  StringRef Input = "hello, hello, hello, world!";
+  SmallString<32> Compressed;
+  SmallString<32> Uncompressed;
+  EXPECT_FALSE(LZ4->compress(Input, Compressed));
+  EXPECT_FALSE(LZ4->uncompress(Compressed, Uncompressed, Input.size()));
+  EXPECT_EQ(Input, Uncompressed);
+}
+
 }
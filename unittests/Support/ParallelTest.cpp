@@ -15,6 +15,7 @@
 #include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
 #include <random>
 
 uint32_t array[1024 * 1024];
@@ -50,4 +51,22 @@ TEST(Parallel, parallel_for) {
   ASSERT_EQ(range[2049], 1u);
 }
 
+TEST(Parallel, TaskGroupExecutors) {
+  using namespace parallel::detail;
+  for (ExecutorKind Kind : {ExecutorKind::Default, ExecutorKind::WorkStealing,
+                            ExecutorKind::SharedStack}) {
+    // Tasks spawned by tasks run on the queue of the spawning worker.
+    std::atomic<unsigned> Count{0};
+    {
+      TaskGroup TG(Kind);
+      for (unsigned I = 0; I != 64; ++I)
+        TG.spawn([&] {
+          for (unsigned J = 0; J != 64; ++J)
+            TG.spawn([&] { ++Count; });
+        });
+    }
+    ASSERT_EQ(Count, 64u * 64u);
+  }
+}
+
 #endif
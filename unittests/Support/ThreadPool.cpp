@@ -164,3 +164,63 @@ TEST_F(ThreadPoolTest, PoolDestruction) {
   }
   ASSERT_EQ(5, checked_in);
 }
+
+TEST_F(ThreadPoolTest, Priority) {
+  CHECK_UNSUPPORTED();
+  // Test that ready tasks start in priority order, and in FIFO order for
+  // equal priorities.
+  ThreadPool Pool{1};
+  std::vector<int> Order;
+  Pool.async([this] { waitForMainThread(); });
+  for (int Priority : {1, 3, 2, 3}) {
+    ThreadPool::TaskOptions Opts;
+    Opts.Priority = Priority;
+    Pool.asyncWithOptions(std::move(Opts), [&Order, Priority] {
+      Order.push_back(Priority);
+    });
+  }
+  setMainThreadReady();
+  Pool.wait();
+  ASSERT_EQ(std::vector<int>({3, 3, 2, 1}), Order);
+}
+
+TEST_F(ThreadPoolTest, Dependencies) {
+  CHECK_UNSUPPORTED();
+  // Test that a task doesn't start before its dependencies have finished.
+  ThreadPool Pool{2};
+  std::atomic_int i{0};
+  auto First = Pool.async([this, &i] {
+    waitForMainThread();
+    ++i;
+  });
+  auto Second = Pool.async([&i] { ++i; });
+  ThreadPool::TaskOptions Opts;
+  Opts.DependsOn = {First, Second};
+  std::atomic_int Seen{-1};
+  Pool.asyncWithOptions(std::move(Opts), [&] { Seen = i.load(); });
+  ASSERT_EQ(-1, Seen.load());
+  setMainThreadReady();
+  Pool.wait();
+  ASSERT_EQ(2, Seen.load());
+}
+
+TEST_F(ThreadPoolTest, GroupWait) {
+  CHECK_UNSUPPORTED();
+  // Test that waiting for a group doesn't wait for the other tasks.
+  ThreadPool Pool{2};
+  std::atomic_int Blocked{0}, Grouped{0};
+  ThreadPoolTaskGroup Group1(Pool);
+  ThreadPoolTaskGroup Group2(Pool);
+  Group1.async([this, &Blocked] {
+    waitForMainThread();
+    ++Blocked;
+  });
+  for (size_t i = 0; i < 5; ++i)
+    Group2.async([&Grouped] { ++Grouped; });
+  Group2.wait();
+  ASSERT_EQ(5, Grouped.load());
+  ASSERT_EQ(0, Blocked.load());
+  setMainThreadReady();
+  Group1.wait();
+  ASSERT_EQ(1, Blocked.load());
+}